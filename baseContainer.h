@@ -1,11 +1,16 @@
 #ifndef BASE_CONTAINER_H
 #define BASE_CONTAINER_H
 
+#include "staticContainer.h"
 #include <cstddef>
 #include <initializer_list>
 #include <stdexcept>
 #include <iostream>
+#include <utility>
 
+// Интерфейс контейнера с виртуальными функциями для кода, которому тип
+// контейнера известен только во время выполнения. Сами контейнеры от него
+// не наследуются (см. StaticContainer) — их оборачивает ContainerAdaptor.
 template<typename T>
 class BaseContainer {
 public:
@@ -13,39 +18,73 @@ public:
     using size_type = std::size_t;
     using reference = T&;
     using const_reference = const T&;
-    
+
     virtual ~BaseContainer() = default;
-    
+
     // Базовый интерфейс
     virtual size_type size() const noexcept = 0;
     virtual bool empty() const noexcept = 0;
     virtual void clear() = 0;
-    
+
     // Виртуальные методы
     virtual void push_back(const T& value) = 0;
     virtual void push_back(T&& value) = 0;
     virtual void insert(size_type pos, const T& value) = 0;
     virtual void insert(size_type pos, T&& value) = 0;
     virtual void erase(size_type pos) = 0;
-    
+
     virtual reference operator[](size_type idx) = 0;
     virtual const_reference operator[](size_type idx) const = 0;
-    
+
     // Для вывода содержимого
     virtual void print(std::ostream& os = std::cout) const = 0;
-    
-protected:
-    void check_index(size_type idx, size_type size, const char* msg = "Index out of range") const {
-        if (idx >= size) {
-            throw std::out_of_range(msg);
-        }
-    }
-    
-    void check_position(size_type pos, size_type size, const char* msg = "Position out of range") const {
-        if (pos > size) {
-            throw std::out_of_range(msg);
-        }
-    }
 };
 
-#endif
\ No newline at end of file
+// Любой контейнер с интерфейсом is_sequence_container за BaseContainer:
+//
+//     std::unique_ptr<BaseContainer<int>> c =
+//         std::make_unique<ContainerAdaptor<SimpleVector<int>>>();
+template<typename Container>
+class ContainerAdaptor final : public BaseContainer<typename Container::value_type> {
+    static_assert(is_sequence_container_v<Container>,
+                  "ContainerAdaptor needs a sequence container");
+
+    using Base = BaseContainer<typename Container::value_type>;
+
+public:
+    using typename Base::value_type;
+    using typename Base::size_type;
+    using typename Base::reference;
+    using typename Base::const_reference;
+    using container_type = Container;
+
+    ContainerAdaptor() = default;
+
+    explicit ContainerAdaptor(const Container& container) : container_(container) {}
+    explicit ContainerAdaptor(Container&& container) : container_(std::move(container)) {}
+
+    ContainerAdaptor(std::initializer_list<value_type> init) : container_(init) {}
+
+    Container& container() noexcept { return container_; }
+    const Container& container() const noexcept { return container_; }
+
+    size_type size() const noexcept override { return container_.size(); }
+    bool empty() const noexcept override { return container_.empty(); }
+    void clear() override { container_.clear(); }
+
+    void push_back(const value_type& value) override { container_.push_back(value); }
+    void push_back(value_type&& value) override { container_.push_back(std::move(value)); }
+    void insert(size_type pos, const value_type& value) override { container_.insert(pos, value); }
+    void insert(size_type pos, value_type&& value) override { container_.insert(pos, std::move(value)); }
+    void erase(size_type pos) override { container_.erase(pos); }
+
+    reference operator[](size_type idx) override { return container_[idx]; }
+    const_reference operator[](size_type idx) const override { return container_[idx]; }
+
+    void print(std::ostream& os = std::cout) const override { container_.print(os); }
+
+private:
+    Container container_;
+};
+
+#endif
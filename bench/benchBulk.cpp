@@ -0,0 +1,82 @@
+// Групповые операции SimpleVector против последовательности одиночных вызовов
+
+#include "benchmark.h"
+#include "benchTypes.h"
+
+#include "simpleVector.h"
+
+#include <string>
+
+namespace {
+
+using bench::State;
+
+// Доля элементов, которые вставляются/удаляются за одну операцию
+constexpr std::size_t kFraction = 10;
+
+template<typename T>
+SimpleVector<T> makeVector(std::size_t n) {
+    SimpleVector<T> v;
+    v.reserve(n + n / kFraction);
+    for (std::size_t i = 0; i < n; ++i) v.push_back(bench::makeValue<T>(i));
+    return v;
+}
+
+template<typename T, bool Bulk>
+void benchEraseRange(State& state) {
+    const std::size_t n = state.range();
+    const std::size_t k = n / kFraction;
+    const std::size_t pos = n / 4;
+    for (auto _ : state) {
+        state.pauseTiming();
+        SimpleVector<T> v = makeVector<T>(n);
+        state.resumeTiming();
+        if constexpr (Bulk) {
+            v.erase(pos, pos + k);
+        } else {
+            for (std::size_t i = 0; i < k; ++i) v.erase(pos);
+        }
+        bench::doNotOptimize(v);
+    }
+    state.setItemsProcessed(state.iterations() * k);
+}
+
+template<typename T, bool Bulk>
+void benchInsertRange(State& state) {
+    const std::size_t n = state.range();
+    const std::size_t k = n / kFraction;
+    const std::size_t pos = n / 4;
+    auto values = bench::makeValues<T>(k);
+    for (auto _ : state) {
+        state.pauseTiming();
+        SimpleVector<T> v = makeVector<T>(n);
+        state.resumeTiming();
+        if constexpr (Bulk) {
+            v.insert(pos, values.begin(), values.end());
+        } else {
+            for (std::size_t i = 0; i < k; ++i) v.insert(pos + i, values[i]);
+        }
+        bench::doNotOptimize(v);
+    }
+    state.setItemsProcessed(state.iterations() * k);
+}
+
+template<typename T>
+void registerForType() {
+    const std::string type = std::string("<") + bench::TypeName<T>::get() + ">";
+    // Поэлементный вариант квадратичен, поэтому ограничен 1e5
+    const std::size_t quadratic_limit = 100000;
+    bench::registerBenchmark("Bulk/erase_range/loop" + type, benchEraseRange<T, false>, quadratic_limit);
+    bench::registerBenchmark("Bulk/erase_range/bulk" + type, benchEraseRange<T, true>);
+    bench::registerBenchmark("Bulk/insert_range/loop" + type, benchInsertRange<T, false>, quadratic_limit);
+    bench::registerBenchmark("Bulk/insert_range/bulk" + type, benchInsertRange<T, true>);
+}
+
+void registerAll() {
+    registerForType<int>();
+    registerForType<std::string>();
+}
+
+BENCH_REGISTRATION(registerAll);
+
+} // namespace
@@ -0,0 +1,79 @@
+// Цена проверки номера: operator[] с AlwaysCheck и NeverCheck, at() и проход по data()
+
+#include "benchmark.h"
+#include "benchTypes.h"
+
+#include "simpleVector.h"
+
+#include <string>
+
+namespace {
+
+using bench::State;
+
+template<typename T, typename CheckPolicy>
+using Vector = SimpleVector<T, DefaultGrowthPolicy, CheckPolicy>;
+
+template<typename Vec>
+Vec makeFilled(std::size_t n) {
+    using T = typename Vec::value_type;
+    Vec v;
+    v.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) v.push_back(bench::makeValue<T>(i));
+    return v;
+}
+
+template<typename Vec>
+void benchIndex(State& state) {
+    const std::size_t n = state.range();
+    const Vec v = makeFilled<Vec>(n);
+    for (auto _ : state) {
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i < v.size(); ++i) sum += bench::touch(v[i]);
+        bench::doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+template<typename Vec>
+void benchAt(State& state) {
+    const std::size_t n = state.range();
+    const Vec v = makeFilled<Vec>(n);
+    for (auto _ : state) {
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i < v.size(); ++i) sum += bench::touch(v.at(i));
+        bench::doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+template<typename Vec>
+void benchData(State& state) {
+    const std::size_t n = state.range();
+    const Vec v = makeFilled<Vec>(n);
+    for (auto _ : state) {
+        std::size_t sum = 0;
+        const auto* p = v.data();
+        for (std::size_t i = 0, size = v.size(); i < size; ++i) sum += bench::touch(p[i]);
+        bench::doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+template<typename T>
+void registerForType() {
+    const std::string type = std::string("<") + bench::TypeName<T>::get() + ">";
+    bench::registerBenchmark("Checking/index_always" + type, benchIndex<Vector<T, AlwaysCheck>>);
+    bench::registerBenchmark("Checking/index_never" + type, benchIndex<Vector<T, NeverCheck>>);
+    bench::registerBenchmark("Checking/at" + type, benchAt<Vector<T, NeverCheck>>);
+    bench::registerBenchmark("Checking/data" + type, benchData<Vector<T, NeverCheck>>);
+}
+
+void registerAll() {
+    registerForType<int>();
+    registerForType<bench::Pod64>();
+}
+
+BENCH_REGISTRATION(registerAll);
+
+} // namespace
@@ -0,0 +1,200 @@
+// Пропускная способность очереди многих производителей и потребителей:
+// lock-free ConcurrentQueue против SinglyLinkedList под общим мьютексом.
+// Добавление из многих потоков: ConcurrentVector против SimpleVector
+// под общим мьютексом, в том числе с читателем снимков
+
+#include "benchmark.h"
+#include "benchTypes.h"
+
+#include "concurrentQueue.h"
+#include "concurrentVector.h"
+#include "simpleVector.h"
+#include "singlyLinkedList.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using bench::State;
+
+// Базовый вариант: обычный список, каждая операция под одним мьютексом
+template<typename T>
+class MutexQueue {
+public:
+    void push_back(T value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        list_.push_back(std::move(value));
+    }
+
+    std::optional<T> try_pop_front() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (list_.empty()) return std::nullopt;
+        std::optional<T> value(std::move(list_[0]));
+        list_.erase(0);
+        return value;
+    }
+
+private:
+    std::mutex mutex_;
+    SinglyLinkedList<T> list_;
+};
+
+// Threads производителей и Threads потребителей передают range() элементов
+template<typename Queue, std::size_t Threads>
+void benchProducersConsumers(State& state) {
+    const std::size_t n = state.range();
+    const std::size_t per_producer = n / Threads;
+    const std::size_t total = per_producer * Threads;
+    for (auto _ : state) {
+        Queue queue;
+        std::atomic<std::size_t> consumed{0};
+        std::vector<std::thread> threads;
+        threads.reserve(2 * Threads);
+        for (std::size_t p = 0; p < Threads; ++p) {
+            threads.emplace_back([&queue, per_producer, p] {
+                for (std::size_t i = 0; i < per_producer; ++i) {
+                    queue.push_back(static_cast<std::int64_t>(p * per_producer + i));
+                }
+            });
+        }
+        for (std::size_t c = 0; c < Threads; ++c) {
+            threads.emplace_back([&queue, &consumed, total] {
+                std::int64_t sum = 0;
+                while (consumed.load(std::memory_order_relaxed) < total) {
+                    if (auto value = queue.try_pop_front()) {
+                        sum += *value;
+                        consumed.fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+                bench::doNotOptimize(sum);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    state.setItemsProcessed(state.iterations() * total);
+}
+
+// Базовый вариант для добавления: SimpleVector под мьютексом. Снимок — копия
+// префикса под тем же мьютексом, иначе читатель увидел бы переезд буфера
+template<typename T>
+class MutexVector {
+public:
+    void push_back(T value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        vector_.push_back(std::move(value));
+    }
+
+    // Сумма всех элементов, прочитанных под мьютексом
+    T sum() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        T sum = 0;
+        for (std::size_t i = 0; i < vector_.size(); ++i) sum += vector_[i];
+        return sum;
+    }
+
+private:
+    std::mutex mutex_;
+    SimpleVector<T> vector_;
+};
+
+// Снимок читается без блокировок, писатели продолжают добавлять
+template<typename T>
+T sumSnapshot(ConcurrentVector<T>& vector) {
+    T sum = 0;
+    vector.snapshot().for_each_segment([&sum](const T* data, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) sum += data[i];
+    });
+    return sum;
+}
+
+template<typename T>
+T sumSnapshot(MutexVector<T>& vector) {
+    return vector.sum();
+}
+
+// Threads писателей добавляют range() элементов; при WithReader ещё один поток,
+// пока писатели работают, снимает снимки и суммирует их
+template<typename Vector, std::size_t Threads, bool WithReader>
+void benchAppend(State& state) {
+    const std::size_t n = state.range();
+    const std::size_t per_writer = n / Threads;
+    const std::size_t total = per_writer * Threads;
+    std::size_t snapshots = 0;
+    for (auto _ : state) {
+        Vector vector;
+        std::atomic<std::size_t> writers_left{Threads};
+        std::vector<std::thread> threads;
+        threads.reserve(Threads + 1);
+        for (std::size_t w = 0; w < Threads; ++w) {
+            threads.emplace_back([&vector, &writers_left, per_writer, w] {
+                for (std::size_t i = 0; i < per_writer; ++i) {
+                    vector.push_back(static_cast<std::int64_t>(w * per_writer + i));
+                }
+                writers_left.fetch_sub(1, std::memory_order_release);
+            });
+        }
+        if (WithReader) {
+            threads.emplace_back([&vector, &writers_left, &snapshots] {
+                std::int64_t sum = 0;
+                while (writers_left.load(std::memory_order_acquire) != 0) {
+                    sum += sumSnapshot(vector);
+                    ++snapshots;
+                }
+                bench::doNotOptimize(sum);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        bench::doNotOptimize(vector);
+    }
+    bench::doNotOptimize(snapshots);
+    state.setItemsProcessed(state.iterations() * total);
+}
+
+template<std::size_t Threads>
+void registerAppendForThreads() {
+    const std::vector<std::size_t> sizes = {100000, 1000000};
+    const std::string suffix = "/threads:" + std::to_string(Threads);
+    bench::registerBenchmarkArgs("Concurrent/append/ConcurrentVector" + suffix,
+                                 benchAppend<ConcurrentVector<std::int64_t>, Threads, false>, sizes);
+    bench::registerBenchmarkArgs("Concurrent/append/MutexSimpleVector" + suffix,
+                                 benchAppend<MutexVector<std::int64_t>, Threads, false>, sizes);
+    bench::registerBenchmarkArgs("Concurrent/append_snapshot/ConcurrentVector" + suffix,
+                                 benchAppend<ConcurrentVector<std::int64_t>, Threads, true>, sizes);
+    bench::registerBenchmarkArgs("Concurrent/append_snapshot/MutexSimpleVector" + suffix,
+                                 benchAppend<MutexVector<std::int64_t>, Threads, true>, sizes);
+}
+
+template<std::size_t Threads>
+void registerForThreads() {
+    const std::vector<std::size_t> sizes = {100000, 1000000};
+    const std::string suffix = "/threads:" + std::to_string(Threads) + "x" + std::to_string(Threads);
+    bench::registerBenchmarkArgs("Concurrent/mpmc/ConcurrentQueue" + suffix,
+                                 benchProducersConsumers<ConcurrentQueue<std::int64_t>, Threads>, sizes);
+    bench::registerBenchmarkArgs("Concurrent/mpmc/MutexSinglyLinkedList" + suffix,
+                                 benchProducersConsumers<MutexQueue<std::int64_t>, Threads>, sizes);
+}
+
+void registerAll() {
+    registerForThreads<1>();
+    registerForThreads<2>();
+    registerForThreads<4>();
+    registerAppendForThreads<1>();
+    registerAppendForThreads<2>();
+    registerAppendForThreads<4>();
+}
+
+BENCH_REGISTRATION(registerAll);
+
+} // namespace
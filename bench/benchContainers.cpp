@@ -0,0 +1,213 @@
+// Базовый набор бенчмарков для SimpleVector, SinglyLinkedList, DoublyLinkedList и UnrolledList
+
+#include "benchmark.h"
+#include "benchTypes.h"
+
+#include "simpleVector.h"
+#include "singlyLinkedList.h"
+#include "doublyLinkedList.h"
+#include "unrolledList.h"
+
+#include <limits>
+#include <string>
+#include <utility>
+
+namespace {
+
+using bench::State;
+
+// Сколько вставок/удалений выполняется за одну итерацию замера:
+// восстановление размера контейнера вынесено из замера, и пауза
+// таймера амортизируется на всю пачку
+constexpr std::size_t kBatch = 32;
+
+enum class Where { Front, Middle, Back };
+
+const char* whereName(Where w) {
+    switch (w) {
+        case Where::Front: return "front";
+        case Where::Middle: return "middle";
+        default: return "back";
+    }
+}
+
+std::size_t positionFor(Where w, std::size_t size) {
+    switch (w) {
+        case Where::Front: return 0;
+        case Where::Middle: return size / 2;
+        default: return size;
+    }
+}
+
+// Список с позиционным индексом, включённым с момента создания
+template<typename List>
+struct Indexed : List {
+    Indexed() { this->enable_index(); }
+};
+
+template<typename Container>
+Container makeFilled(std::size_t n) {
+    using T = typename Container::value_type;
+    Container c;
+    for (std::size_t i = 0; i < n; ++i) c.push_back(bench::makeValue<T>(i));
+    return c;
+}
+
+template<typename Container>
+void benchPushBack(State& state) {
+    using T = typename Container::value_type;
+    const std::size_t n = state.range();
+    auto values = bench::makeValues<T>(n);
+    for (auto _ : state) {
+        Container c;
+        for (std::size_t i = 0; i < n; ++i) c.push_back(values[i]);
+        bench::doNotOptimize(c);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+template<typename Container>
+void benchInsert(State& state, Where where) {
+    using T = typename Container::value_type;
+    Container c = makeFilled<Container>(state.range());
+    const T value = bench::makeValue<T>(42);
+    for (auto _ : state) {
+        for (std::size_t k = 0; k < kBatch; ++k) {
+            c.insert(positionFor(where, c.size()), value);
+        }
+        state.pauseTiming();
+        for (std::size_t k = 0; k < kBatch; ++k) {
+            std::size_t pos = positionFor(where, c.size());
+            c.erase(pos == c.size() ? pos - 1 : pos);
+        }
+        state.resumeTiming();
+    }
+    state.setItemsProcessed(state.iterations() * kBatch);
+}
+
+template<typename Container>
+void benchErase(State& state, Where where) {
+    using T = typename Container::value_type;
+    Container c = makeFilled<Container>(state.range() + kBatch);
+    const T value = bench::makeValue<T>(42);
+    for (auto _ : state) {
+        for (std::size_t k = 0; k < kBatch; ++k) {
+            std::size_t pos = positionFor(where, c.size());
+            c.erase(pos == c.size() ? pos - 1 : pos);
+        }
+        state.pauseTiming();
+        for (std::size_t k = 0; k < kBatch; ++k) {
+            c.insert(positionFor(where, c.size()), value);
+        }
+        state.resumeTiming();
+    }
+    state.setItemsProcessed(state.iterations() * kBatch);
+}
+
+template<typename Container>
+void benchIndexRandom(State& state) {
+    const std::size_t n = state.range();
+    Container c = makeFilled<Container>(n);
+    bench::Lcg rng;
+    std::size_t acc = 0;
+    for (auto _ : state) {
+        acc += bench::touch(c[rng.next(n)]);
+    }
+    bench::doNotOptimize(acc);
+    state.setItemsProcessed(state.iterations());
+}
+
+// Проход по номерам подряд: c[0], c[1], ...
+template<typename Container>
+void benchIndexSequential(State& state) {
+    const std::size_t n = state.range();
+    Container c = makeFilled<Container>(n);
+    for (auto _ : state) {
+        std::size_t acc = 0;
+        for (std::size_t i = 0; i < n; ++i) acc += bench::touch(c[i]);
+        bench::doNotOptimize(acc);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+template<typename Container>
+void benchIterate(State& state) {
+    const std::size_t n = state.range();
+    Container c = makeFilled<Container>(n);
+    for (auto _ : state) {
+        std::size_t acc = 0;
+        for (const auto& x : c) acc += bench::touch(x);
+        bench::doNotOptimize(acc);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+template<typename Container>
+void benchCopy(State& state) {
+    const std::size_t n = state.range();
+    Container c = makeFilled<Container>(n);
+    for (auto _ : state) {
+        Container copy(c);
+        bench::doNotOptimize(copy);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+template<typename Container>
+void benchMove(State& state) {
+    Container c = makeFilled<Container>(state.range());
+    for (auto _ : state) {
+        Container moved(std::move(c));
+        bench::doNotOptimize(moved);
+        c = std::move(moved);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+template<typename Container>
+void registerSuite(const std::string& container, std::size_t max_range,
+                   std::size_t sequential_max_range) {
+    using T = typename Container::value_type;
+    const std::string prefix = container + "<" + bench::TypeName<T>::get() + ">/";
+
+    bench::registerBenchmark(prefix + "push_back", benchPushBack<Container>, max_range);
+    for (Where w : {Where::Front, Where::Middle, Where::Back}) {
+        bench::registerBenchmark(prefix + "insert_" + whereName(w),
+                                 [w](State& s) { benchInsert<Container>(s, w); }, max_range);
+    }
+    for (Where w : {Where::Front, Where::Middle, Where::Back}) {
+        bench::registerBenchmark(prefix + "erase_" + whereName(w),
+                                 [w](State& s) { benchErase<Container>(s, w); }, max_range);
+    }
+    bench::registerBenchmark(prefix + "index_random", benchIndexRandom<Container>, max_range);
+    bench::registerBenchmark(prefix + "index_sequential", benchIndexSequential<Container>,
+                             sequential_max_range);
+    bench::registerBenchmark(prefix + "iterate", benchIterate<Container>, max_range);
+    bench::registerBenchmark(prefix + "copy", benchCopy<Container>, max_range);
+    bench::registerBenchmark(prefix + "move", benchMove<Container>, max_range);
+}
+
+template<typename T>
+void registerForType() {
+    const std::size_t unlimited = std::numeric_limits<std::size_t>::max();
+    // У UnrolledList нет пальца, проход по номерам квадратичен
+    const std::size_t quadratic_limit = 100000;
+    registerSuite<SimpleVector<T>>("SimpleVector", unlimited, unlimited);
+    registerSuite<SinglyLinkedList<T>>("SinglyLinkedList", unlimited, unlimited);
+    registerSuite<DoublyLinkedList<T>>("DoublyLinkedList", unlimited, unlimited);
+    registerSuite<SinglyLinkedList<T, PoolAllocator<T>>>("PooledSinglyLinkedList", unlimited, unlimited);
+    registerSuite<DoublyLinkedList<T, PoolAllocator<T>>>("PooledDoublyLinkedList", unlimited, unlimited);
+    registerSuite<UnrolledList<T>>("UnrolledList", unlimited, quadratic_limit);
+    registerSuite<Indexed<SinglyLinkedList<T>>>("IndexedSinglyLinkedList", unlimited, unlimited);
+    registerSuite<Indexed<DoublyLinkedList<T>>>("IndexedDoublyLinkedList", unlimited, unlimited);
+}
+
+void registerAll() {
+    registerForType<int>();
+    registerForType<bench::Pod64>();
+    registerForType<std::string>();
+}
+
+BENCH_REGISTRATION(registerAll);
+
+} // namespace
@@ -0,0 +1,81 @@
+// Скорость разрушения и очистки длинных списков (до 1e7 узлов)
+
+#include "benchmark.h"
+#include "benchTypes.h"
+
+#include "singlyLinkedList.h"
+#include "doublyLinkedList.h"
+#include "unrolledList.h"
+
+#include <optional>
+#include <string>
+
+namespace {
+
+using bench::State;
+
+template<typename Container>
+void fill(Container& c, std::size_t n) {
+    using T = typename Container::value_type;
+    const T value = bench::makeValue<T>(1);
+    for (std::size_t i = 0; i < n; ++i) c.push_back(value);
+}
+
+// Деструктор: список строится вне замера, замеряется только выход из области видимости
+template<typename Container>
+void benchDestroy(State& state) {
+    const std::size_t n = state.range();
+    for (auto _ : state) {
+        state.pauseTiming();
+        std::optional<Container> c;
+        c.emplace();
+        fill(*c, n);
+        state.resumeTiming();
+        c.reset();
+        bench::clobberMemory();
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+template<typename Container>
+void benchClear(State& state) {
+    const std::size_t n = state.range();
+    Container c;
+    for (auto _ : state) {
+        state.pauseTiming();
+        fill(c, n);
+        state.resumeTiming();
+        c.clear();
+        bench::clobberMemory();
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+template<typename Container>
+void registerContainer(const std::string& name, const std::vector<std::size_t>& sizes) {
+    using T = typename Container::value_type;
+    const std::string suffix = "<" + std::string(bench::TypeName<T>::get()) + ">";
+    bench::registerBenchmarkArgs("Destroy/" + name + suffix, benchDestroy<Container>, sizes);
+    bench::registerBenchmarkArgs("Clear/" + name + suffix, benchClear<Container>, sizes);
+}
+
+template<typename T>
+void registerForType(const std::vector<std::size_t>& sizes) {
+    registerContainer<SinglyLinkedList<T>>("SinglyLinkedList", sizes);
+    registerContainer<DoublyLinkedList<T>>("DoublyLinkedList", sizes);
+    registerContainer<SinglyLinkedList<T, PoolAllocator<T>>>("PooledSinglyLinkedList", sizes);
+    registerContainer<DoublyLinkedList<T, PoolAllocator<T>>>("PooledDoublyLinkedList", sizes);
+    registerContainer<UnrolledList<T>>("UnrolledList", sizes);
+}
+
+void registerAll() {
+    // Размеры заданы явно: разрушение интересно именно на 1e7 узлов,
+    // больше, чем --max-size по умолчанию
+    registerForType<int>({100000, 1000000, 10000000});
+    // Строки на 1e7 узлов заняли бы несколько гигабайт
+    registerForType<std::string>({100000, 1000000});
+}
+
+BENCH_REGISTRATION(registerAll);
+
+} // namespace
@@ -0,0 +1,144 @@
+// Статическая диспетчеризация против виртуальной: одни и те же обобщённые
+// алгоритмы вызываются с конкретным контейнером и через BaseContainer<T>&
+
+#include "benchmark.h"
+#include "benchTypes.h"
+
+#include "baseContainer.h"
+#include "simpleVector.h"
+#include "doublyLinkedList.h"
+#include "unrolledList.h"
+
+#include <limits>
+#include <string>
+
+namespace {
+
+using bench::State;
+
+constexpr std::size_t unlimited = std::numeric_limits<std::size_t>::max();
+
+// Сумма по номерам: для SimpleVector статический operator[] встраивается
+// и цикл векторизуется, виртуальный — вызов на каждый элемент
+template<typename C>
+std::size_t sumByIndex(const C& c) {
+    std::size_t sum = 0;
+    for (std::size_t i = 0, n = c.size(); i < n; ++i) {
+        sum += bench::touch(c[i]);
+    }
+    return sum;
+}
+
+template<typename C, typename T>
+void fill(C& c, std::size_t n, const T& value) {
+    c.clear();
+    for (std::size_t i = 0; i < n; ++i) c.push_back(value);
+}
+
+// Последовательность операций runDemo на контейнере из n элементов
+template<typename C, typename T>
+void demo(C& c, std::size_t n, const T& value) {
+    fill(c, n, value);
+    c.erase(2);
+    c.erase(4);
+    c.erase(6);
+    c.insert(0, value);
+    c.insert(c.size() / 2, value);
+    c.push_back(value);
+}
+
+// Dispatch::Static работает с контейнером напрямую, Dispatch::Virtual —
+// через BaseContainer<T>&, тип за которым компилятору неизвестен
+enum class Dispatch { Static, Virtual };
+
+template<typename Container, Dispatch D>
+struct Access {
+    using T = typename Container::value_type;
+
+    ContainerAdaptor<Container> adaptor;
+
+    auto& get() {
+        if constexpr (D == Dispatch::Static) {
+            return adaptor.container();
+        } else {
+            // Чтение через volatile не даёт девиртуализировать вызовы
+            BaseContainer<T>* volatile hidden = &adaptor;
+            return *hidden;
+        }
+    }
+};
+
+template<typename Container, Dispatch D>
+void benchSumByIndex(State& state) {
+    using T = typename Container::value_type;
+    const std::size_t n = state.range();
+    Access<Container, D> access;
+    auto& c = access.get();
+    fill(c, n, bench::makeValue<T>(1));
+    for (auto _ : state) {
+        bench::doNotOptimize(sumByIndex(c));
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+template<typename Container, Dispatch D>
+void benchFill(State& state) {
+    using T = typename Container::value_type;
+    const std::size_t n = state.range();
+    const T value = bench::makeValue<T>(1);
+    Access<Container, D> access;
+    auto& c = access.get();
+    for (auto _ : state) {
+        fill(c, n, value);
+        bench::clobberMemory();
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+template<typename Container, Dispatch D>
+void benchDemo(State& state) {
+    using T = typename Container::value_type;
+    const std::size_t n = state.range();
+    const T value = bench::makeValue<T>(1);
+    Access<Container, D> access;
+    auto& c = access.get();
+    for (auto _ : state) {
+        demo(c, n, value);
+        bench::clobberMemory();
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+template<typename Container, Dispatch D>
+void registerCase(const std::string& container, const char* dispatch, std::size_t index_max_range) {
+    using T = typename Container::value_type;
+    const std::string suffix = std::string("/") + dispatch + "/" + container + "<" +
+                               bench::TypeName<T>::get() + ">";
+    bench::registerBenchmark("Dispatch/sum_by_index" + suffix, benchSumByIndex<Container, D>,
+                             index_max_range);
+    bench::registerBenchmark("Dispatch/fill" + suffix, benchFill<Container, D>, unlimited);
+    bench::registerBenchmark("Dispatch/demo" + suffix, benchDemo<Container, D>, unlimited);
+}
+
+template<typename Container>
+void registerPair(const std::string& container, std::size_t index_max_range) {
+    registerCase<Container, Dispatch::Static>(container, "static", index_max_range);
+    registerCase<Container, Dispatch::Virtual>(container, "virtual", index_max_range);
+}
+
+// Доступ по номеру в UnrolledList — O(n / BlockSize), полный проход квадратичен
+template<typename T>
+void registerForType() {
+    registerPair<SimpleVector<T>>("SimpleVector", unlimited);
+    registerPair<DoublyLinkedList<T>>("DoublyLinkedList", unlimited);
+    registerPair<UnrolledList<T>>("UnrolledList", 10000);
+}
+
+void registerAll() {
+    registerForType<int>();
+    registerForType<std::string>();
+}
+
+BENCH_REGISTRATION(registerAll);
+
+} // namespace
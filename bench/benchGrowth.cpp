@@ -0,0 +1,51 @@
+// Рост SimpleVector без reserve при разных политиках роста
+
+#include "benchmark.h"
+#include "benchTypes.h"
+
+#include "simpleVector.h"
+
+#include <string>
+
+namespace {
+
+using bench::State;
+
+// Перенос через новый буфер и поэлементное копирование, как до realloc/mremap
+struct CopyGrowth {
+    int value;
+
+    CopyGrowth(int v) : value(v) {}
+    CopyGrowth(const CopyGrowth& other) : value(other.value) {}
+    ~CopyGrowth() {}
+};
+
+// Небольшой порог, чтобы путь mremap был виден уже на средних размерах
+struct EarlyMmapPolicy : PageGrowthPolicy {
+    static constexpr std::size_t mmap_threshold = std::size_t(1) << 20;
+};
+
+template<typename Vector>
+void benchGrow(State& state) {
+    using T = typename Vector::value_type;
+    const std::size_t n = state.range();
+    for (auto _ : state) {
+        Vector v;
+        for (std::size_t i = 0; i < n; ++i) v.push_back(T(static_cast<int>(i)));
+        bench::doNotOptimize(v);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+    state.setBytesProcessed(state.iterations() * n * sizeof(T));
+}
+
+void registerAll() {
+    bench::registerBenchmark("Growth/copy_loop", benchGrow<SimpleVector<CopyGrowth>>);
+    bench::registerBenchmark("Growth/default", benchGrow<SimpleVector<int>>);
+    bench::registerBenchmark("Growth/page", benchGrow<SimpleVector<int, PageGrowthPolicy>>);
+    bench::registerBenchmark("Growth/early_mmap", benchGrow<SimpleVector<int, EarlyMmapPolicy>>);
+    bench::registerBenchmark("Growth/huge_pages", benchGrow<SimpleVector<int, HugePageGrowthPolicy>>);
+}
+
+BENCH_REGISTRATION(registerAll);
+
+} // namespace
@@ -0,0 +1,130 @@
+// Загрузка контейнера из файла: цикл operator>> / push_back против
+// потоковых загрузчиков streamLoader.h (from_chars по блокам, чтение записей
+// прямо в буфер, узлы списка из одного slab'а). Файлы лежат в страничном
+// кэше, поэтому измеряются разбор и выделение памяти, а не диск
+
+#include "benchmark.h"
+#include "benchTypes.h"
+
+#include "doublyLinkedList.h"
+#include "nodePool.h"
+#include "simpleVector.h"
+#include "streamLoader.h"
+#include "textFormat.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+
+using bench::State;
+
+SimpleVector<int> makeData(std::size_t n) {
+    bench::Lcg rng(n + 1);
+    SimpleVector<int> v;
+    v.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) v.push_back(static_cast<int>(rng.next(1000000000)));
+    return v;
+}
+
+// Временный файл с числами текстом или записями; удаляется вместе с объектом
+class TempFile {
+public:
+    TempFile(const SimpleVector<int>& v, bool text)
+        : path_((std::filesystem::temp_directory_path() / (text ? "lab3_bench_ingest.txt" : "lab3_bench_ingest.bin"))
+                    .string()) {
+        std::ofstream os(path_, std::ios::binary);
+        if (text) {
+            ::text::print(v, os, {"\n", "\n"});
+        } else {
+            os.write(reinterpret_cast<const char*>(v.data()), static_cast<std::streamsize>(v.size() * sizeof(int)));
+        }
+    }
+    ~TempFile() { std::remove(path_.c_str()); }
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+
+    const std::string& path() const noexcept { return path_; }
+    std::uint64_t bytes() const { return std::filesystem::file_size(path_); }
+
+private:
+    std::string path_;
+};
+
+template<typename Container>
+void benchTextStream(State& state) {
+    const TempFile file(makeData(state.range()), true);
+    std::size_t count = 0;
+    for (auto _ : state) {
+        std::ifstream is(file.path());
+        Container c;
+        int x;
+        while (is >> x) c.push_back(x);
+        count = c.size();
+        bench::doNotOptimize(count);
+    }
+    state.setItemsProcessed(state.iterations() * count);
+    state.setBytesProcessed(state.iterations() * file.bytes());
+}
+
+template<typename Container>
+void benchTextLoader(State& state) {
+    const TempFile file(makeData(state.range()), true);
+    std::size_t count = 0;
+    for (auto _ : state) {
+        Container c;
+        count = static_cast<std::size_t>(ingest::load_text(c, file.path()));
+        bench::doNotOptimize(c.size());
+    }
+    state.setItemsProcessed(state.iterations() * count);
+    state.setBytesProcessed(state.iterations() * file.bytes());
+}
+
+template<typename Container>
+void benchRecordsStream(State& state) {
+    const TempFile file(makeData(state.range()), false);
+    std::size_t count = 0;
+    for (auto _ : state) {
+        std::ifstream is(file.path(), std::ios::binary);
+        Container c;
+        int x;
+        while (is.read(reinterpret_cast<char*>(&x), sizeof x)) c.push_back(x);
+        count = c.size();
+        bench::doNotOptimize(count);
+    }
+    state.setItemsProcessed(state.iterations() * count);
+    state.setBytesProcessed(state.iterations() * file.bytes());
+}
+
+template<typename Container>
+void benchRecordsLoader(State& state) {
+    const TempFile file(makeData(state.range()), false);
+    std::size_t count = 0;
+    for (auto _ : state) {
+        Container c;
+        count = static_cast<std::size_t>(ingest::load_records(c, file.path()));
+        bench::doNotOptimize(c.size());
+    }
+    state.setItemsProcessed(state.iterations() * count);
+    state.setBytesProcessed(state.iterations() * file.bytes());
+}
+
+template<typename Container>
+void registerFor(const std::string& name) {
+    bench::registerBenchmark("Ingest/text/" + name + "/istream", benchTextStream<Container>);
+    bench::registerBenchmark("Ingest/text/" + name + "/load_text", benchTextLoader<Container>);
+    bench::registerBenchmark("Ingest/records/" + name + "/istream", benchRecordsStream<Container>);
+    bench::registerBenchmark("Ingest/records/" + name + "/load_records", benchRecordsLoader<Container>);
+}
+
+void registerAll() {
+    registerFor<SimpleVector<int>>("SimpleVector<int>");
+    registerFor<DoublyLinkedList<int>>("DoublyLinkedList<int>");
+    registerFor<DoublyLinkedList<int, PoolAllocator<int>>>("PooledDoublyLinkedList<int>");
+}
+
+BENCH_REGISTRATION(registerAll);
+
+} // namespace
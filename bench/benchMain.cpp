@@ -0,0 +1,321 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace bench {
+
+std::vector<Benchmark>& registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+bool registerBenchmark(std::string name, Function fn, std::size_t max_range) {
+    registry().push_back(Benchmark{std::move(name), std::move(fn), max_range, {}});
+    return true;
+}
+
+bool registerBenchmarkArgs(std::string name, Function fn, std::vector<std::size_t> ranges) {
+    Benchmark b;
+    b.name = std::move(name);
+    b.fn = std::move(fn);
+    b.ranges = std::move(ranges);
+    registry().push_back(std::move(b));
+    return true;
+}
+
+namespace {
+
+enum class Format { Console, Json, Csv };
+
+struct Options {
+    std::size_t min_size = 100;
+    std::size_t max_size = 1000000;
+    double min_time = 0.1;
+    std::vector<std::string> filters;
+    Format format = Format::Console;
+    std::string out_path;
+    bool list_only = false;
+};
+
+void printUsage(const char* prog) {
+    std::cout
+        << "Usage: " << prog << " [options]\n"
+        << "  --min-size=N     наименьший размер контейнера (по умолчанию 1e2)\n"
+        << "  --max-size=N     наибольший размер контейнера (по умолчанию 1e6, до 1e8)\n"
+        << "  --min-time=SEC   минимальное время замера одного случая (по умолчанию 0.1)\n"
+        << "  --filter=STR     запускать только случаи, имя которых содержит STR\n"
+        << "                   (можно указать несколько раз)\n"
+        << "  --format=FMT     console | json | csv\n"
+        << "  --out=FILE       записать результат в файл вместо stdout\n"
+        << "  --list           вывести список зарегистрированных случаев\n";
+}
+
+// Принимает как 1000000, так и 1e6
+std::size_t parseSize(const char* text) {
+    return static_cast<std::size_t>(std::llround(std::strtod(text, nullptr)));
+}
+
+bool startsWith(const char* arg, const char* prefix, const char** value) {
+    std::size_t n = std::strlen(prefix);
+    if (std::strncmp(arg, prefix, n) != 0) return false;
+    *value = arg + n;
+    return true;
+}
+
+bool parseOptions(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = nullptr;
+        if (startsWith(arg, "--min-size=", &value)) {
+            opt.min_size = std::max<std::size_t>(1, parseSize(value));
+        } else if (startsWith(arg, "--max-size=", &value)) {
+            opt.max_size = parseSize(value);
+        } else if (startsWith(arg, "--min-time=", &value)) {
+            opt.min_time = std::strtod(value, nullptr);
+        } else if (startsWith(arg, "--filter=", &value)) {
+            opt.filters.emplace_back(value);
+        } else if (startsWith(arg, "--format=", &value)) {
+            if (std::strcmp(value, "json") == 0) opt.format = Format::Json;
+            else if (std::strcmp(value, "csv") == 0) opt.format = Format::Csv;
+            else if (std::strcmp(value, "console") == 0) opt.format = Format::Console;
+            else {
+                std::cerr << "Unknown format: " << value << std::endl;
+                return false;
+            }
+        } else if (startsWith(arg, "--out=", &value)) {
+            opt.out_path = value;
+        } else if (std::strcmp(arg, "--list") == 0) {
+            opt.list_only = true;
+        } else {
+            printUsage(argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool matches(const Options& opt, const std::string& name) {
+    if (opt.filters.empty()) return true;
+    for (const auto& f : opt.filters) {
+        if (name.find(f) != std::string::npos) return true;
+    }
+    return false;
+}
+
+// Размеры 1e2, 1e3, ... в пределах [min_size, max_size]
+std::vector<std::size_t> defaultRanges(const Options& opt, std::size_t max_range) {
+    std::vector<std::size_t> ranges;
+    std::size_t limit = std::min(opt.max_size, max_range);
+    for (std::size_t n = 100; n <= limit; n *= 10) {
+        if (n >= opt.min_size) ranges.push_back(n);
+        if (n > limit / 10) break;
+    }
+    return ranges;
+}
+
+Result runOne(const Benchmark& b, std::size_t range, const Options& opt) {
+    Result result;
+    result.name = b.name + "/" + std::to_string(range);
+    result.range = range;
+
+    const std::uint64_t max_iterations = 1000000000ULL;
+    std::uint64_t iterations = 1;
+    for (;;) {
+        State state(range, iterations);
+        b.fn(state);
+
+        if (state.skipped()) {
+            result.skipped = true;
+            result.label = state.label();
+            return result;
+        }
+
+        double seconds = state.realSeconds();
+        if (seconds >= opt.min_time || iterations >= max_iterations) {
+            result.iterations = iterations;
+            result.real_ns = seconds * 1e9 / static_cast<double>(iterations);
+            result.cpu_ns = state.cpuSeconds() * 1e9 / static_cast<double>(iterations);
+            if (seconds > 0.0) {
+                result.items_per_second = static_cast<double>(state.itemsProcessed()) / seconds;
+                result.bytes_per_second = static_cast<double>(state.bytesProcessed()) / seconds;
+            }
+            result.label = state.label();
+            return result;
+        }
+
+        // Оцениваем число итераций, нужное для min_time, с небольшим запасом
+        double multiplier = seconds > 0.0 ? opt.min_time * 1.4 / seconds : 10.0;
+        multiplier = std::min(multiplier, 10.0);
+        auto next = static_cast<std::uint64_t>(static_cast<double>(iterations) * multiplier);
+        iterations = std::min(max_iterations, std::max(iterations + 1, next));
+    }
+}
+
+std::string formatTime(double ns) {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(ns < 10.0 ? 2 : 0) << ns << " ns";
+    return ss.str();
+}
+
+std::string formatRate(double per_second, const char* unit) {
+    if (per_second <= 0.0) return "";
+    const char* prefixes[] = {"", "k", "M", "G", "T"};
+    int p = 0;
+    while (per_second >= 1000.0 && p < 4) {
+        per_second /= 1000.0;
+        ++p;
+    }
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(2) << per_second << prefixes[p] << unit;
+    return ss.str();
+}
+
+void reportConsoleHeader(std::ostream& os) {
+    os << std::left << std::setw(60) << "Benchmark"
+       << std::right << std::setw(16) << "Time"
+       << std::setw(16) << "CPU"
+       << std::setw(14) << "Iterations"
+       << "  Rate\n"
+       << std::string(120, '-') << "\n";
+}
+
+void reportConsole(std::ostream& os, const Result& r) {
+    os << std::left << std::setw(60) << r.name;
+    if (r.skipped) {
+        os << " SKIPPED: " << r.label << "\n";
+        return;
+    }
+    os << std::right << std::setw(16) << formatTime(r.real_ns)
+       << std::setw(16) << formatTime(r.cpu_ns)
+       << std::setw(14) << r.iterations << "  "
+       << formatRate(r.items_per_second, " items/s");
+    if (r.bytes_per_second > 0.0) os << " " << formatRate(r.bytes_per_second, "B/s");
+    if (!r.label.empty()) os << " " << r.label;
+    os << std::endl;
+}
+
+std::string jsonEscape(const std::string& s) {
+    std::string out;
+    out.reserve(s.size());
+    for (char c : s) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            default: out += c;
+        }
+    }
+    return out;
+}
+
+void reportJson(std::ostream& os, const std::vector<Result>& results) {
+    os << "{\n  \"context\": {\n"
+       << "    \"executable\": \"lab3_bench\",\n"
+#ifdef VERSION_PROJECT
+       << "    \"version\": \"" << jsonEscape(VERSION_PROJECT) << "\",\n"
+#endif
+#ifdef NDEBUG
+       << "    \"library_build_type\": \"release\"\n"
+#else
+       << "    \"library_build_type\": \"debug\"\n"
+#endif
+       << "  },\n  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        os << "    {\n"
+           << "      \"name\": \"" << jsonEscape(r.name) << "\",\n"
+           << "      \"range\": " << r.range << ",\n";
+        if (r.skipped) {
+            os << "      \"error_occurred\": true,\n"
+               << "      \"error_message\": \"" << jsonEscape(r.label) << "\"\n";
+        } else {
+            os << "      \"iterations\": " << r.iterations << ",\n"
+               << "      \"real_time\": " << r.real_ns << ",\n"
+               << "      \"cpu_time\": " << r.cpu_ns << ",\n"
+               << "      \"time_unit\": \"ns\",\n"
+               << "      \"items_per_second\": " << r.items_per_second << ",\n"
+               << "      \"bytes_per_second\": " << r.bytes_per_second << ",\n"
+               << "      \"label\": \"" << jsonEscape(r.label) << "\"\n";
+        }
+        os << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    os << "  ]\n}\n";
+}
+
+std::string csvEscape(const std::string& s) {
+    if (s.find_first_of(",\"") == std::string::npos) return s;
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    return out + "\"";
+}
+
+void reportCsv(std::ostream& os, const std::vector<Result>& results) {
+    os << "name,range,iterations,real_time,cpu_time,time_unit,items_per_second,"
+          "bytes_per_second,label,error_occurred\n";
+    for (const Result& r : results) {
+        os << csvEscape(r.name) << "," << r.range << "," << r.iterations << ","
+           << r.real_ns << "," << r.cpu_ns << ",ns,"
+           << r.items_per_second << "," << r.bytes_per_second << ","
+           << csvEscape(r.label) << "," << (r.skipped ? "true" : "false") << "\n";
+    }
+}
+
+} // namespace
+
+int runMain(int argc, char** argv) {
+    Options opt;
+    if (!parseOptions(argc, argv, opt)) return 1;
+
+    if (opt.list_only) {
+        for (const auto& b : registry()) {
+            if (matches(opt, b.name)) std::cout << b.name << "\n";
+        }
+        return 0;
+    }
+
+    std::ofstream file;
+    if (!opt.out_path.empty()) {
+        file.open(opt.out_path);
+        if (!file) {
+            std::cerr << "Cannot open " << opt.out_path << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = opt.out_path.empty() ? std::cout : file;
+
+    // Прогресс в консольном формате печатаем сразу, JSON/CSV — в конце
+    std::ostream& progress = opt.format == Format::Console ? out : std::cerr;
+    reportConsoleHeader(progress);
+
+    std::vector<Result> results;
+    for (const auto& b : registry()) {
+        if (!matches(opt, b.name)) continue;
+        std::vector<std::size_t> ranges = b.ranges.empty() ? defaultRanges(opt, b.max_range)
+                                                           : b.ranges;
+        for (std::size_t range : ranges) {
+            Result r = runOne(b, range, opt);
+            reportConsole(progress, r);
+            results.push_back(std::move(r));
+        }
+    }
+
+    if (opt.format == Format::Json) reportJson(out, results);
+    else if (opt.format == Format::Csv) reportCsv(out, results);
+    return 0;
+}
+
+} // namespace bench
+
+int main(int argc, char** argv) {
+    return bench::runMain(argc, argv);
+}
@@ -0,0 +1,195 @@
+// Масштабирование параллельных алгоритмов над SimpleVector и списками по числу потоков
+
+#include "benchmark.h"
+#include "benchTypes.h"
+
+#include "parallelAlgorithms.h"
+#include "simpleVector.h"
+#include "singlyLinkedList.h"
+#include "doublyLinkedList.h"
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace {
+
+using bench::State;
+
+SimpleVector<std::int64_t> makeRandom(std::size_t n) {
+    SimpleVector<std::int64_t> v;
+    v.reserve(n);
+    bench::Lcg rng;
+    for (std::size_t i = 0; i < n; ++i) v.push_back(static_cast<std::int64_t>(rng.next(1u << 30)));
+    return v;
+}
+
+template<std::size_t Threads>
+void benchReduce(State& state) {
+    const std::size_t n = state.range();
+    ThreadPool pool(Threads);
+    const auto v = makeRandom(n);
+    for (auto _ : state) {
+        bench::doNotOptimize(parallel_reduce(pool, v.begin(), v.end(), std::int64_t(0), std::plus<>()));
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+// Преобразование с заметной арифметикой на элемент, чтобы упереться не только в память
+template<std::size_t Threads>
+void benchTransform(State& state) {
+    const std::size_t n = state.range();
+    ThreadPool pool(Threads);
+    const auto v = makeRandom(n);
+    SimpleVector<double> out;
+    out.resize(n);
+    for (auto _ : state) {
+        parallel_transform(pool, v.begin(), v.end(), out.begin(),
+                           [](std::int64_t x) { return std::sqrt(static_cast<double>(x)) * 1.5; });
+        bench::clobberMemory();
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+template<std::size_t Threads>
+void benchFor(State& state) {
+    const std::size_t n = state.range();
+    ThreadPool pool(Threads);
+    auto v = makeRandom(n);
+    for (auto _ : state) {
+        parallel_for(pool, v.begin(), v.end(), [](std::int64_t& x) { x = x * 3 + 1; });
+        bench::clobberMemory();
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+template<std::size_t Threads>
+void benchScan(State& state) {
+    const std::size_t n = state.range();
+    ThreadPool pool(Threads);
+    const auto v = makeRandom(n);
+    SimpleVector<std::int64_t> out;
+    out.resize(n);
+    for (auto _ : state) {
+        parallel_scan(pool, v.begin(), v.end(), out.begin());
+        bench::clobberMemory();
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+template<std::size_t Threads>
+void benchSort(State& state) {
+    const std::size_t n = state.range();
+    ThreadPool pool(Threads);
+    const auto source = makeRandom(n);
+    SimpleVector<std::int64_t> v;
+    for (auto _ : state) {
+        state.pauseTiming();
+        v.assign(source.begin(), source.end());
+        state.resumeTiming();
+        parallel_sort(pool, v.begin(), v.end());
+        bench::clobberMemory();
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+template<typename List>
+List makeList(std::size_t n) {
+    List list;
+    bench::Lcg rng;
+    for (std::size_t i = 0; i < n; ++i) list.push_back(static_cast<std::int64_t>(rng.next(1u << 30)));
+    return list;
+}
+
+// Обход списка по заранее посчитанным границам: они переиспользуются между итерациями
+template<typename List, std::size_t Threads>
+void benchListForEach(State& state) {
+    const std::size_t n = state.range();
+    ThreadPool pool(Threads);
+    auto list = makeList<List>(n);
+    const auto bounds = list.chunk_bounds(parallel_detail::list_chunks(pool));
+    for (auto _ : state) {
+        parallel_for_each(pool, bounds, [](std::int64_t& x) { x = x * 3 + 1; });
+        bench::clobberMemory();
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+template<typename List, std::size_t Threads>
+void benchListReduce(State& state) {
+    const std::size_t n = state.range();
+    ThreadPool pool(Threads);
+    const auto list = makeList<List>(n);
+    const auto bounds = list.chunk_bounds(parallel_detail::list_chunks(pool));
+    for (auto _ : state) {
+        bench::doNotOptimize(parallel_reduce(pool, bounds, std::int64_t(0), std::plus<>()));
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+// Искомого значения в списке нет — просматривается весь список
+template<typename List, std::size_t Threads>
+void benchListFindIf(State& state) {
+    const std::size_t n = state.range();
+    ThreadPool pool(Threads);
+    const auto list = makeList<List>(n);
+    const auto bounds = list.chunk_bounds(parallel_detail::list_chunks(pool));
+    for (auto _ : state) {
+        auto it = parallel_find_if(pool, bounds, [](std::int64_t x) { return x < 0; });
+        bench::doNotOptimize(it);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+// Цена самих границ: проход по списку или спуск по позиционному индексу
+template<typename List, bool Indexed>
+void benchListBounds(State& state) {
+    const std::size_t n = state.range();
+    auto list = makeList<List>(n);
+    if (Indexed) list.enable_index();
+    for (auto _ : state) {
+        bench::doNotOptimize(list.chunk_bounds(64));
+    }
+}
+
+template<typename List, std::size_t Threads>
+void registerListSuite(const std::string& name, const std::string& suffix) {
+    bench::registerBenchmark("ParallelList/for_each/" + name + suffix, benchListForEach<List, Threads>);
+    bench::registerBenchmark("ParallelList/reduce/" + name + suffix, benchListReduce<List, Threads>);
+    bench::registerBenchmark("ParallelList/find_if/" + name + suffix, benchListFindIf<List, Threads>);
+}
+
+using PooledSingly = SinglyLinkedList<std::int64_t, PoolAllocator<std::int64_t>>;
+using PooledDoubly = DoublyLinkedList<std::int64_t, PoolAllocator<std::int64_t>>;
+
+template<std::size_t Threads>
+void registerForThreads() {
+    // Больше потоков, чем ядер, замерять незачем: 1 поток всегда остаётся базой
+    if (Threads > 1 && Threads > ThreadPool::default_concurrency()) return;
+    const std::string suffix = "/threads:" + std::to_string(Threads);
+    bench::registerBenchmark("Parallel/reduce" + suffix, benchReduce<Threads>);
+    bench::registerBenchmark("Parallel/transform" + suffix, benchTransform<Threads>);
+    bench::registerBenchmark("Parallel/for" + suffix, benchFor<Threads>);
+    bench::registerBenchmark("Parallel/scan" + suffix, benchScan<Threads>);
+    bench::registerBenchmark("Parallel/sort" + suffix, benchSort<Threads>);
+    registerListSuite<PooledSingly, Threads>("PooledSinglyLinkedList", suffix);
+    registerListSuite<PooledDoubly, Threads>("PooledDoublyLinkedList", suffix);
+}
+
+void registerAll() {
+    bench::registerBenchmark("ParallelList/bounds/walk", benchListBounds<PooledSingly, false>);
+    bench::registerBenchmark("ParallelList/bounds/indexed", benchListBounds<PooledSingly, true>);
+    registerForThreads<1>();
+    registerForThreads<2>();
+    registerForThreads<4>();
+    registerForThreads<8>();
+    registerForThreads<16>();
+    registerForThreads<32>();
+    registerForThreads<64>();
+}
+
+BENCH_REGISTRATION(registerAll);
+
+} // namespace
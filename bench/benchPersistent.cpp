@@ -0,0 +1,101 @@
+// Снимки большого вектора: копия SimpleVector (O(n)) против копии
+// PersistentVector (O(1)), запись после снимка (копируется один чанк) и цена
+// общей структуры при чтении — проход и доступ по номеру
+
+#include "benchmark.h"
+#include "benchTypes.h"
+
+#include "persistentVector.h"
+#include "simpleVector.h"
+
+#include <cstdint>
+#include <string>
+
+namespace {
+
+using bench::State;
+
+template<typename Container>
+Container makeData(std::size_t n) {
+    Container c;
+    for (std::size_t i = 0; i < n; ++i) c.push_back(static_cast<std::int64_t>(i));
+    return c;
+}
+
+// Снимок для читателя
+template<typename Container>
+void benchSnapshot(State& state) {
+    const auto c = makeData<Container>(state.range());
+    for (auto _ : state) {
+        Container snapshot(c);
+        bench::doNotOptimize(snapshot.size());
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+// Снимок и одна запись в оригинал, пока снимок жив
+template<typename Container>
+void benchSnapshotWrite(State& state) {
+    auto c = makeData<Container>(state.range());
+    bench::Lcg rng(1);
+    for (auto _ : state) {
+        Container snapshot(c);
+        c[rng.next(c.size())] += 1;
+        bench::doNotOptimize(snapshot.size());
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+template<typename Container>
+void benchScan(State& state) {
+    const auto c = makeData<Container>(state.range());
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        for (std::int64_t x : c) sum += x;
+        bench::doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations() * c.size());
+}
+
+// Проход по непрерывным чанкам через for_each_chunk
+void benchScanChunks(State& state) {
+    const auto c = makeData<PersistentVector<std::int64_t>>(state.range());
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        c.for_each_chunk([&sum](const std::int64_t* data, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) sum += data[i];
+        });
+        bench::doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations() * c.size());
+}
+
+template<typename Container>
+void benchRandomRead(State& state) {
+    const auto c = makeData<Container>(state.range());
+    bench::Lcg rng(1);
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        for (int k = 0; k < 1000; ++k) sum += c[rng.next(c.size())];
+        bench::doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations() * 1000);
+}
+
+template<typename Container>
+void registerFor(const std::string& name) {
+    bench::registerBenchmark("Persistent/snapshot/" + name, benchSnapshot<Container>);
+    bench::registerBenchmark("Persistent/snapshot_write/" + name, benchSnapshotWrite<Container>);
+    bench::registerBenchmark("Persistent/scan/" + name, benchScan<Container>);
+    bench::registerBenchmark("Persistent/random_read/" + name, benchRandomRead<Container>);
+}
+
+void registerAll() {
+    registerFor<SimpleVector<std::int64_t>>("SimpleVector<int64>");
+    registerFor<PersistentVector<std::int64_t>>("PersistentVector<int64>");
+    bench::registerBenchmark("Persistent/scan_chunks/PersistentVector<int64>", benchScanChunks);
+}
+
+BENCH_REGISTRATION(registerAll);
+
+} // namespace
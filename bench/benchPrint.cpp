@@ -0,0 +1,127 @@
+// Вывод контейнера текстом: print() через operator<< против буферизованного
+// to_chars (textFormat.h) в ostream, FILE* и файловый дескриптор.
+// Вывод идёт в /dev/null, поэтому измеряется форматирование и число
+// системных вызовов, а не диск
+
+#include "benchmark.h"
+#include "benchTypes.h"
+
+#include "doublyLinkedList.h"
+#include "simpleVector.h"
+#include "textFormat.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define BENCH_HAS_DEV_NULL 1
+#else
+#define BENCH_HAS_DEV_NULL 0
+#endif
+
+namespace {
+
+using bench::State;
+
+template<typename Container>
+Container makeData(std::size_t n) {
+    using T = typename Container::value_type;
+    bench::Lcg rng(n + 1);
+    Container c;
+    for (std::size_t i = 0; i < n; ++i) {
+        if constexpr (std::is_floating_point_v<T>) {
+            c.push_back(static_cast<T>(rng.next(1000000)) / 7);
+        } else {
+            c.push_back(static_cast<T>(rng.next(1000000000)));
+        }
+    }
+    return c;
+}
+
+template<typename Container>
+void benchStreamPrint(State& state) {
+    const auto c = makeData<Container>(state.range());
+    std::ofstream os("/dev/null");
+    if (!os) {
+        state.skipWithMessage("/dev/null is not available");
+        return;
+    }
+    for (auto _ : state) {
+        c.print(os);
+        os.flush();
+    }
+    state.setItemsProcessed(state.iterations() * c.size());
+}
+
+template<typename Container>
+void benchStreamBuffered(State& state) {
+    const auto c = makeData<Container>(state.range());
+    std::ofstream os("/dev/null");
+    if (!os) {
+        state.skipWithMessage("/dev/null is not available");
+        return;
+    }
+    for (auto _ : state) {
+        text::print(c, os);
+        os.flush();
+    }
+    state.setItemsProcessed(state.iterations() * c.size());
+}
+
+template<typename Container>
+void benchFileBuffered(State& state) {
+    const auto c = makeData<Container>(state.range());
+    std::FILE* file = std::fopen("/dev/null", "w");
+    if (!file) {
+        state.skipWithMessage("/dev/null is not available");
+        return;
+    }
+    for (auto _ : state) {
+        text::print(c, file);
+        std::fflush(file);
+    }
+    std::fclose(file);
+    state.setItemsProcessed(state.iterations() * c.size());
+}
+
+template<typename Container>
+void benchFdBuffered(State& state) {
+#if BENCH_HAS_DEV_NULL
+    const auto c = makeData<Container>(state.range());
+    const int fd = ::open("/dev/null", O_WRONLY);
+    if (fd < 0) {
+        state.skipWithMessage("/dev/null is not available");
+        return;
+    }
+    for (auto _ : state) {
+        bool ok = text::print_fd(c, fd);
+        bench::doNotOptimize(ok);
+    }
+    ::close(fd);
+    state.setItemsProcessed(state.iterations() * c.size());
+#else
+    state.skipWithMessage("file descriptors are not available");
+#endif
+}
+
+template<typename Container>
+void registerFor(const std::string& name) {
+    const std::string prefix = "Print/" + name + "/";
+    bench::registerBenchmark(prefix + "ostream_print", benchStreamPrint<Container>);
+    bench::registerBenchmark(prefix + "ostream_buffered", benchStreamBuffered<Container>);
+    bench::registerBenchmark(prefix + "file_buffered", benchFileBuffered<Container>);
+    bench::registerBenchmark(prefix + "fd_buffered", benchFdBuffered<Container>);
+}
+
+void registerAll() {
+    registerFor<SimpleVector<int>>("SimpleVector<int>");
+    registerFor<SimpleVector<double>>("SimpleVector<double>");
+    registerFor<DoublyLinkedList<int>>("DoublyLinkedList<int>");
+}
+
+BENCH_REGISTRATION(registerAll);
+
+} // namespace
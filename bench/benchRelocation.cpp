@@ -0,0 +1,130 @@
+// Сравнение побайтового переноса (memcpy/memmove) в SimpleVector
+// с поэлементными циклами, которые используются для остальных типов
+
+#include "benchmark.h"
+#include "benchTypes.h"
+
+#include "simpleVector.h"
+
+#include <string>
+#include <utility>
+
+namespace {
+
+using bench::State;
+
+// Обёртка с пользовательскими конструкторами: тип перестаёт быть
+// тривиально копируемым, и SimpleVector идёт по пути с циклами
+template<typename T>
+struct LoopPath {
+    T value;
+
+    LoopPath(const T& v) : value(v) {}
+    LoopPath(const LoopPath& other) : value(other.value) {}
+    LoopPath(LoopPath&& other) noexcept : value(other.value) {}
+    LoopPath& operator=(const LoopPath& other) { value = other.value; return *this; }
+    LoopPath& operator=(LoopPath&& other) noexcept { value = other.value; return *this; }
+    ~LoopPath() {}
+};
+
+template<typename T>
+std::ostream& operator<<(std::ostream& os, const LoopPath<T>& x) {
+    return os << x.value;
+}
+
+// Владеющий дескриптор: не тривиально копируем, но тривиально перемещаем.
+// Handle<true> подключается к быстрому пути явной специализацией
+template<bool OptIn>
+struct Handle {
+    int* p;
+
+    explicit Handle(int v) : p(new int(v)) {}
+    Handle(const Handle& other) : p(new int(*other.p)) {}
+    Handle(Handle&& other) noexcept : p(other.p) { other.p = nullptr; }
+    Handle& operator=(const Handle& other) {
+        Handle copy(other);
+        std::swap(p, copy.p);
+        return *this;
+    }
+    Handle& operator=(Handle&& other) noexcept { std::swap(p, other.p); return *this; }
+    ~Handle() { delete p; }
+};
+
+template<bool OptIn>
+std::ostream& operator<<(std::ostream& os, const Handle<OptIn>& h) {
+    return os << *h.p;
+}
+
+} // namespace
+
+template<>
+struct is_trivially_relocatable<Handle<true>> : std::true_type {};
+
+namespace {
+
+static_assert(is_trivially_relocatable_v<int>, "int must take the memcpy path");
+static_assert(!is_trivially_relocatable_v<LoopPath<int>>, "LoopPath must take the loop path");
+
+template<typename Elem, typename Raw>
+SimpleVector<Elem> makeVector(std::size_t n) {
+    SimpleVector<Elem> v;
+    v.reserve(n + 1);
+    for (std::size_t i = 0; i < n; ++i) v.push_back(Elem(bench::makeValue<Raw>(i)));
+    return v;
+}
+
+// Рост без reserve: каждая переаллокация переносит все элементы
+template<typename Elem, typename Raw>
+void benchGrow(State& state) {
+    const std::size_t n = state.range();
+    const Elem value(bench::makeValue<Raw>(1));
+    for (auto _ : state) {
+        SimpleVector<Elem> v;
+        for (std::size_t i = 0; i < n; ++i) v.push_back(value);
+        bench::doNotOptimize(v);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+    state.setBytesProcessed(state.iterations() * n * sizeof(Elem));
+}
+
+// Вставка в середину и удаление из середины: сдвиг половины вектора
+template<typename Elem, typename Raw>
+void benchInsertEraseMiddle(State& state) {
+    const std::size_t n = state.range();
+    SimpleVector<Elem> v = makeVector<Elem, Raw>(n);
+    const Elem value(bench::makeValue<Raw>(7));
+    for (auto _ : state) {
+        v.insert(n / 2, value);
+        v.erase(n / 2);
+    }
+    bench::doNotOptimize(v);
+    state.setItemsProcessed(state.iterations() * 2);
+    state.setBytesProcessed(state.iterations() * n * sizeof(Elem));
+}
+
+template<typename Raw>
+void registerForType() {
+    const std::string type = bench::TypeName<Raw>::get();
+    bench::registerBenchmark("Relocation/grow/memcpy<" + type + ">", benchGrow<Raw, Raw>);
+    bench::registerBenchmark("Relocation/grow/loop<" + type + ">", benchGrow<LoopPath<Raw>, Raw>);
+    bench::registerBenchmark("Relocation/insert_erase_middle/memmove<" + type + ">",
+                             benchInsertEraseMiddle<Raw, Raw>);
+    bench::registerBenchmark("Relocation/insert_erase_middle/loop<" + type + ">",
+                             benchInsertEraseMiddle<LoopPath<Raw>, Raw>);
+}
+
+void registerAll() {
+    registerForType<int>();
+    registerForType<bench::Pod64>();
+
+    bench::registerBenchmark("Relocation/grow/memcpy<Handle>", benchGrow<Handle<true>, int>);
+    bench::registerBenchmark("Relocation/grow/loop<Handle>", benchGrow<Handle<false>, int>);
+    bench::registerBenchmark("Relocation/insert_erase_middle/memmove<Handle>",
+                             benchInsertEraseMiddle<Handle<true>, int>);
+    bench::registerBenchmark("Relocation/insert_erase_middle/loop<Handle>",
+                             benchInsertEraseMiddle<Handle<false>, int>);
+}
+
+BENCH_REGISTRATION(registerAll);
+
+} // namespace
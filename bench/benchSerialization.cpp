@@ -0,0 +1,176 @@
+// Сохранение и загрузка SimpleVector<int>: текст (print / operator>>) против
+// двоичного формата (save / load) и отображения файла (map_view).
+// Текстовые и потоковые варианты работают со строковым потоком в памяти,
+// чтобы мерить разбор, а не диск; файловые — с файлом из страничного кэша
+
+#include "benchmark.h"
+#include "benchTypes.h"
+
+#include "doublyLinkedList.h"
+#include "simpleVector.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+using bench::State;
+
+SimpleVector<int> makeData(std::size_t n) {
+    bench::Lcg rng(n + 1);
+    SimpleVector<int> v;
+    v.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) v.push_back(static_cast<int>(rng.next(1000000)));
+    return v;
+}
+
+std::string textOf(const SimpleVector<int>& v) {
+    std::ostringstream os;
+    v.print(os);
+    return os.str();
+}
+
+std::string binaryOf(const SimpleVector<int>& v) {
+    std::ostringstream os;
+    v.save(os);
+    return os.str();
+}
+
+// Временный файл с сохранённым вектором; удаляется вместе с объектом
+class TempFile {
+public:
+    explicit TempFile(const SimpleVector<int>& v)
+        : path_((std::filesystem::temp_directory_path() / "lab3_bench_serialization.bin").string()) {
+        std::ofstream os(path_, std::ios::binary);
+        v.save(os);
+    }
+    ~TempFile() { std::remove(path_.c_str()); }
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+
+    const std::string& path() const noexcept { return path_; }
+
+private:
+    std::string path_;
+};
+
+std::int64_t sumOf(const int* first, const int* last) {
+    std::int64_t sum = 0;
+    for (; first != last; ++first) sum += *first;
+    return sum;
+}
+
+void benchSaveText(State& state) {
+    const auto v = makeData(state.range());
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        std::ostringstream os;
+        v.print(os);
+        bytes = static_cast<std::size_t>(os.tellp());
+        bench::doNotOptimize(bytes);
+    }
+    state.setItemsProcessed(state.iterations() * v.size());
+    state.setBytesProcessed(state.iterations() * bytes);
+}
+
+void benchSaveBinary(State& state) {
+    const auto v = makeData(state.range());
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        std::ostringstream os;
+        v.save(os);
+        bytes = static_cast<std::size_t>(os.tellp());
+        bench::doNotOptimize(bytes);
+    }
+    state.setItemsProcessed(state.iterations() * v.size());
+    state.setBytesProcessed(state.iterations() * bytes);
+}
+
+void benchLoadText(State& state) {
+    const auto v = makeData(state.range());
+    const std::string text = textOf(v);
+    for (auto _ : state) {
+        std::istringstream is(text);
+        SimpleVector<int> loaded;
+        int x;
+        while (is >> x) loaded.push_back(x);
+        bench::doNotOptimize(loaded.data());
+    }
+    state.setItemsProcessed(state.iterations() * v.size());
+    state.setBytesProcessed(state.iterations() * text.size());
+}
+
+void benchLoadBinary(State& state) {
+    const auto v = makeData(state.range());
+    const std::string bytes = binaryOf(v);
+    for (auto _ : state) {
+        std::istringstream is(bytes);
+        SimpleVector<int> loaded;
+        loaded.load(is);
+        bench::doNotOptimize(loaded.data());
+    }
+    state.setItemsProcessed(state.iterations() * v.size());
+    state.setBytesProcessed(state.iterations() * bytes.size());
+}
+
+void benchLoadBinaryList(State& state) {
+    const auto v = makeData(state.range());
+    const std::string bytes = binaryOf(v);
+    for (auto _ : state) {
+        std::istringstream is(bytes);
+        DoublyLinkedList<int> loaded;
+        loaded.load(is);
+        bench::doNotOptimize(loaded.size());
+    }
+    state.setItemsProcessed(state.iterations() * v.size());
+    state.setBytesProcessed(state.iterations() * bytes.size());
+}
+
+// Загрузка из файла и один проход по элементам
+void benchFileLoad(State& state) {
+    const auto v = makeData(state.range());
+    const TempFile file(v);
+    for (auto _ : state) {
+        std::ifstream is(file.path(), std::ios::binary);
+        SimpleVector<int> loaded;
+        loaded.load(is);
+        std::int64_t sum = sumOf(loaded.data(), loaded.data() + loaded.size());
+        bench::doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations() * v.size());
+    state.setBytesProcessed(state.iterations() * v.size() * sizeof(int));
+}
+
+void benchFileMap(State& state) {
+    const auto v = makeData(state.range());
+    const TempFile file(v);
+    if (!SimpleVector<int>::map_view(file.path()).is_mapped()) {
+        state.skipWithMessage("mmap is not available");
+        return;
+    }
+    for (auto _ : state) {
+        const auto mapped = SimpleVector<int>::map_view(file.path());
+        std::int64_t sum = sumOf(mapped.begin(), mapped.end());
+        bench::doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations() * v.size());
+    state.setBytesProcessed(state.iterations() * v.size() * sizeof(int));
+}
+
+void registerAll() {
+    bench::registerBenchmark("Serialize/save/text", benchSaveText);
+    bench::registerBenchmark("Serialize/save/binary", benchSaveBinary);
+    bench::registerBenchmark("Serialize/load/text", benchLoadText);
+    bench::registerBenchmark("Serialize/load/binary", benchLoadBinary);
+    bench::registerBenchmark("Serialize/load/binary_list", benchLoadBinaryList);
+    bench::registerBenchmark("Serialize/file/load", benchFileLoad);
+    bench::registerBenchmark("Serialize/file/map_view", benchFileMap);
+}
+
+BENCH_REGISTRATION(registerAll);
+
+} // namespace
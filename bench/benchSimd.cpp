@@ -0,0 +1,212 @@
+// Векторизованные алгоритмы (simdAlgorithms.h) против обычных циклов по
+// итераторам SimpleVector. Каждый алгоритм измеряется на всех наборах
+// инструкций, которые есть у процессора: scalar — запасной путь simd::,
+// sse2 / avx2 / avx512 — ядра под соответствующую ширину вектора
+
+#include "benchmark.h"
+#include "benchTypes.h"
+
+#include "simdAlgorithms.h"
+#include "simpleVector.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+namespace {
+
+using bench::State;
+
+// Значения в [0, 100): искомое для find не встречается, и проход идёт до конца;
+// условие фильтра выполняется для половины элементов в случайном порядке
+template<typename T>
+SimpleVector<T> makeData(std::size_t n) {
+    bench::Lcg rng(n + 1);
+    SimpleVector<T> v;
+    v.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) v.push_back(static_cast<T>(rng.next(100)));
+    return v;
+}
+
+template<typename T>
+constexpr T kMissing = static_cast<T>(200);
+
+template<typename T>
+constexpr T kThreshold = static_cast<T>(50);
+
+// Ограничивает набор инструкций на время бенчмарка
+class IsaScope {
+public:
+    explicit IsaScope(simd::Isa isa) noexcept { simd::set_max_isa(isa); }
+    ~IsaScope() { simd::set_max_isa(simd::Isa::avx512); }
+    IsaScope(const IsaScope&) = delete;
+    IsaScope& operator=(const IsaScope&) = delete;
+};
+
+template<typename T>
+void benchFindLoop(State& state) {
+    const auto v = makeData<T>(state.range());
+    for (auto _ : state) {
+        auto it = std::find(v.begin(), v.end(), kMissing<T>);
+        bench::doNotOptimize(it);
+    }
+    state.setItemsProcessed(state.iterations() * v.size());
+}
+
+template<typename T>
+void benchFindSimd(State& state, simd::Isa isa) {
+    const auto v = makeData<T>(state.range());
+    IsaScope scope(isa);
+    for (auto _ : state) {
+        std::size_t pos = simd::find(v, kMissing<T>);
+        bench::doNotOptimize(pos);
+    }
+    state.setItemsProcessed(state.iterations() * v.size());
+}
+
+template<typename T>
+void benchCountLoop(State& state) {
+    const auto v = makeData<T>(state.range());
+    for (auto _ : state) {
+        auto count = std::count(v.begin(), v.end(), kThreshold<T>);
+        bench::doNotOptimize(count);
+    }
+    state.setItemsProcessed(state.iterations() * v.size());
+}
+
+template<typename T>
+void benchCountSimd(State& state, simd::Isa isa) {
+    const auto v = makeData<T>(state.range());
+    IsaScope scope(isa);
+    for (auto _ : state) {
+        std::size_t count = simd::count(v, kThreshold<T>);
+        bench::doNotOptimize(count);
+    }
+    state.setItemsProcessed(state.iterations() * v.size());
+}
+
+template<typename T>
+void benchMinLoop(State& state) {
+    const auto v = makeData<T>(state.range());
+    for (auto _ : state) {
+        auto it = std::min_element(v.begin(), v.end());
+        bench::doNotOptimize(it);
+    }
+    state.setItemsProcessed(state.iterations() * v.size());
+}
+
+template<typename T>
+void benchMinSimd(State& state, simd::Isa isa) {
+    const auto v = makeData<T>(state.range());
+    IsaScope scope(isa);
+    for (auto _ : state) {
+        T min = simd::min(v);
+        bench::doNotOptimize(min);
+    }
+    state.setItemsProcessed(state.iterations() * v.size());
+}
+
+template<typename T>
+void benchSumLoop(State& state) {
+    const auto v = makeData<T>(state.range());
+    for (auto _ : state) {
+        simd::sum_t<T> sum = 0;
+        for (T x : v) sum += x;
+        bench::doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations() * v.size());
+}
+
+template<typename T>
+void benchSumSimd(State& state, simd::Isa isa) {
+    const auto v = makeData<T>(state.range());
+    IsaScope scope(isa);
+    for (auto _ : state) {
+        auto sum = simd::sum(v);
+        bench::doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations() * v.size());
+}
+
+template<typename T>
+void benchEqualLoop(State& state) {
+    const auto a = makeData<T>(state.range());
+    const auto b = a;
+    for (auto _ : state) {
+        bool same = std::equal(a.begin(), a.end(), b.begin(), b.end());
+        bench::doNotOptimize(same);
+    }
+    state.setItemsProcessed(state.iterations() * a.size());
+}
+
+template<typename T>
+void benchEqualSimd(State& state, simd::Isa isa) {
+    const auto a = makeData<T>(state.range());
+    const auto b = a;
+    IsaScope scope(isa);
+    for (auto _ : state) {
+        bool same = simd::equal(a, b);
+        bench::doNotOptimize(same);
+    }
+    state.setItemsProcessed(state.iterations() * a.size());
+}
+
+// Выборка элементов меньше порога в заранее выделенный вектор
+template<typename T>
+void benchFilterLoop(State& state) {
+    const auto v = makeData<T>(state.range());
+    SimpleVector<T> out;
+    out.reserve(v.size());
+    for (auto _ : state) {
+        out.clear();
+        for (T x : v) {
+            if (x < kThreshold<T>) out.push_back(x);
+        }
+        bench::doNotOptimize(out.data());
+    }
+    state.setItemsProcessed(state.iterations() * v.size());
+}
+
+template<typename T>
+void benchFilterSimd(State& state, simd::Isa isa) {
+    const auto v = makeData<T>(state.range());
+    SimpleVector<T> out;
+    out.resize(v.size());
+    IsaScope scope(isa);
+    for (auto _ : state) {
+        std::size_t kept = simd::copy_if(v.data(), v.size(), out.data(), simd::Compare::less, kThreshold<T>);
+        bench::doNotOptimize(kept);
+        bench::clobberMemory();
+    }
+    state.setItemsProcessed(state.iterations() * v.size());
+}
+
+template<typename T>
+void registerOp(const std::string& op, bench::Function loop, void (*kernel)(State&, simd::Isa)) {
+    const std::string prefix = "Simd/" + op + "<" + bench::TypeName<T>::get() + ">/";
+    bench::registerBenchmark(prefix + "loop", std::move(loop));
+    for (simd::Isa isa : {simd::Isa::scalar, simd::Isa::sse2, simd::Isa::avx2, simd::Isa::avx512}) {
+        if (isa > simd::detected_isa()) break;
+        bench::registerBenchmark(prefix + simd::isa_name(isa), [kernel, isa](State& state) { kernel(state, isa); });
+    }
+}
+
+template<typename T>
+void registerForType() {
+    registerOp<T>("find", benchFindLoop<T>, benchFindSimd<T>);
+    registerOp<T>("count", benchCountLoop<T>, benchCountSimd<T>);
+    registerOp<T>("min", benchMinLoop<T>, benchMinSimd<T>);
+    registerOp<T>("sum", benchSumLoop<T>, benchSumSimd<T>);
+    registerOp<T>("equal", benchEqualLoop<T>, benchEqualSimd<T>);
+    registerOp<T>("filter", benchFilterLoop<T>, benchFilterSimd<T>);
+}
+
+void registerAll() {
+    registerForType<std::uint8_t>();
+    registerForType<int>();
+    registerForType<float>();
+}
+
+BENCH_REGISTRATION(registerAll);
+
+} // namespace
@@ -0,0 +1,52 @@
+// Короткоживущие маленькие векторы: SimpleVector против SmallVector со встроенным буфером
+
+#include "benchmark.h"
+#include "benchTypes.h"
+
+#include "simpleVector.h"
+#include "smallVector.h"
+
+#include <string>
+#include <utility>
+
+namespace {
+
+using bench::State;
+
+constexpr std::size_t kInline = 16;
+
+// Создание, заполнение, перемещение и уничтожение вектора из range() элементов
+template<typename Container>
+void benchShortLived(State& state) {
+    using T = typename Container::value_type;
+    const std::size_t n = state.range();
+    const T value = bench::makeValue<T>(3);
+    for (auto _ : state) {
+        Container c;
+        for (std::size_t i = 0; i < n; ++i) c.push_back(value);
+        Container moved(std::move(c));
+        bench::doNotOptimize(moved);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+template<typename T>
+void registerForType() {
+    const std::string type = std::string("<") + bench::TypeName<T>::get() + ">";
+    // Размеры до встроенной ёмкости, ровно на ней и с выходом в кучу
+    const std::vector<std::size_t> sizes = {4, kInline, 4 * kInline};
+    bench::registerBenchmarkArgs("Small/short_lived/SimpleVector" + type,
+                                 benchShortLived<SimpleVector<T>>, sizes);
+    bench::registerBenchmarkArgs("Small/short_lived/SmallVector16" + type,
+                                 benchShortLived<SmallVector<T, kInline>>, sizes);
+}
+
+void registerAll() {
+    registerForType<int>();
+    registerForType<bench::Pod64>();
+    registerForType<std::string>();
+}
+
+BENCH_REGISTRATION(registerAll);
+
+} // namespace
@@ -0,0 +1,167 @@
+// Записи по строкам (SimpleVector<Record>) против записей по столбцам (SoAVector):
+// сумма одного поля, фильтр по двум полям и чтение строк целиком
+
+#include "benchmark.h"
+#include "benchTypes.h"
+
+#include "simpleVector.h"
+#include "soaVector.h"
+
+#include <array>
+#include <cstdint>
+#include <tuple>
+
+namespace {
+
+using bench::State;
+
+// Широкая запись на одну кэш-линию, из которой обычно читают одно-два поля
+struct Record {
+    std::int64_t id;
+    std::int64_t price;      // в копейках
+    std::int64_t timestamp;
+    double weight;
+    std::int32_t quantity;
+    std::int32_t category;
+    std::array<char, 24> note;
+};
+
+static_assert(sizeof(Record) == 64, "Record must fill one cache line");
+
+using RecordColumns = SoAVector<std::int64_t, std::int64_t, std::int64_t, double,
+                                std::int32_t, std::int32_t, std::array<char, 24>>;
+
+enum Field : std::size_t { kId, kPrice, kTimestamp, kWeight, kQuantity, kCategory, kNote };
+
+constexpr std::int32_t kCategories = 16;
+
+Record makeRecord(std::size_t i) {
+    bench::Lcg rng(i + 1);
+    Record r{};
+    r.id = static_cast<std::int64_t>(i);
+    r.price = static_cast<std::int64_t>(rng.next(100000));
+    r.timestamp = static_cast<std::int64_t>(i) * 1000;
+    r.weight = static_cast<double>(rng.next(1000)) / 10.0;
+    r.quantity = static_cast<std::int32_t>(rng.next(100));
+    r.category = static_cast<std::int32_t>(rng.next(kCategories));
+    return r;
+}
+
+SimpleVector<Record> makeRows(std::size_t n) {
+    SimpleVector<Record> rows;
+    rows.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) rows.push_back(makeRecord(i));
+    return rows;
+}
+
+RecordColumns makeColumns(std::size_t n) {
+    RecordColumns columns;
+    columns.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const Record r = makeRecord(i);
+        columns.emplace_back(r.id, r.price, r.timestamp, r.weight, r.quantity, r.category, r.note);
+    }
+    return columns;
+}
+
+// Сумма цен: из каждой кэш-линии записи нужно 8 байт из 64
+void benchSumRows(State& state) {
+    const std::size_t n = state.range();
+    const auto rows = makeRows(n);
+    for (auto _ : state) {
+        const Record* p = rows.data();
+        std::int64_t sum = 0;
+        for (std::size_t i = 0; i < n; ++i) sum += p[i].price;
+        bench::doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+void benchSumColumns(State& state) {
+    const std::size_t n = state.range();
+    const auto columns = makeColumns(n);
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        for (std::int64_t price : columns.column<kPrice>()) sum += price;
+        bench::doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+// Фильтр: количество товара одной категории дороже порога — три поля из семи.
+// Условие без ветвлений, чтобы цикл по столбцам векторизовался
+void benchFilterRows(State& state) {
+    const std::size_t n = state.range();
+    const auto rows = makeRows(n);
+    for (auto _ : state) {
+        const Record* p = rows.data();
+        std::int64_t total = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const bool match = (p[i].category == 3) & (p[i].price > 50000);
+            total += match ? p[i].quantity : 0;
+        }
+        bench::doNotOptimize(total);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+void benchFilterColumns(State& state) {
+    const std::size_t n = state.range();
+    const auto columns = makeColumns(n);
+    for (auto _ : state) {
+        const std::int32_t* category = columns.data<kCategory>();
+        const std::int64_t* price = columns.data<kPrice>();
+        const std::int32_t* quantity = columns.data<kQuantity>();
+        std::int64_t total = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const bool match = (category[i] == 3) & (price[i] > 50000);
+            total += match ? quantity[i] : 0;
+        }
+        bench::doNotOptimize(total);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+// Чтение строк целиком: запись собирается из семи массивов, и пока данные
+// в кэше, раскладка по столбцам проигрывает чтению записи подряд
+void benchRowsRows(State& state) {
+    const std::size_t n = state.range();
+    const auto rows = makeRows(n);
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        for (const Record& r : rows) {
+            sum += r.id + r.price + r.timestamp + static_cast<std::int64_t>(r.weight) +
+                   r.quantity + r.category + r.note[0];
+        }
+        bench::doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+void benchRowsColumns(State& state) {
+    const std::size_t n = state.range();
+    const auto columns = makeColumns(n);
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        for (auto row : columns) {
+            const auto& [id, price, timestamp, weight, quantity, category, note] = row;
+            sum += id + price + timestamp + static_cast<std::int64_t>(weight) +
+                   quantity + category + note[0];
+        }
+        bench::doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+void registerAll() {
+    bench::registerBenchmark("SoA/field_sum/SimpleVector<Record>", benchSumRows);
+    bench::registerBenchmark("SoA/field_sum/SoAVector", benchSumColumns);
+    bench::registerBenchmark("SoA/filter/SimpleVector<Record>", benchFilterRows);
+    bench::registerBenchmark("SoA/filter/SoAVector", benchFilterColumns);
+    bench::registerBenchmark("SoA/row/SimpleVector<Record>", benchRowsRows);
+    bench::registerBenchmark("SoA/row/SoAVector", benchRowsColumns);
+}
+
+BENCH_REGISTRATION(registerAll);
+
+} // namespace
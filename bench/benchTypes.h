@@ -0,0 +1,82 @@
+#ifndef BENCH_TYPES_H
+#define BENCH_TYPES_H
+
+// Типы элементов и вспомогательные функции, общие для всех бенчмарков
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+// Тривиально копируемая структура размером ровно 64 байта (одна кэш-линия)
+struct Pod64 {
+    std::int64_t v[8];
+};
+
+static_assert(sizeof(Pod64) == 64, "Pod64 must be exactly 64 bytes");
+
+inline std::ostream& operator<<(std::ostream& os, const Pod64& p) {
+    return os << p.v[0];
+}
+
+template<typename T>
+struct TypeName;
+
+template<> struct TypeName<int> { static const char* get() { return "int"; } };
+template<> struct TypeName<float> { static const char* get() { return "float"; } };
+template<> struct TypeName<std::uint8_t> { static const char* get() { return "uint8"; } };
+template<> struct TypeName<Pod64> { static const char* get() { return "Pod64"; } };
+template<> struct TypeName<std::string> { static const char* get() { return "string"; } };
+
+template<typename T>
+T makeValue(std::size_t i);
+
+template<>
+inline int makeValue<int>(std::size_t i) { return static_cast<int>(i); }
+
+template<>
+inline Pod64 makeValue<Pod64>(std::size_t i) {
+    Pod64 p{};
+    for (auto& x : p.v) x = static_cast<std::int64_t>(i);
+    return p;
+}
+
+// Строки длиннее SSO-буфера, чтобы каждая владела кучей
+template<>
+inline std::string makeValue<std::string>(std::size_t i) {
+    return "benchmark-string-value-" + std::to_string(i);
+}
+
+template<typename T>
+std::vector<T> makeValues(std::size_t n) {
+    std::vector<T> values;
+    values.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) values.push_back(makeValue<T>(i));
+    return values;
+}
+
+// Свёртка элемента в число, чтобы результат обхода нельзя было выбросить
+inline std::size_t touch(int x) { return static_cast<std::size_t>(x); }
+inline std::size_t touch(const Pod64& p) { return static_cast<std::size_t>(p.v[0] + p.v[7]); }
+inline std::size_t touch(const std::string& s) { return s.size(); }
+
+// Быстрый детерминированный генератор индексов
+class Lcg {
+public:
+    explicit Lcg(std::uint64_t seed = 0x9E3779B97F4A7C15ULL) : state_(seed) {}
+
+    std::size_t next(std::size_t bound) {
+        state_ = state_ * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<std::size_t>((state_ >> 33) % bound);
+    }
+
+private:
+    std::uint64_t state_;
+};
+
+} // namespace bench
+
+#endif // BENCH_TYPES_H
@@ -0,0 +1,177 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+// Минимальный каркас бенчмарков в стиле Google Benchmark:
+// регистрация функций, цикл `for (auto _ : state)`, калибровка числа
+// итераций по времени и вывод в console / JSON / CSV.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+// Не даёт компилятору выбросить вычисление результата
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    const volatile char* p = reinterpret_cast<const volatile char*>(&value);
+    (void)*p;
+#endif
+}
+
+inline void clobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+class State {
+public:
+    using clock = std::chrono::steady_clock;
+
+    State(std::size_t range, std::uint64_t iterations)
+        : range_(range), max_iterations_(iterations) {}
+
+    std::size_t range() const noexcept { return range_; }
+    std::uint64_t iterations() const noexcept { return max_iterations_; }
+
+    // Итератор для `for (auto _ : state)`: запускает таймер в begin()
+    // и останавливает его, когда итерации закончились
+    class Iterator {
+    public:
+        // Пустой тип вместо int: неиспользуемая `_` не даёт -Wunused-variable
+        struct [[maybe_unused]] Value {};
+
+        Iterator(State* state, std::uint64_t remaining) : state_(state), remaining_(remaining) {}
+
+        Value operator*() const noexcept { return {}; }
+        Iterator& operator++() noexcept { --remaining_; return *this; }
+
+        bool operator!=(const Iterator&) noexcept {
+            if (remaining_ != 0) return true;
+            state_->finishTiming();
+            return false;
+        }
+
+    private:
+        State* state_;
+        std::uint64_t remaining_;
+    };
+
+    Iterator begin() {
+        startTiming();
+        return Iterator(this, max_iterations_);
+    }
+    Iterator end() { return Iterator(this, 0); }
+
+    // Исключение подготовки данных из замера
+    void pauseTiming() {
+        accumulate();
+        running_ = false;
+    }
+    void resumeTiming() { startTiming(); }
+
+    void setItemsProcessed(std::uint64_t items) noexcept { items_processed_ = items; }
+    void setBytesProcessed(std::uint64_t bytes) noexcept { bytes_processed_ = bytes; }
+    void setLabel(std::string label) { label_ = std::move(label); }
+
+    void skipWithMessage(std::string message) {
+        skipped_ = true;
+        label_ = std::move(message);
+    }
+
+    double realSeconds() const noexcept { return real_seconds_; }
+    double cpuSeconds() const noexcept { return cpu_seconds_; }
+    std::uint64_t itemsProcessed() const noexcept { return items_processed_; }
+    std::uint64_t bytesProcessed() const noexcept { return bytes_processed_; }
+    const std::string& label() const noexcept { return label_; }
+    bool skipped() const noexcept { return skipped_; }
+
+private:
+    std::size_t range_;
+    std::uint64_t max_iterations_;
+
+    bool running_ = false;
+    clock::time_point real_start_{};
+    std::clock_t cpu_start_ = 0;
+    double real_seconds_ = 0.0;
+    double cpu_seconds_ = 0.0;
+
+    std::uint64_t items_processed_ = 0;
+    std::uint64_t bytes_processed_ = 0;
+    std::string label_;
+    bool skipped_ = false;
+
+    void startTiming() {
+        running_ = true;
+        cpu_start_ = std::clock();
+        real_start_ = clock::now();
+    }
+
+    void accumulate() {
+        if (!running_) return;
+        auto real_end = clock::now();
+        std::clock_t cpu_end = std::clock();
+        real_seconds_ += std::chrono::duration<double>(real_end - real_start_).count();
+        cpu_seconds_ += static_cast<double>(cpu_end - cpu_start_) / CLOCKS_PER_SEC;
+    }
+
+    void finishTiming() {
+        accumulate();
+        running_ = false;
+    }
+};
+
+using Function = std::function<void(State&)>;
+
+struct Benchmark {
+    std::string name;
+    Function fn;
+    // Наибольший размер, на котором имеет смысл запускать этот случай
+    std::size_t max_range = std::numeric_limits<std::size_t>::max();
+    // Явный список аргументов; если пуст, используются размеры из командной строки
+    std::vector<std::size_t> ranges;
+};
+
+struct Result {
+    std::string name;
+    std::size_t range = 0;
+    std::uint64_t iterations = 0;
+    double real_ns = 0.0;      // на одну итерацию
+    double cpu_ns = 0.0;       // на одну итерацию
+    double items_per_second = 0.0;
+    double bytes_per_second = 0.0;
+    std::string label;
+    bool skipped = false;
+};
+
+std::vector<Benchmark>& registry();
+
+// Регистрирует бенчмарк; возвращает true, чтобы использоваться в статической инициализации
+bool registerBenchmark(std::string name, Function fn,
+                       std::size_t max_range = std::numeric_limits<std::size_t>::max());
+
+// Регистрирует бенчмарк с фиксированным набором аргументов (например, числом потоков)
+bool registerBenchmarkArgs(std::string name, Function fn, std::vector<std::size_t> ranges);
+
+int runMain(int argc, char** argv);
+
+} // namespace bench
+
+#define BENCH_CONCAT_IMPL(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_IMPL(a, b)
+
+// Выполняет блок регистрации при статической инициализации единицы трансляции
+#define BENCH_REGISTRATION(fn) \
+    [[maybe_unused]] static const bool BENCH_CONCAT(bench_registered_, __LINE__) = (fn(), true)
+
+#endif // BENCHMARK_H
@@ -0,0 +1,387 @@
+#ifndef BINARY_IO_H
+#define BINARY_IO_H
+
+#include "checkPolicy.h"
+#include "platformMemory.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// Двоичный формат контейнеров: заголовок на 64 байта и элементы подряд.
+// Формат общий для SimpleVector и списков — сохранённое одним контейнером
+// загружается в любой другой с тем же типом элементов.
+//
+//     смещение  поле
+//      0        magic "LAB3BIN\0"
+//      8        версия формата
+//     12        метка порядка байт 0x01020304 в порядке записавшей машины
+//     16        кодек элементов: 0 — байты объекта, 1 — строка с длиной
+//     20        размер элемента (sizeof(T) для кодека 0)
+//     24        код арифметического типа (0 — не арифметический)
+//     32        число элементов
+//     64        элементы
+//
+// Тривиально копируемые элементы пишутся байтами объекта, без разбора, и
+// при отображении файла (MappedArray) начинаются с адреса, выровненного
+// на 64 байта. Для других типов нужна специализация binary::Serializer.
+// Файл с другим порядком байт или другой версией не загружается.
+
+namespace binary {
+
+constexpr std::uint32_t format_version = 1;
+constexpr std::size_t header_size = 64;
+
+// Файл не в этом формате, с другим типом элементов или обрезан
+class format_error : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+enum class Codec : std::uint32_t { raw = 0, string = 1 };
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t codec;
+    std::uint32_t element_size;
+    std::uint32_t type_code;
+    std::uint32_t reserved0;
+    std::uint64_t count;
+    std::uint8_t reserved[24];
+};
+
+static_assert(sizeof(Header) == header_size, "binary header must be 64 bytes");
+
+constexpr char header_magic[8] = {'L', 'A', 'B', '3', 'B', 'I', 'N', '\0'};
+constexpr std::uint32_t byte_order_tag = 0x01020304;
+
+// Как записать и прочитать элемент. Специализация задаёт codec, element_size,
+// type_code, write(os, value) и read(is, remaining) -> T, где remaining —
+// сколько байт ещё есть в потоке (max(), если неизвестно); read уменьшает
+// его на прочитанное и по нему проверяет длины, не переходя по потоку
+template<typename T, typename = void>
+struct Serializer;
+
+// Байты объекта; код типа различает int/unsigned/float одного размера
+template<typename T>
+struct Serializer<T, std::enable_if_t<std::is_trivially_copyable_v<T>>> {
+    static constexpr Codec codec = Codec::raw;
+    static constexpr std::uint32_t element_size = sizeof(T);
+    static constexpr std::uint32_t type_code =
+        !std::is_arithmetic_v<T> ? 0
+                                 : (std::is_floating_point_v<T> ? 0x200u : 0u) |
+                                       (std::is_signed_v<T> ? 0x100u : 0u) | static_cast<std::uint32_t>(sizeof(T));
+};
+
+// Длина (uint64) и символы
+template<>
+struct Serializer<std::string, void> {
+    static constexpr Codec codec = Codec::string;
+    static constexpr std::uint32_t element_size = 1;
+    static constexpr std::uint32_t type_code = 0;
+
+    static void write(std::ostream& os, const std::string& value) {
+        const std::uint64_t length = value.size();
+        os.write(reinterpret_cast<const char*>(&length), sizeof length);
+        os.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+    static std::string read(std::istream& is, std::uint64_t& remaining);
+};
+
+namespace binary_detail {
+
+// Размер буфера для поэлементной записи и чтения
+constexpr std::size_t chunk_bytes = std::size_t(64) << 10;
+
+[[noreturn]] LAB3_COLD inline void throw_format(const char* msg) {
+    throw format_error(msg);
+}
+
+inline void read_bytes(std::istream& is, void* dst, std::size_t bytes) {
+    is.read(static_cast<char*>(dst), static_cast<std::streamsize>(bytes));
+    if (LAB3_UNLIKELY(static_cast<std::size_t>(is.gcount()) != bytes)) throw_format("Truncated binary data");
+}
+
+// Сколько байт осталось в потоке; max(), если поток не умеет переходить
+inline std::uint64_t remaining_bytes(std::istream& is) {
+    const auto pos = is.tellg();
+    if (pos == std::istream::pos_type(-1)) return std::numeric_limits<std::uint64_t>::max();
+    is.seekg(0, std::ios::end);
+    const auto end = is.tellg();
+    is.seekg(pos);
+    if (end == std::istream::pos_type(-1) || !is) {
+        is.clear();
+        is.seekg(pos);
+        return std::numeric_limits<std::uint64_t>::max();
+    }
+    return static_cast<std::uint64_t>(end - pos);
+}
+
+} // namespace binary_detail
+
+inline std::string Serializer<std::string, void>::read(std::istream& is, std::uint64_t& remaining) {
+    std::uint64_t length = 0;
+    binary_detail::read_bytes(is, &length, sizeof length);
+    if (LAB3_UNLIKELY(remaining < sizeof length || length > remaining - sizeof length)) {
+        binary_detail::throw_format("Truncated binary data");
+    }
+    std::string value(static_cast<std::size_t>(length), '\0');
+    binary_detail::read_bytes(is, value.data(), value.size());
+    if (remaining != std::numeric_limits<std::uint64_t>::max()) remaining -= sizeof length + length;
+    return value;
+}
+
+template<typename T>
+Header make_header(std::uint64_t count) noexcept {
+    Header h{};
+    std::memcpy(h.magic, header_magic, sizeof h.magic);
+    h.version = format_version;
+    h.byte_order = byte_order_tag;
+    h.codec = static_cast<std::uint32_t>(Serializer<T>::codec);
+    h.element_size = Serializer<T>::element_size;
+    h.type_code = Serializer<T>::type_code;
+    h.count = count;
+    return h;
+}
+
+// Проверяет, что заголовок описывает элементы типа T; возвращает их число
+template<typename T>
+std::uint64_t check_header(const Header& h) {
+    using binary_detail::throw_format;
+    if (std::memcmp(h.magic, header_magic, sizeof h.magic) != 0) throw_format("Not a lab3 binary file");
+    if (h.byte_order != byte_order_tag) throw_format("Binary file has a different byte order");
+    if (h.version == 0 || h.version > format_version) throw_format("Unsupported binary format version");
+    if (h.codec != static_cast<std::uint32_t>(Serializer<T>::codec) ||
+        h.element_size != Serializer<T>::element_size ||
+        (h.type_code != 0 && Serializer<T>::type_code != 0 && h.type_code != Serializer<T>::type_code)) {
+        throw_format("Binary file holds a different element type");
+    }
+    if (Serializer<T>::codec == Codec::raw &&
+        h.count > std::numeric_limits<std::uint64_t>::max() / Serializer<T>::element_size) {
+        throw_format("Corrupt element count in binary file");
+    }
+    return h.count;
+}
+
+template<typename T>
+void write_header(std::ostream& os, std::uint64_t count) {
+    const Header h = make_header<T>(count);
+    os.write(reinterpret_cast<const char*>(&h), sizeof h);
+}
+
+// Читает и проверяет заголовок; в remaining — остаток потока после него
+// (max(), если поток не умеет переходить), который затем передаётся в
+// read_elements. Длина потока узнаётся здесь один раз: переход по
+// ifstream сбрасывает его буфер. Для элементов фиксированного размера
+// число элементов сверяется с остатком, чтобы испорченный файл не
+// заставил выделить гигабайты под несуществующие данные; у строк в остаток
+// должна поместиться хотя бы длина каждой
+template<typename T>
+std::uint64_t read_header(std::istream& is, std::uint64_t& remaining) {
+    Header h;
+    binary_detail::read_bytes(is, &h, sizeof h);
+    const std::uint64_t count = check_header<T>(h);
+    remaining = binary_detail::remaining_bytes(is);
+    if constexpr (Serializer<T>::codec == Codec::raw) {
+        if (LAB3_UNLIKELY(count * sizeof(T) > remaining)) binary_detail::throw_format("Truncated binary data");
+    } else if constexpr (Serializer<T>::codec == Codec::string) {
+        if (LAB3_UNLIKELY(count > remaining / sizeof(std::uint64_t))) {
+            binary_detail::throw_format("Truncated binary data");
+        }
+    }
+    return count;
+}
+
+// Элементы непрерывного массива: байты объектов одной записью
+template<typename T>
+void write_elements(std::ostream& os, const T* data, std::size_t count) {
+    if constexpr (Serializer<T>::codec == Codec::raw) {
+        if (count > 0) {
+            os.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+        }
+    } else {
+        for (std::size_t i = 0; i < count && os; ++i) Serializer<T>::write(os, data[i]);
+    }
+}
+
+// Элементы по итераторам (узлы списка): байты копируются в буфер и
+// пишутся блоками, а не вызовом ostream::write на каждый элемент
+template<typename T, typename It>
+void write_elements(std::ostream& os, It first, It last) {
+    if constexpr (Serializer<T>::codec == Codec::raw) {
+        constexpr std::size_t per_chunk = std::max<std::size_t>(1, binary_detail::chunk_bytes / sizeof(T));
+        std::unique_ptr<unsigned char[]> buffer(new unsigned char[per_chunk * sizeof(T)]);
+        std::size_t filled = 0;
+        for (; first != last; ++first) {
+            std::memcpy(buffer.get() + filled * sizeof(T), std::addressof(*first), sizeof(T));
+            if (++filled == per_chunk) {
+                os.write(reinterpret_cast<const char*>(buffer.get()), static_cast<std::streamsize>(filled * sizeof(T)));
+                filled = 0;
+            }
+        }
+        if (filled > 0) {
+            os.write(reinterpret_cast<const char*>(buffer.get()), static_cast<std::streamsize>(filled * sizeof(T)));
+        }
+    } else {
+        for (; first != last && os; ++first) Serializer<T>::write(os, *first);
+    }
+}
+
+// Читает count элементов и передаёт каждый в push(T&&); remaining — из read_header
+template<typename T, typename Push>
+void read_elements(std::istream& is, std::uint64_t count, std::uint64_t remaining, Push push) {
+    if constexpr (Serializer<T>::codec == Codec::raw) {
+        constexpr std::size_t per_chunk = std::max<std::size_t>(1, binary_detail::chunk_bytes / sizeof(T));
+        std::unique_ptr<unsigned char[]> buffer(new unsigned char[per_chunk * sizeof(T)]);
+        while (count > 0) {
+            const auto n = static_cast<std::size_t>(std::min<std::uint64_t>(count, per_chunk));
+            binary_detail::read_bytes(is, buffer.get(), n * sizeof(T));
+            for (std::size_t i = 0; i < n; ++i) {
+                T value;
+                std::memcpy(static_cast<void*>(&value), buffer.get() + i * sizeof(T), sizeof(T));
+                push(std::move(value));
+            }
+            count -= n;
+        }
+    } else {
+        for (; count > 0; --count) push(Serializer<T>::read(is, remaining));
+    }
+}
+
+// Содержимое файла в двоичном формате без копирования: файл отображается
+// в память, и элементы читаются прямо из страничного кэша — открытие
+// многогигабайтного файла не зависит от его размера, страницы подгружаются
+// при первом обращении.
+//
+// MappedArray<const T> — только чтение. MappedArray<T> — копирование при
+// записи: изменённые страницы копируются и видны только этому объекту,
+// файл на диске не меняется. На платформах без mmap файл читается в память.
+//
+// Только для тривиально копируемых T. Отображение действительно, пока жив
+// объект; файл не должен укорачиваться, пока он открыт (SIGBUS)
+template<typename T>
+class MappedArray {
+    using Element = std::remove_const_t<T>;
+
+    static_assert(Serializer<Element>::codec == Codec::raw,
+                  "MappedArray needs a trivially copyable element type");
+    static_assert(alignof(Element) <= header_size, "element alignment exceeds the header size");
+
+public:
+    using value_type = Element;
+    using size_type = std::size_t;
+    using pointer = T*;
+    using reference = T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    MappedArray() noexcept = default;
+
+    // Бросает format_error, если файл не в формате или не с теми элементами,
+    // и std::runtime_error, если его нельзя открыть
+    static MappedArray open(const std::string& path) {
+        MappedArray array;
+        constexpr bool copy_on_write = !std::is_const_v<T>;
+        array.base_ = platform::map_file(path.c_str(), copy_on_write, array.bytes_);
+        array.mapped_ = array.base_ != nullptr;
+        if (!array.mapped_) array.read_whole(path);
+        if (LAB3_UNLIKELY(array.bytes_ < header_size)) binary_detail::throw_format("Truncated binary data");
+
+        Header h;
+        std::memcpy(&h, array.base_, sizeof h);
+        const std::uint64_t count = check_header<Element>(h);
+        if (LAB3_UNLIKELY(count > (array.bytes_ - header_size) / sizeof(Element))) {
+            binary_detail::throw_format("Truncated binary data");
+        }
+        array.size_ = static_cast<size_type>(count);
+        array.data_ = reinterpret_cast<T*>(static_cast<unsigned char*>(array.base_) + header_size);
+        return array;
+    }
+
+    MappedArray(MappedArray&& other) noexcept
+        : base_(std::exchange(other.base_, nullptr)), bytes_(std::exchange(other.bytes_, 0)),
+          data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)),
+          mapped_(other.mapped_) {}
+
+    MappedArray& operator=(MappedArray&& other) noexcept {
+        if (this != &other) {
+            release();
+            base_ = std::exchange(other.base_, nullptr);
+            bytes_ = std::exchange(other.bytes_, 0);
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            mapped_ = other.mapped_;
+        }
+        return *this;
+    }
+
+    MappedArray(const MappedArray&) = delete;
+    MappedArray& operator=(const MappedArray&) = delete;
+
+    ~MappedArray() { release(); }
+
+    size_type size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    // Файл отображён (а не прочитан в память на платформе без mmap)
+    bool is_mapped() const noexcept { return mapped_; }
+
+    pointer data() const noexcept { return data_; }
+    reference operator[](size_type idx) const noexcept { return data_[idx]; }
+
+    reference at(size_type idx) const {
+        if (LAB3_UNLIKELY(idx >= size_)) throw_out_of_range();
+        return data_[idx];
+    }
+
+    iterator begin() const noexcept { return data_; }
+    iterator end() const noexcept { return data_ + size_; }
+
+private:
+    void* base_ = nullptr;
+    std::size_t bytes_ = 0;
+    T* data_ = nullptr;
+    size_type size_ = 0;
+    bool mapped_ = false;
+
+    // Запасной путь без mmap: файл целиком в буфер с тем же выравниванием
+    void read_whole(const std::string& path) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) throw std::runtime_error("Cannot open binary file: " + path);
+        bytes_ = static_cast<std::size_t>(in.tellg());
+        in.seekg(0);
+        base_ = ::operator new(std::max<std::size_t>(bytes_, 1), std::align_val_t(header_size));
+        binary_detail::read_bytes(in, base_, bytes_);
+    }
+
+    void release() noexcept {
+        if (!base_) return;
+        if (mapped_) {
+            platform::unmap(base_, bytes_);
+        } else {
+            ::operator delete(base_, std::align_val_t(header_size));
+        }
+        base_ = nullptr;
+    }
+
+    [[noreturn]] LAB3_COLD static void throw_out_of_range() {
+        throw std::out_of_range("Index out of range");
+    }
+};
+
+} // namespace binary
+
+#endif // BINARY_IO_H
@@ -0,0 +1,43 @@
+#ifndef CHECK_POLICY_H
+#define CHECK_POLICY_H
+
+// Подсказки компилятору для проверок, которые почти никогда не срабатывают:
+// вероятная ветвь и холодная функция, вынесенная из горячего кода
+#if defined(__GNUC__) || defined(__clang__)
+#define LAB3_LIKELY(x) __builtin_expect(!!(x), 1)
+#define LAB3_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#define LAB3_COLD __attribute__((noinline, cold))
+#else
+#define LAB3_LIKELY(x) (x)
+#define LAB3_UNLIKELY(x) (x)
+#define LAB3_COLD
+#endif
+
+// Политика проверки номера в operator[] SimpleVector.
+// at() проверяет номер всегда, независимо от политики:
+//
+//     SimpleVector<int, DefaultGrowthPolicy, NeverCheck> v;  // operator[] без ветвлений
+//     v.at(i);                                                // с проверкой
+
+// Проверять всегда, в том числе в release-сборке
+struct AlwaysCheck {
+    static constexpr bool check_index = true;
+};
+
+// Проверять только в отладочной сборке (без NDEBUG), как assert
+struct DebugCheck {
+#ifdef NDEBUG
+    static constexpr bool check_index = false;
+#else
+    static constexpr bool check_index = true;
+#endif
+};
+
+// Не проверять: выход за границы — неопределённое поведение, как у std::vector
+struct NeverCheck {
+    static constexpr bool check_index = false;
+};
+
+using DefaultCheckPolicy = DebugCheck;
+
+#endif // CHECK_POLICY_H
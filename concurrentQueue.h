@@ -0,0 +1,132 @@
+#ifndef CONCURRENT_QUEUE_H
+#define CONCURRENT_QUEUE_H
+
+#include "hazardPointers.h"
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+// Неограниченная lock-free очередь многих производителей и потребителей
+// (Michael & Scott, 1996) на односвязном списке. Голова списка — фиктивный
+// узел без значения; извлечение сдвигает голову на следующий узел, и тот
+// становится новым фиктивным. Снятые с головы узлы освобождаются через
+// HazardPointers, поэтому поток никогда не читает освобождённую память.
+//
+// push_back и try_pop_front можно вызывать из любого числа потоков
+// одновременно; конструкторы, деструктор и перемещение — нет. Счётчика
+// элементов нет намеренно: общий атомарный счётчик стал бы точкой конкуренции
+// для всех потоков сразу.
+template<typename T>
+class ConcurrentQueue {
+    // Значение забирается из узла после того, как узел стал головой, —
+    // бросающее перемещение потеряло бы уже извлечённый элемент
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+                  "ConcurrentQueue needs a nothrow move constructible element type");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    ConcurrentQueue() {
+        Node* dummy = new Node;
+        head_.store(dummy, std::memory_order_relaxed);
+        tail_.store(dummy, std::memory_order_relaxed);
+    }
+
+    ConcurrentQueue(const ConcurrentQueue&) = delete;
+    ConcurrentQueue& operator=(const ConcurrentQueue&) = delete;
+
+    ~ConcurrentQueue() {
+        Node* node = head_.load(std::memory_order_relaxed);
+        // Фиктивная голова значения не хранит
+        Node* next = node->next.load(std::memory_order_relaxed);
+        delete node;
+        for (node = next; node; node = next) {
+            next = node->next.load(std::memory_order_relaxed);
+            node->value()->~T();
+            delete node;
+        }
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template<typename... Args>
+    void emplace_back(Args&&... args) {
+        Node* node = new Node;
+        try {
+            ::new (static_cast<void*>(node->storage)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            delete node;
+            throw;
+        }
+        HazardPointers::Guard guard;
+        for (;;) {
+            Node* tail = guard.protect(0, tail_);
+            Node* next = tail->next.load();
+            if (tail != tail_.load()) continue;
+            if (next) {
+                // Хвост отстал: помогаем другому производителю его сдвинуть
+                tail_.compare_exchange_weak(tail, next);
+                continue;
+            }
+            if (tail->next.compare_exchange_weak(next, node)) {
+                tail_.compare_exchange_strong(tail, node);
+                break;
+            }
+        }
+    }
+
+    // Извлекает первый элемент; пустой optional, если очередь пуста
+    std::optional<T> try_pop_front() {
+        HazardPointers::Guard guard;
+        for (;;) {
+            Node* head = guard.protect(0, head_);
+            Node* tail = tail_.load();
+            Node* next = head->next.load();
+            guard.set(1, next);
+            // Голова не сменилась — значит, next ещё в очереди и защищён
+            if (head != head_.load()) continue;
+            if (!next) return std::nullopt;
+            if (head == tail) {
+                tail_.compare_exchange_weak(tail, next);
+                continue;
+            }
+            if (head_.compare_exchange_strong(head, next)) {
+                // Значение next принадлежит только победителю CAS
+                std::optional<T> result(std::move(*next->value()));
+                next->value()->~T();
+                guard.clear(0);
+                guard.clear(1);
+                guard.retire(head, &ConcurrentQueue::delete_node);
+                return result;
+            }
+        }
+    }
+
+    bool empty() const {
+        HazardPointers::Guard guard;
+        return guard.protect(0, head_)->next.load() == nullptr;
+    }
+
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    static void delete_node(void* node) {
+        delete static_cast<Node*>(node);
+    }
+
+    // Голова и хвост на разных кэш-линиях: производители и потребители не мешают друг другу
+    alignas(64) std::atomic<Node*> head_;
+    alignas(64) std::atomic<Node*> tail_;
+};
+
+#endif // CONCURRENT_QUEUE_H
@@ -0,0 +1,367 @@
+#ifndef CONCURRENT_VECTOR_H
+#define CONCURRENT_VECTOR_H
+
+#include "checkPolicy.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Вектор с одновременным добавлением из многих потоков (в духе
+// tbb::concurrent_vector). Память — сегменты удваивающегося размера:
+// сегмент k вмещает kFirstSegment << k элементов и после выделения
+// не переезжает, поэтому рост не двигает уже добавленные элементы и ссылки
+// на них остаются действительными.
+//
+// push_back резервирует номер атомарным счётчиком, создаёт элемент и отмечает
+// его готовым. size() и snapshot() видят только префикс готовых элементов:
+// читатель никогда не встретит недостроенный элемент и не ждёт писателей.
+// Элементы не удаляются и не переставляются до clear(), поэтому снимок
+// остаётся верным, пока вектор жив.
+//
+// push_back, emplace_back, grow_by, size, snapshot и чтение готовых элементов
+// можно вызывать из любых потоков одновременно; clear, перемещение и
+// деструктор — только без конкурентных операций.
+template<typename T>
+class ConcurrentVector {
+    // Элемент создаётся до резервирования номера и затем перемещается в слот:
+    // бросающее перемещение оставило бы в векторе дыру
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+                  "ConcurrentVector needs a nothrow move constructible element type");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+    // Ёмкость нулевого сегмента; кратна 64, чтобы флаги готовности лежали целыми словами
+    static constexpr size_type kFirstSegment = 64;
+
+    class Snapshot;
+
+    ConcurrentVector() = default;
+
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    ConcurrentVector(ConcurrentVector&& other) noexcept {
+        steal(other);
+    }
+
+    ConcurrentVector& operator=(ConcurrentVector&& other) noexcept {
+        if (this != &other) {
+            release();
+            steal(other);
+        }
+        return *this;
+    }
+
+    ~ConcurrentVector() {
+        release();
+    }
+
+    // Номер добавленного элемента
+    size_type push_back(const T& value) { return emplace_back(value); }
+    size_type push_back(T&& value) { return emplace_back(std::move(value)); }
+
+    template<typename... Args>
+    size_type emplace_back(Args&&... args) {
+        T value(std::forward<Args>(args)...);
+        const size_type idx = reserve_slots(1);
+        ::new (static_cast<void*>(locate(idx))) T(std::move(value));
+        mark_ready(idx);
+        return idx;
+    }
+
+    // Добавляет count копий value одним резервированием; номер первой.
+    // Копии создаются заранее: бросившее копирование после резервирования
+    // оставило бы в векторе дыру, и size() больше никогда бы не вырос
+    template<typename U>
+    size_type grow_by(size_type count, const U& value) {
+        if (count == 0) return reserved_.load(std::memory_order_relaxed);
+        std::vector<T> copies;
+        copies.reserve(count);
+        for (size_type i = 0; i < count; ++i) copies.emplace_back(value);
+        const size_type first = reserve_slots(count);
+        for (size_type i = 0; i < count; ++i) {
+            ::new (static_cast<void*>(locate(first + i))) T(std::move(copies[i]));
+            mark_ready(first + i);
+        }
+        return first;
+    }
+
+    // Число готовых элементов: все с меньшими номерами уже созданы
+    size_type size() const noexcept { return published_.load(std::memory_order_acquire); }
+    bool empty() const noexcept { return size() == 0; }
+
+    reference operator[](size_type idx) noexcept { return *locate(idx); }
+    const_reference operator[](size_type idx) const noexcept { return *locate(idx); }
+
+    reference at(size_type idx) {
+        check_index(idx);
+        return *locate(idx);
+    }
+
+    const_reference at(size_type idx) const {
+        check_index(idx);
+        return *locate(idx);
+    }
+
+    // Согласованный срез [0, size()) на момент вызова
+    Snapshot snapshot() const noexcept { return Snapshot(this, size()); }
+
+    // Уничтожает элементы и освобождает сегменты; без конкурентных операций
+    void clear() noexcept {
+        release();
+    }
+
+    class Snapshot {
+    public:
+        class Iterator {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            Iterator() noexcept : owner_(nullptr), idx_(0) {}
+            Iterator(const ConcurrentVector* owner, size_type idx) noexcept : owner_(owner), idx_(idx) {}
+
+            reference operator*() const noexcept { return (*owner_)[idx_]; }
+            pointer operator->() const noexcept { return &(*owner_)[idx_]; }
+            reference operator[](difference_type n) const noexcept { return (*owner_)[idx_ + n]; }
+
+            Iterator& operator++() noexcept { ++idx_; return *this; }
+            Iterator operator++(int) noexcept { Iterator tmp = *this; ++idx_; return tmp; }
+            Iterator& operator--() noexcept { --idx_; return *this; }
+            Iterator operator--(int) noexcept { Iterator tmp = *this; --idx_; return tmp; }
+
+            Iterator& operator+=(difference_type n) noexcept { idx_ += n; return *this; }
+            Iterator& operator-=(difference_type n) noexcept { idx_ -= n; return *this; }
+            Iterator operator+(difference_type n) const noexcept { return Iterator(owner_, idx_ + n); }
+            Iterator operator-(difference_type n) const noexcept { return Iterator(owner_, idx_ - n); }
+            friend Iterator operator+(difference_type n, const Iterator& it) noexcept { return it + n; }
+            difference_type operator-(const Iterator& other) const noexcept {
+                return static_cast<difference_type>(idx_) - static_cast<difference_type>(other.idx_);
+            }
+
+            bool operator==(const Iterator& other) const noexcept { return idx_ == other.idx_; }
+            bool operator!=(const Iterator& other) const noexcept { return idx_ != other.idx_; }
+            bool operator<(const Iterator& other) const noexcept { return idx_ < other.idx_; }
+            bool operator>(const Iterator& other) const noexcept { return idx_ > other.idx_; }
+            bool operator<=(const Iterator& other) const noexcept { return idx_ <= other.idx_; }
+            bool operator>=(const Iterator& other) const noexcept { return idx_ >= other.idx_; }
+
+        private:
+            const ConcurrentVector* owner_;
+            size_type idx_;
+        };
+
+        using iterator = Iterator;
+        using const_iterator = Iterator;
+
+        Snapshot() noexcept : owner_(nullptr), size_(0) {}
+
+        size_type size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+
+        const_reference operator[](size_type idx) const noexcept { return (*owner_)[idx]; }
+
+        const_reference at(size_type idx) const {
+            if (LAB3_UNLIKELY(idx >= size_)) throw std::out_of_range("Index out of range");
+            return (*owner_)[idx];
+        }
+
+        Iterator begin() const noexcept { return Iterator(owner_, 0); }
+        Iterator end() const noexcept { return Iterator(owner_, size_); }
+
+        // f(data, count) для каждого непрерывного куска снимка — обход без
+        // пересчёта сегмента на каждом элементе
+        template<typename F>
+        void for_each_segment(F f) const {
+            for (size_type k = 0, start = 0; start < size_; ++k) {
+                const size_type count = std::min(segment_capacity(k), size_ - start);
+                f(static_cast<const T*>(owner_->segment_data(k)), count);
+                start += count;
+            }
+        }
+
+    private:
+        const ConcurrentVector* owner_;
+        size_type size_;
+
+        Snapshot(const ConcurrentVector* owner, size_type size) noexcept : owner_(owner), size_(size) {}
+
+        friend class ConcurrentVector;
+    };
+
+private:
+    using Word = std::uint64_t;
+    static constexpr size_type kWordBits = 64;
+    static_assert(kFirstSegment % kWordBits == 0, "first segment must hold whole ready words");
+
+    // Сегментов хватает, чтобы суммарная ёмкость покрыла весь size_type
+    static constexpr size_type kSegments = 64 - 6;
+
+    // Сегмент: флаги готовности, затем элементы
+    static constexpr size_type kDataAlign = alignof(T) > alignof(Word) ? alignof(T) : alignof(Word);
+
+    std::atomic<unsigned char*> segments_[kSegments] = {};
+    alignas(64) std::atomic<size_type> reserved_{0};
+    alignas(64) std::atomic<size_type> published_{0};
+
+    static constexpr size_type segment_capacity(size_type k) noexcept { return kFirstSegment << k; }
+    static constexpr size_type segment_start(size_type k) noexcept {
+        return kFirstSegment * ((size_type(1) << k) - 1);
+    }
+
+    static constexpr size_type words_offset() noexcept { return 0; }
+    static constexpr size_type data_offset(size_type k) noexcept {
+        const size_type words = segment_capacity(k) / kWordBits * sizeof(Word);
+        return (words + kDataAlign - 1) / kDataAlign * kDataAlign;
+    }
+
+    static size_type segment_of(size_type idx) noexcept {
+        size_type q = idx / kFirstSegment + 1;
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_type>(63 - __builtin_clzll(static_cast<unsigned long long>(q)));
+#else
+        size_type k = 0;
+        while (q >>= 1) ++k;
+        return k;
+#endif
+    }
+
+    static void check_limit(size_type k) {
+        if (k >= kSegments) throw std::length_error("ConcurrentVector size limit exceeded");
+    }
+
+    void check_index(size_type idx) const {
+        if (LAB3_UNLIKELY(idx >= size())) throw std::out_of_range("Index out of range");
+    }
+
+    const void* segment_data(size_type k) const noexcept {
+        return segments_[k].load(std::memory_order_acquire) + data_offset(k);
+    }
+
+    std::atomic<Word>* ready_words(unsigned char* segment) const noexcept {
+        return reinterpret_cast<std::atomic<Word>*>(segment + words_offset());
+    }
+
+    T* locate(size_type idx) const noexcept {
+        const size_type k = segment_of(idx);
+        unsigned char* segment = segments_[k].load(std::memory_order_acquire);
+        return std::launder(reinterpret_cast<T*>(segment + data_offset(k))) + (idx - segment_start(k));
+    }
+
+    // Сегмент выделяет первый, кому он понадобился; проигравший гонку освобождает свой
+    unsigned char* ensure_segment(size_type k) {
+        check_limit(k);
+        unsigned char* segment = segments_[k].load(std::memory_order_acquire);
+        if (segment) return segment;
+        const size_type bytes = data_offset(k) + segment_capacity(k) * sizeof(T);
+        unsigned char* fresh = static_cast<unsigned char*>(
+            ::operator new(bytes, std::align_val_t(kDataAlign)));
+        const size_type words = segment_capacity(k) / kWordBits;
+        for (size_type w = 0; w < words; ++w) {
+            ::new (static_cast<void*>(fresh + words_offset() + w * sizeof(Word))) std::atomic<Word>(0);
+        }
+        if (segments_[k].compare_exchange_strong(segment, fresh, std::memory_order_acq_rel)) {
+            return fresh;
+        }
+        ::operator delete(fresh, std::align_val_t(kDataAlign));
+        return segment;
+    }
+
+    // Резервирует count номеров подряд. Сегменты под них выделяются до
+    // резервирования: после него ничего не бросает, и каждый занятый номер
+    // будет заполнен. Проигравший гонку за номера пробует со следующих
+    size_type reserve_slots(size_type count) {
+        size_type first = reserved_.load(std::memory_order_relaxed);
+        for (;;) {
+            if (LAB3_UNLIKELY(count > std::numeric_limits<size_type>::max() - first)) check_limit(kSegments);
+            const size_type last = segment_of(first + count - 1);
+            for (size_type k = segment_of(first); k <= last; ++k) ensure_segment(k);
+            if (reserved_.compare_exchange_weak(first, first + count, std::memory_order_relaxed)) return first;
+        }
+    }
+
+    bool is_ready(size_type idx) const noexcept {
+        const size_type k = segment_of(idx);
+        unsigned char* segment = segments_[k].load(std::memory_order_acquire);
+        if (!segment) return false;
+        const size_type offset = idx - segment_start(k);
+        return (ready_words(segment)[offset / kWordBits].load() >> (offset % kWordBits)) & 1;
+    }
+
+    // Отмечает элемент готовым и продвигает published_ по сплошному префиксу
+    // готовых. Писатель не ждёт отставших: префикс за ним продвинет тот, кто
+    // допишет последний недостающий элемент.
+    //
+    // Все операции последовательно согласованы: кто сдвинул published_ до idx,
+    // после этого проверит флаг idx и увидит его, а кто поставил флаг раньше
+    // этого сдвига, прочитает published_ < idx только до него
+    void mark_ready(size_type idx) noexcept {
+        size_type published = published_.load();
+        // Без отставших писателей элемент сразу публикуется, флаг не нужен:
+        // его номер больше никто не проверит
+        if (published == idx && published_.compare_exchange_strong(published, idx + 1)) {
+            published = idx + 1;
+        } else {
+            const size_type k = segment_of(idx);
+            unsigned char* segment = segments_[k].load(std::memory_order_acquire);
+            const size_type offset = idx - segment_start(k);
+            ready_words(segment)[offset / kWordBits].fetch_or(Word(1) << (offset % kWordBits));
+            published = published_.load();
+        }
+        while (is_ready(published)) {
+            // Неудачный CAS сам обновляет published — проверяем новую границу
+            if (published_.compare_exchange_weak(published, published + 1)) ++published;
+        }
+    }
+
+    // Уничтожаются только созданные элементы: опубликованный префикс и
+    // готовые за ним (флаг ставится, только если элемент не опубликован сразу)
+    void release() noexcept {
+        const size_type published = published_.load(std::memory_order_relaxed);
+        const size_type reserved = reserved_.load(std::memory_order_relaxed);
+        for (size_type k = 0; k < kSegments; ++k) {
+            unsigned char* segment = segments_[k].load(std::memory_order_relaxed);
+            if (!segment) continue;
+            const size_type start = segment_start(k);
+            if (!std::is_trivially_destructible_v<T> && start < reserved) {
+                T* data = std::launder(reinterpret_cast<T*>(segment + data_offset(k)));
+                const size_type live = std::min(segment_capacity(k), reserved - start);
+                for (size_type i = 0; i < live; ++i) {
+                    if (start + i < published || is_ready(start + i)) data[i].~T();
+                }
+            }
+            ::operator delete(segment, std::align_val_t(kDataAlign));
+            segments_[k].store(nullptr, std::memory_order_relaxed);
+        }
+        reserved_.store(0, std::memory_order_relaxed);
+        published_.store(0, std::memory_order_relaxed);
+    }
+
+    void steal(ConcurrentVector& other) noexcept {
+        for (size_type k = 0; k < kSegments; ++k) {
+            segments_[k].store(other.segments_[k].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            other.segments_[k].store(nullptr, std::memory_order_relaxed);
+        }
+        reserved_.store(other.reserved_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        published_.store(other.published_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other.reserved_.store(0, std::memory_order_relaxed);
+        other.published_.store(0, std::memory_order_relaxed);
+    }
+};
+
+#endif // CONCURRENT_VECTOR_H
@@ -0,0 +1,191 @@
+#ifndef CONTAINER_STATS_H
+#define CONTAINER_STATS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <ostream>
+
+// Счётчики горячих путей контейнеров: переаллокации, перенесённые байты,
+// сдвиги элементов при вставке и удалении, выделения узлов, длина прохода
+// по номеру и наибольшая ёмкость.
+//
+// Счётчики включаются при сборке макросом LAB3_STATS (опция CMake LAB3_STATS).
+// Без него StatsCounter — пустая основа контейнера: размер объектов не меняется,
+// вызовы счётчиков пусты и исчезают при встраивании, а stats() возвращает нули.
+//
+// Каждый контейнер считает свои события (stats()), и те же события
+// суммируются в сводку текущего потока (thread_stats()) — она показывает
+// картину по всем контейнерам сразу, без доступа к отдельным объектам.
+//
+// Отчёт о расходе памяти (MemoryUsage, memory_usage() контейнеров) от
+// LAB3_STATS не зависит: он вычисляется по состоянию контейнера на месте.
+#ifdef LAB3_STATS
+inline constexpr bool stats_enabled = true;
+#else
+inline constexpr bool stats_enabled = false;
+#endif
+
+struct ContainerStats {
+    std::uint64_t reallocations = 0;      // смены буфера вектора
+    std::uint64_t bytes_moved = 0;        // байт скопировано при смене буфера
+    std::uint64_t elements_shifted = 0;   // элементов сдвинуто вставками и удалениями
+    std::uint64_t node_allocations = 0;   // выделено узлов (блоков) списков
+    std::uint64_t walks = 0;              // поисков узла по номеру
+    std::uint64_t walk_steps = 0;         // переходов по узлам в этих поисках
+    std::uint64_t peak_capacity = 0;      // наибольшая ёмкость вектора в элементах
+
+    // Средняя длина прохода по номеру в переходах
+    double average_walk() const noexcept {
+        return walks == 0 ? 0.0 : static_cast<double>(walk_steps) / static_cast<double>(walks);
+    }
+
+    ContainerStats& operator+=(const ContainerStats& other) noexcept {
+        reallocations += other.reallocations;
+        bytes_moved += other.bytes_moved;
+        elements_shifted += other.elements_shifted;
+        node_allocations += other.node_allocations;
+        walks += other.walks;
+        walk_steps += other.walk_steps;
+        peak_capacity = std::max(peak_capacity, other.peak_capacity);
+        return *this;
+    }
+
+    void reset() noexcept { *this = ContainerStats{}; }
+
+    // Строка «имя: значение» на каждый счётчик
+    void print_text(std::ostream& os) const {
+        os << "reallocations: " << reallocations << '\n'
+           << "bytes_moved: " << bytes_moved << '\n'
+           << "elements_shifted: " << elements_shifted << '\n'
+           << "node_allocations: " << node_allocations << '\n'
+           << "walks: " << walks << '\n'
+           << "average_walk: " << average_walk() << '\n'
+           << "peak_capacity: " << peak_capacity << '\n';
+    }
+
+    // Один JSON-объект в строку
+    void print_json(std::ostream& os) const {
+        os << "{\"reallocations\":" << reallocations
+           << ",\"bytes_moved\":" << bytes_moved
+           << ",\"elements_shifted\":" << elements_shifted
+           << ",\"node_allocations\":" << node_allocations
+           << ",\"walks\":" << walks
+           << ",\"walk_steps\":" << walk_steps
+           << ",\"average_walk\":" << average_walk()
+           << ",\"peak_capacity\":" << peak_capacity << '}';
+    }
+};
+
+// Память под элементы контейнера: used — байты самих элементов, reserved —
+// всё, что контейнер держит ради них: буфер вектора целиком, узлы списков
+// со ссылками и заголовками, позиционный индекс. Объект контейнера не входит
+struct MemoryUsage {
+    std::size_t used = 0;
+    std::size_t reserved = 0;
+
+    // Запас ёмкости и служебные данные узлов
+    std::size_t overhead() const noexcept { return reserved - used; }
+
+    MemoryUsage& operator+=(const MemoryUsage& other) noexcept {
+        used += other.used;
+        reserved += other.reserved;
+        return *this;
+    }
+
+    void print_text(std::ostream& os) const {
+        os << "used: " << used << '\n'
+           << "reserved: " << reserved << '\n'
+           << "overhead: " << overhead() << '\n';
+    }
+
+    void print_json(std::ostream& os) const {
+        os << "{\"used\":" << used << ",\"reserved\":" << reserved
+           << ",\"overhead\":" << overhead() << '}';
+    }
+};
+
+// Сводка по всем контейнерам текущего потока; без LAB3_STATS всегда нулевая
+inline ContainerStats& thread_stats() noexcept {
+    thread_local ContainerStats stats;
+    return stats;
+}
+
+template<bool Enabled = stats_enabled>
+class StatsCounter;
+
+// Счётчики включены: у каждого контейнера свои, копия начинает с нуля
+template<>
+class StatsCounter<true> {
+public:
+    const ContainerStats& stats() const noexcept { return stats_; }
+    void reset_stats() noexcept { stats_.reset(); }
+
+protected:
+    StatsCounter() noexcept = default;
+    StatsCounter(const StatsCounter&) noexcept {}
+    StatsCounter& operator=(const StatsCounter&) noexcept { return *this; }
+    ~StatsCounter() = default;
+
+    // Смена буфера: bytes_moved байт скопировано, новая ёмкость capacity
+    void stats_reallocation(std::size_t capacity, std::size_t bytes_moved) const noexcept {
+        for (ContainerStats* s : {&stats_, &thread_stats()}) {
+            ++s->reallocations;
+            s->bytes_moved += bytes_moved;
+            s->peak_capacity = std::max<std::uint64_t>(s->peak_capacity, capacity);
+        }
+    }
+
+    // Буфер получен без переаллокации (конструктор, перенос из другого вектора)
+    void stats_capacity(std::size_t capacity) const noexcept {
+        for (ContainerStats* s : {&stats_, &thread_stats()}) {
+            s->peak_capacity = std::max<std::uint64_t>(s->peak_capacity, capacity);
+        }
+    }
+
+    void stats_shift(std::size_t count) const noexcept {
+        stats_.elements_shifted += count;
+        thread_stats().elements_shifted += count;
+    }
+
+    void stats_node_allocation() const noexcept {
+        ++stats_.node_allocations;
+        ++thread_stats().node_allocations;
+    }
+
+    // Поиск по номеру, прошедший steps узлов
+    void stats_walk(std::size_t steps) const noexcept {
+        for (ContainerStats* s : {&stats_, &thread_stats()}) {
+            ++s->walks;
+            s->walk_steps += steps;
+        }
+    }
+
+private:
+    // Меняется и в const-методах (поиск по номеру)
+    mutable ContainerStats stats_;
+};
+
+// Счётчики выключены: пустая основа, все вызовы ничего не делают
+template<>
+class StatsCounter<false> {
+public:
+    const ContainerStats& stats() const noexcept {
+        static const ContainerStats empty;
+        return empty;
+    }
+    void reset_stats() noexcept {}
+
+protected:
+    StatsCounter() noexcept = default;
+    ~StatsCounter() = default;
+
+    void stats_reallocation(std::size_t, std::size_t) const noexcept {}
+    void stats_capacity(std::size_t) const noexcept {}
+    void stats_shift(std::size_t) const noexcept {}
+    void stats_node_allocation() const noexcept {}
+    void stats_walk(std::size_t) const noexcept {}
+};
+
+#endif // CONTAINER_STATS_H
@@ -0,0 +1,31 @@
+#ifndef CONTAINER_TRAITS_H
+#define CONTAINER_TRAITS_H
+
+#include <iterator>
+#include <type_traits>
+
+// Тип можно переместить в новую память побайтовым копированием,
+// не вызывая конструктор перемещения и деструктор исходного объекта.
+// Для тривиально копируемых типов это верно всегда; остальные типы
+// могут подключиться явной специализацией, например:
+//
+//     template<> struct is_trivially_relocatable<MyHandle> : std::true_type {};
+template<typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template<typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// Отличает итераторы от целых чисел в перегрузках вида insert(pos, first, last)
+// и insert(pos, count, value)
+template<typename It, typename = void>
+struct is_iterator : std::false_type {};
+
+template<typename It>
+struct is_iterator<It, std::void_t<typename std::iterator_traits<It>::iterator_category>>
+    : std::true_type {};
+
+template<typename It>
+inline constexpr bool is_iterator_v = is_iterator<It>::value;
+
+#endif // CONTAINER_TRAITS_H
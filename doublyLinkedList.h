@@ -1,32 +1,49 @@
 #ifndef DOUBLY_LINKED_LIST_H
 #define DOUBLY_LINKED_LIST_H
 
-#include "baseContainer.h"
+#include "staticContainer.h"
+#include "binaryIO.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <utility>
 #include <stdexcept>
 #include <initializer_list>
+#include <iostream>
 #include <iterator>
+#include <type_traits>
+#include <vector>
+#include "nodePool.h"
+#include "positionalIndex.h"
+
+template<typename T, typename Allocator = std::allocator<T>>
+class DoublyLinkedList : public StaticContainer<DoublyLinkedList<T, Allocator>, T> {
+    using Interface = StaticContainer<DoublyLinkedList<T, Allocator>, T>;
 
-template<typename T>
-class DoublyLinkedList : public BaseContainer<T> {
 private:
     struct Node {
         T data;
-        std::unique_ptr<Node> next;
+        Node* next;
         Node* prev;
         
-        Node(const T& v, Node* p = nullptr) : data(v), next(nullptr), prev(p) {}
-        Node(T&& v, Node* p = nullptr) : data(std::move(v)), next(nullptr), prev(p) {}
+        template<typename... Args>
+        explicit Node(Node* p, Node* n, Args&&... args)
+            : data(std::forward<Args>(args)...), next(n), prev(p) {}
     };
     
-public:
-    using value_type = typename BaseContainer<T>::value_type;
-    using size_type = typename BaseContainer<T>::size_type;
-    using reference = typename BaseContainer<T>::reference;
-    using const_reference = typename BaseContainer<T>::const_reference;
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
     
-    // Bidirectional Iterator
+public:
+    using value_type = typename Interface::value_type;
+    using size_type = typename Interface::size_type;
+    using reference = typename Interface::reference;
+    using const_reference = typename Interface::const_reference;
+    using allocator_type = Allocator;
+    
+    // Bidirectional Iterator. Итератор помнит свой список: у end() узла нет,
+    // и шаг назад от него ведёт на хвост списка
     class Iterator {
     public:
         using iterator_category = std::bidirectional_iterator_tag;
@@ -35,31 +52,31 @@ public:
         using pointer = T*;
         using reference = T&;
         
-        Iterator() noexcept : node_(nullptr) {}
-        explicit Iterator(Node* node) noexcept : node_(node) {}
+        Iterator() noexcept : node_(nullptr), list_(nullptr) {}
+        Iterator(Node* node, const DoublyLinkedList* list) noexcept : node_(node), list_(list) {}
         
         reference operator*() const { return node_->data; }
         pointer operator->() const { return &node_->data; }
         
         Iterator& operator++() {
-            node_ = node_->next.get();
+            node_ = node_->next;
             return *this;
         }
         
         Iterator operator++(int) {
             Iterator temp = *this;
-            node_ = node_->next.get();
+            node_ = node_->next;
             return temp;
         }
         
         Iterator& operator--() {
-            node_ = node_ ? node_->prev : nullptr;
+            node_ = node_ ? node_->prev : list_->tail_;
             return *this;
         }
         
         Iterator operator--(int) {
             Iterator temp = *this;
-            node_ = node_ ? node_->prev : nullptr;
+            --*this;
             return temp;
         }
         
@@ -68,6 +85,10 @@ public:
         
     private:
         Node* node_;
+        const DoublyLinkedList* list_;
+        
+        friend class ConstIterator;
+        friend class DoublyLinkedList;
     };
     
     class ConstIterator {
@@ -78,32 +99,32 @@ public:
         using pointer = const T*;
         using reference = const T&;
         
-        ConstIterator() noexcept : node_(nullptr) {}
-        explicit ConstIterator(Node* node) noexcept : node_(node) {}
-        ConstIterator(const Iterator& it) noexcept : node_(it.node_) {}
+        ConstIterator() noexcept : node_(nullptr), list_(nullptr) {}
+        ConstIterator(Node* node, const DoublyLinkedList* list) noexcept : node_(node), list_(list) {}
+        ConstIterator(const Iterator& it) noexcept : node_(it.node_), list_(it.list_) {}
         
         reference operator*() const { return node_->data; }
         pointer operator->() const { return &node_->data; }
         
         ConstIterator& operator++() {
-            node_ = node_->next.get();
+            node_ = node_->next;
             return *this;
         }
         
         ConstIterator operator++(int) {
             ConstIterator temp = *this;
-            node_ = node_->next.get();
+            node_ = node_->next;
             return temp;
         }
         
         ConstIterator& operator--() {
-            node_ = node_ ? node_->prev : nullptr;
+            node_ = node_ ? node_->prev : list_->tail_;
             return *this;
         }
         
         ConstIterator operator--(int) {
             ConstIterator temp = *this;
-            node_ = node_ ? node_->prev : nullptr;
+            --*this;
             return temp;
         }
         
@@ -112,6 +133,9 @@ public:
         
     private:
         Node* node_;
+        const DoublyLinkedList* list_;
+        
+        friend class DoublyLinkedList;
     };
     
     using iterator = Iterator;
@@ -119,31 +143,89 @@ public:
     using reverse_iterator = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
     
+    // Курсор для последовательной правки списка: помнит узел и его номер,
+    // поэтому вставка и удаление в позиции курсора и шаг к соседу — O(1).
+    // Правки через сам курсор его не портят; после любых других вставок
+    // и удалений в списке курсор нужно получить заново
+    class Cursor {
+    public:
+        // Курсор стоит на элементе (а не за последним)
+        bool valid() const noexcept { return node_ != nullptr; }
+        size_type index() const noexcept { return index_; }
+        
+        reference operator*() const { return node_->data; }
+        T* operator->() const { return &node_->data; }
+        
+        Cursor& operator++() {
+            node_ = node_->next;
+            ++index_;
+            return *this;
+        }
+        
+        // С позиции за последним элементом шаг назад ведёт на хвост
+        Cursor& operator--() {
+            node_ = node_ ? node_->prev : list_->tail_;
+            --index_;
+            return *this;
+        }
+        
+        // Вставка перед текущим элементом; курсор остаётся на нём же
+        void insert(const T& value) {
+            list_->emplace_before(index_, node_, value);
+            ++index_;
+        }
+        
+        void insert(T&& value) {
+            list_->emplace_before(index_, node_, std::move(value));
+            ++index_;
+        }
+        
+        // Удаление текущего элемента; курсор переходит на следующий
+        void erase() {
+            node_ = list_->erase_node(index_, node_);
+        }
+        
+    private:
+        friend class DoublyLinkedList;
+        
+        Cursor(DoublyLinkedList* list, Node* node, size_type index) noexcept
+            : list_(list), node_(node), index_(index) {}
+        
+        DoublyLinkedList* list_;
+        Node* node_;
+        size_type index_;
+    };
+    
     DoublyLinkedList() = default;
     
-    DoublyLinkedList(std::initializer_list<T> init) {
+    explicit DoublyLinkedList(const Allocator& alloc) : alloc_(alloc) {}
+    
+    DoublyLinkedList(std::initializer_list<T> init, const Allocator& alloc = Allocator())
+        : alloc_(alloc) {
         for (const auto& item : init) {
             push_back(item);
         }
     }
     
     // Конструктор копирования
-    DoublyLinkedList(const DoublyLinkedList& other) {
-        Node* current = other.head_.get();
+    DoublyLinkedList(const DoublyLinkedList& other)
+        : alloc_(NodeTraits::select_on_container_copy_construction(other.alloc_)) {
+        Node* current = other.head_;
         while (current) {
             push_back(current->data);
-            current = current->next.get();
+            current = current->next;
         }
+        if (other.index_enabled()) enable_index();
     }
     
     // Конструктор перемещения
     DoublyLinkedList(DoublyLinkedList&& other) noexcept
-        : head_(std::move(other.head_)), tail_(other.tail_), size_(other.size_) {
-        if (head_) {
-            head_->prev = nullptr;
-        }
+        : alloc_(other.alloc_), head_(other.head_), tail_(other.tail_), size_(other.size_) {
+        other.head_ = nullptr;
         other.tail_ = nullptr;
         other.size_ = 0;
+        index_.swap(other.index_);
+        std::swap(finger_, other.finger_);
     }
     
     // Оператор присваивания копированием
@@ -156,63 +238,83 @@ public:
     }
     
     // Оператор присваивания перемещением
-    DoublyLinkedList& operator=(DoublyLinkedList&& other) noexcept {
+    DoublyLinkedList& operator=(DoublyLinkedList&& other)
+        noexcept(NodeTraits::propagate_on_container_move_assignment::value ||
+                 NodeTraits::is_always_equal::value) {
         if (this != &other) {
             clear();
-            head_ = std::move(other.head_);
+            if (NodeTraits::propagate_on_container_move_assignment::value) {
+                alloc_ = other.alloc_;
+            } else if (alloc_ != other.alloc_) {
+                // Узлы чужого пула забрать нельзя — переносим элементы
+                for (Node* current = other.head_; current; current = current->next) {
+                    push_back(std::move(current->data));
+                }
+                other.clear();
+                return *this;
+            }
+            head_ = other.head_;
             tail_ = other.tail_;
             size_ = other.size_;
+            index_.swap(other.index_);
+            finger_ = other.finger_;
             
-            if (head_) {
-                head_->prev = nullptr;
-            }
+            other.head_ = nullptr;
             other.tail_ = nullptr;
             other.size_ = 0;
+            other.index_.disable();
+            other.finger_ = Finger{};
         }
         return *this;
     }
     
-    ~DoublyLinkedList() = default;
-    
-    // Реализация методов BaseContainer
-    size_type size() const noexcept override { return size_; }
-    bool empty() const noexcept override { return size_ == 0; }
-    
-    void clear() override {
-        while (head_) {
-            head_ = std::move(head_->next);
-        }
-        tail_ = nullptr;
-        size_ = 0;
+    ~DoublyLinkedList() {
+        clear();
     }
     
-    void push_back(const T& value) override {
-        auto new_node = std::make_unique<Node>(value, tail_);
-        Node* raw_ptr = new_node.get();
+    // Интерфейс последовательного контейнера (is_sequence_container)
+    size_type size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    
+    void clear() {
+        // Пул, которым владеет только этот список, освобождается slab'ами целиком:
+        // узлы не возвращаются в free list по одному, а при тривиально
+        // разрушаемых элементах цепочка не обходится вовсе
+        if constexpr (supports_bulk_release<NodeAllocator>::value) {
+            if (alloc_.sole_owner()) {
+                if constexpr (!std::is_trivially_destructible_v<T>) {
+                    Node* current = head_;
+                    while (current) {
+                        Node* next = current->next;
+                        NodeTraits::destroy(alloc_, current);
+                        current = next;
+                    }
+                }
+                alloc_.try_release_all();
+                forget_nodes();
+                return;
+            }
+        }
         
-        if (!head_) {
-            head_ = std::move(new_node);
-        } else {
-            tail_->next = std::move(new_node);
+        // Обход без рекурсии: длина списка не ограничена глубиной стека
+        Node* current = head_;
+        while (current) {
+            Node* next = current->next;
+            destroy_node(current);
+            current = next;
         }
-        tail_ = raw_ptr;
-        ++size_;
+        forget_nodes();
     }
     
-    void push_back(T&& value) override {
-        auto new_node = std::make_unique<Node>(std::move(value), tail_);
-        Node* raw_ptr = new_node.get();
-        
-        if (!head_) {
-            head_ = std::move(new_node);
-        } else {
-            tail_->next = std::move(new_node);
-        }
-        tail_ = raw_ptr;
-        ++size_;
+    void push_back(const T& value) {
+        link_back(create_node(tail_, nullptr, value));
     }
     
-    void insert(size_type pos, const T& value) override {
+    void push_back(T&& value) {
+        link_back(create_node(tail_, nullptr, std::move(value)));
+    }
+    
+    void insert(size_type pos, const T& value) {
         this->check_position(pos, size_);
         
         if (pos == 0) {
@@ -224,7 +326,7 @@ public:
         }
     }
     
-    void insert(size_type pos, T&& value) override {
+    void insert(size_type pos, T&& value) {
         this->check_position(pos, size_);
         
         if (pos == 0) {
@@ -236,71 +338,258 @@ public:
         }
     }
     
-    void erase(size_type pos) override {
+    void erase(size_type pos) {
         this->check_index(pos, size_);
-        
-        if (pos == 0) {
-            erase_front();
-        } else if (pos == size_ - 1) {
-            erase_back();
-        } else {
-            erase_middle(pos);
-        }
+        erase_node(pos, get_node_at(pos));
     }
     
-    reference operator[](size_type idx) override {
+    reference operator[](size_type idx) {
         this->check_index(idx, size_);
         return get_node_at(idx)->data;
     }
     
-    const_reference operator[](size_type idx) const override {
+    // Константный доступ не двигает палец и не перестраивает индекс, поэтому
+    // его можно вызывать из нескольких потоков одновременно (кроме сборки с
+    // LAB3_STATS: счётчики контейнера общие). Неконстантный operator[]
+    // запоминает найденный узел и требует внешней синхронизации
+    const_reference operator[](size_type idx) const {
         this->check_index(idx, size_);
-        return get_node_at(idx)->data;
+        return find_node(idx)->data;
     }
     
-    void print(std::ostream& os = std::cout) const override {
-        Node* current = head_.get();
+    void print(std::ostream& os = std::cout) const {
+        Node* current = head_;
         while (current) {
             os << current->data;
-            current = current->next.get();
+            current = current->next;
             if (current) os << " ";
         }
     }
+
+    // Двоичное сохранение (формат binaryIO.h, общий с SimpleVector).
+    // Тривиально копируемые элементы собираются в буфер и пишутся блоками
+    void save(std::ostream& os) const {
+        binary::write_header<T>(os, size_);
+        binary::write_elements<T>(os, begin(), end());
+    }
+
+    // Заменяет содержимое сохранённым через save любого контейнера с теми же
+    // элементами. Бросает binary::format_error на чужом или обрезанном файле;
+    // при исключении список не меняется
+    void load(std::istream& is) {
+        std::uint64_t remaining = 0;
+        const std::uint64_t count = binary::read_header<T>(is, remaining);
+        DoublyLinkedList loaded(get_allocator());
+        binary::read_elements<T>(is, count, remaining,
+                                 [&loaded](T&& value) { loaded.push_back(std::move(value)); });
+        swap(loaded);
+    }
     
     // Дополнительные методы
     void push_front(const T& value) {
-        auto new_node = std::make_unique<Node>(value, nullptr);
-        if (head_) {
-            new_node->next = std::move(head_);
-            new_node->next->prev = new_node.get();
-        } else {
-            tail_ = new_node.get();
-        }
-        head_ = std::move(new_node);
-        ++size_;
+        emplace_before(0, head_, value);
     }
     
     void push_front(T&& value) {
-        auto new_node = std::make_unique<Node>(std::move(value), nullptr);
-        if (head_) {
-            new_node->next = std::move(head_);
-            new_node->next->prev = new_node.get();
-        } else {
-            tail_ = new_node.get();
+        emplace_before(0, head_, std::move(value));
+    }
+    
+    allocator_type get_allocator() const { return allocator_type(alloc_); }
+    
+    // Заранее выделяет память под count узлов одним блоком, если аллокатор
+    // это умеет (PoolAllocator); с std::allocator ничего не делает
+    void reserve_nodes(size_type count) {
+        if constexpr (supports_reserve<NodeAllocator>::value) alloc_.reserve(count);
+    }
+    
+    // Правки по итератору за O(1): номер позиции не вычисляется, поэтому
+    // включённый позиционный индекс перестроится при следующем обращении по номеру
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        forget_positions();
+        return iterator(emplace_before(0, pos.node_, std::forward<Args>(args)...), this);
+    }
+    
+    iterator insert(const_iterator pos, const T& value) {
+        return emplace(pos, value);
+    }
+    
+    iterator insert(const_iterator pos, T&& value) {
+        return emplace(pos, std::move(value));
+    }
+    
+    // Возвращает итератор на элемент, следовавший за удалённым
+    iterator erase(const_iterator pos) {
+        forget_positions();
+        return iterator(erase_node(0, pos.node_), this);
+    }
+    
+    iterator erase(const_iterator first, const_iterator last) {
+        forget_positions();
+        Node* node = first.node_;
+        while (node != last.node_) {
+            node = erase_node(0, node);
         }
-        head_ = std::move(new_node);
-        ++size_;
+        return iterator(node, this);
+    }
+    
+    // Перенос узлов other (всех, одного или диапазона [first, last)) перед pos
+    // перецеплением, без выделения памяти и копирования. Для подсчёта размера
+    // диапазон проходится один раз. При неравных аллокаторах узлы чужого пула
+    // забрать нельзя, и элементы переносятся перемещением
+    void splice(const_iterator pos, DoublyLinkedList& other) {
+        splice(pos, other, other.begin(), other.end());
+    }
+    
+    void splice(const_iterator pos, DoublyLinkedList&& other) {
+        splice(pos, other);
+    }
+    
+    void splice(const_iterator pos, DoublyLinkedList& other, const_iterator it) {
+        const_iterator next = it;
+        ++next;
+        // Элемент уже стоит перед pos: перецепление к самому себе зациклило бы узел.
+        // В чужом списке pos == next бывает и у разных позиций (оба end())
+        if (&other == this && (pos == it || pos == next)) return;
+        splice(pos, other, it, next);
+    }
+    
+    void splice(const_iterator pos, DoublyLinkedList& other,
+                const_iterator first, const_iterator last) {
+        if (first == last) return;
+        forget_positions();
+        other.forget_positions();
+        if (!same_pool(other)) {
+            Node* node = first.node_;
+            while (node != last.node_) {
+                emplace_before(0, pos.node_, std::move(node->data));
+                node = other.erase_node(0, node);
+            }
+            return;
+        }
+        
+        Node* first_node = first.node_;
+        Node* last_node = last.node_ ? last.node_->prev : other.tail_;
+        size_type count = 0;
+        if (&other != this) {
+            for (Node* node = first_node; node != last.node_; node = node->next) {
+                ++count;
+            }
+        }
+        other.unlink_range(first_node, last_node);
+        other.size_ -= count;
+        link_range_before(pos.node_, first_node, last_node);
+        size_ += count;
+    }
+    
+    // Слияние с отсортированным other (этот список тоже отсортирован) перецеплением
+    // узлов; устойчиво. Если comp бросит исключение, оба списка останутся корректными
+    void merge(DoublyLinkedList& other) {
+        merge(other, std::less<>());
+    }
+    
+    void merge(DoublyLinkedList&& other) {
+        merge(other);
+    }
+    
+    template<typename Compare>
+    void merge(DoublyLinkedList& other, Compare comp) {
+        if (&other == this || other.empty()) return;
+        forget_positions();
+        other.forget_positions();
+        const bool steal = same_pool(other);
+        
+        Node* current = head_;
+        while (other.head_) {
+            Node* node = other.head_;
+            if (current && !comp(node->data, current->data)) {
+                current = current->next;
+                continue;
+            }
+            if (!steal) {
+                emplace_before(0, current, std::move(node->data));
+                other.erase_node(0, node);
+                continue;
+            }
+            // Хвост other целиком встаёт в конец
+            Node* last = current ? node : other.tail_;
+            size_type count = current ? 1 : other.size_;
+            other.unlink_range(node, last);
+            other.size_ -= count;
+            link_range_before(current, node, last);
+            size_ += count;
+        }
+    }
+    
+    // Отрезает [pos, end()) в новый список с тем же аллокатором; O(длины хвоста)
+    DoublyLinkedList split(const_iterator pos) {
+        DoublyLinkedList tail(get_allocator());
+        if (!pos.node_) return tail;
+        forget_positions();
+        size_type count = 0;
+        for (Node* node = pos.node_; node; node = node->next) {
+            ++count;
+        }
+        Node* last = tail_;
+        unlink_range(pos.node_, last);
+        size_ -= count;
+        tail.link_range_before(nullptr, pos.node_, last);
+        tail.size_ = count;
+        return tail;
+    }
+    
+    // Курсор на позиции pos; pos == size() — за последним элементом
+    Cursor cursor(size_type pos = 0) {
+        this->check_position(pos, size_);
+        return Cursor(this, pos == size_ ? nullptr : get_node_at(pos), pos);
+    }
+    
+    // Границы k отрезков почти равной длины для параллельного обхода
+    // (parallel_for_each и др.): k + 1 итератор, последний — end().
+    // С позиционным индексом — O(k log n), иначе один проход по списку.
+    // Границы годятся, пока узлы не вставляются и не удаляются
+    std::vector<iterator> chunk_bounds(size_type k) {
+        std::vector<iterator> bounds;
+        collect_bounds(k, [this, &bounds](Node* node) { bounds.push_back(iterator(node, this)); });
+        return bounds;
+    }
+    
+    std::vector<const_iterator> chunk_bounds(size_type k) const {
+        std::vector<const_iterator> bounds;
+        collect_bounds(k, [this, &bounds](Node* node) { bounds.push_back(const_iterator(node, this)); });
+        return bounds;
+    }
+    
+    // Позиционный индекс: operator[], insert(pos) и erase(pos) за O(log n)
+    // ценой ~24 байт на элемент. Включённый индекс обновляется при каждой
+    // вставке и удалении; построение по текущему списку — O(n)
+    void enable_index() {
+        if (!index_.valid()) {
+            index_.build(head_, size_, [](Node* node) { return node->next; });
+        }
+    }
+    
+    void disable_index() noexcept { index_.disable(); }
+    
+    bool index_enabled() const noexcept { return index_.enabled(); }
+    
+    // Узел целиком (значение и ссылки) плюс позиционный индекс
+    MemoryUsage memory_usage() const noexcept {
+        MemoryUsage usage;
+        usage.used = size_ * sizeof(T);
+        usage.reserved = size_ * sizeof(Node) + index_.memory_bytes();
+        return usage;
     }
     
     // Итераторы
-    iterator begin() noexcept { return iterator(head_.get()); }
-    iterator end() noexcept { return iterator(nullptr); }
+    iterator begin() noexcept { return iterator(head_, this); }
+    iterator end() noexcept { return iterator(nullptr, this); }
     
-    const_iterator begin() const noexcept { return const_iterator(head_.get()); }
-    const_iterator end() const noexcept { return const_iterator(nullptr); }
+    const_iterator begin() const noexcept { return const_iterator(head_, this); }
+    const_iterator end() const noexcept { return const_iterator(nullptr, this); }
     
-    const_iterator cbegin() const noexcept { return const_iterator(head_.get()); }
-    const_iterator cend() const noexcept { return const_iterator(nullptr); }
+    const_iterator cbegin() const noexcept { return const_iterator(head_, this); }
+    const_iterator cend() const noexcept { return const_iterator(nullptr, this); }
     
     reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
     reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
@@ -313,86 +602,261 @@ public:
     
     void swap(DoublyLinkedList& other) noexcept {
         using std::swap;
+        if (NodeTraits::propagate_on_container_swap::value) {
+            swap(alloc_, other.alloc_);
+        }
         swap(head_, other.head_);
         swap(tail_, other.tail_);
         swap(size_, other.size_);
-        
-        // Обновляем указатели prev
-        if (head_) head_->prev = nullptr;
-        if (other.head_) other.head_->prev = nullptr;
+        index_.swap(other.index_);
+        swap(finger_, other.finger_);
     }
     
 private:
-    std::unique_ptr<Node> head_;
+    NodeAllocator alloc_;
+    Node* head_ = nullptr;
     Node* tail_ = nullptr;
     size_type size_ = 0;
+    PositionalIndex<Node*> index_;
+    
+    // Последний найденный по номеру узел: поиск соседних позиций начинается
+    // с него, поэтому проход list[0], list[1], ... занимает O(n) в сумме.
+    // Меняется только неконстантными методами; const-поиск его лишь читает
+    struct Finger {
+        size_type index = 0;
+        Node* node = nullptr;
+    };
+    Finger finger_;
+    
+    // С включённым индексом палец используется только для совсем близких позиций
+    static constexpr size_type FINGER_REACH = 8;
+    
+    template<typename... Args>
+    Node* create_node(Node* prev, Node* next, Args&&... args) {
+        Node* node = NodeTraits::allocate(alloc_, 1);
+        try {
+            NodeTraits::construct(alloc_, node, prev, next, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(alloc_, node, 1);
+            throw;
+        }
+        this->stats_node_allocation();
+        return node;
+    }
     
-    Node* get_node_at(size_type idx) const {
-        if (idx < size_ / 2) {
-            Node* current = head_.get();
-            for (size_type i = 0; i < idx; ++i) {
-                current = current->next.get();
-            }
-            return current;
+    void destroy_node(Node* node) noexcept {
+        NodeTraits::destroy(alloc_, node);
+        NodeTraits::deallocate(alloc_, node, 1);
+    }
+    
+    // Узлы other можно перецепить в этот список
+    bool same_pool(const DoublyLinkedList& other) const noexcept {
+        if constexpr (NodeTraits::is_always_equal::value) {
+            return true;
         } else {
-            Node* current = tail_;
-            for (size_type i = size_ - 1; i > idx; --i) {
-                current = current->prev;
-            }
-            return current;
+            return alloc_ == other.alloc_;
         }
     }
     
-    void insert_middle(size_type pos, const T& value) {
-        Node* current = get_node_at(pos);
-        auto new_node = std::make_unique<Node>(value, current->prev);
-        
-        new_node->next = std::move(current->prev->next);
-        current->prev = new_node.get();
-        new_node->next->prev = new_node.get();
-        new_node->prev->next = std::move(new_node);
-        
+    // Узел попадает в индекс до перецепления: если индексу не хватило памяти,
+    // узел уничтожается и список остаётся прежним
+    void index_insert(size_type pos, Node* node) {
+        if (!index_.valid()) return;
+        try {
+            index_.insert(pos, node);
+        } catch (...) {
+            destroy_node(node);
+            throw;
+        }
+    }
+    
+    void index_erase(size_type pos) noexcept {
+        if (index_.valid()) index_.erase(pos);
+    }
+    
+    // Все узлы уже уничтожены или освобождены вместе с пулом
+    void forget_nodes() noexcept {
+        head_ = nullptr;
+        tail_ = nullptr;
+        size_ = 0;
+        index_.reset();
+        finger_ = Finger{};
+    }
+    
+    // Список меняется без знания номеров позиций: палец сбрасывается,
+    // индекс перестроится при следующем обращении по номеру
+    void forget_positions() noexcept {
+        index_.invalidate();
+        finger_ = Finger{};
+    }
+    
+    // Вырезает цепочку [first, last] из списка; size_ не меняется
+    void unlink_range(Node* first, Node* last) noexcept {
+        if (first->prev) {
+            first->prev->next = last->next;
+        } else {
+            head_ = last->next;
+        }
+        if (last->next) {
+            last->next->prev = first->prev;
+        } else {
+            tail_ = first->prev;
+        }
+    }
+    
+    // Вставляет цепочку [first, last] перед current (nullptr — в конец); size_ не меняется
+    void link_range_before(Node* current, Node* first, Node* last) noexcept {
+        Node* prev = current ? current->prev : tail_;
+        first->prev = prev;
+        last->next = current;
+        if (prev) {
+            prev->next = first;
+        } else {
+            head_ = first;
+        }
+        if (current) {
+            current->prev = last;
+        } else {
+            tail_ = last;
+        }
+    }
+    
+    void link_back(Node* node) {
+        index_insert(size_, node);
+        if (!head_) {
+            head_ = node;
+        } else {
+            tail_->next = node;
+        }
+        tail_ = node;
         ++size_;
     }
     
-    void insert_middle(size_type pos, T&& value) {
-        Node* current = get_node_at(pos);
-        auto new_node = std::make_unique<Node>(std::move(value), current->prev);
-        
-        new_node->next = std::move(current->prev->next);
-        current->prev = new_node.get();
-        new_node->next->prev = new_node.get();
-        new_node->prev->next = std::move(new_node);
-        
+    // Вставка перед current, стоящим на позиции pos (nullptr — в конец)
+    template<typename... Args>
+    Node* emplace_before(size_type pos, Node* current, Args&&... args) {
+        if (!current) {
+            Node* node = create_node(tail_, nullptr, std::forward<Args>(args)...);
+            link_back(node);
+            return node;
+        }
+        Node* node = create_node(current->prev, current, std::forward<Args>(args)...);
+        index_insert(pos, node);
+        if (current->prev) {
+            current->prev->next = node;
+        } else {
+            head_ = node;
+        }
+        current->prev = node;
         ++size_;
+        if (finger_.node && pos <= finger_.index) ++finger_.index;
+        return node;
     }
     
-    void erase_front() {
-        head_ = std::move(head_->next);
-        if (head_) {
-            head_->prev = nullptr;
+    // Удаляет node с позиции pos и возвращает следующий за ним узел
+    Node* erase_node(size_type pos, Node* node) noexcept {
+        index_erase(pos);
+        Node* next = node->next;
+        if (node->prev) {
+            node->prev->next = next;
+        } else {
+            head_ = next;
+        }
+        if (next) {
+            next->prev = node->prev;
         } else {
-            tail_ = nullptr;
+            tail_ = node->prev;
         }
+        destroy_node(node);
         --size_;
+        if (finger_.node) {
+            if (pos < finger_.index) {
+                --finger_.index;
+            } else if (pos == finger_.index) {
+                // На место удалённого встаёт следующий узел
+                finger_.node = next;
+            }
+        }
+        return next;
     }
     
-    void erase_back() {
-        if (tail_->prev) {
-            tail_ = tail_->prev;
-            tail_->next.reset();
+    // Начала отрезков по номерам i * size / k, затем nullptr (конец)
+    template<typename Push>
+    void collect_bounds(size_type k, Push push) const {
+        k = std::max<size_type>(1, std::min(k, size_));
+        if (index_.valid()) {
+            for (size_type i = 0; i < k && size_; ++i) {
+                push(index_.at(i * size_ / k));
+            }
         } else {
-            head_.reset();
-            tail_ = nullptr;
+            Node* node = head_;
+            size_type pos = 0;
+            for (size_type i = 0; i < k && size_; ++i) {
+                for (size_type target = i * size_ / k; pos < target; ++pos) {
+                    node = node->next;
+                }
+                push(node);
+            }
         }
-        --size_;
+        push(nullptr);
     }
     
-    void erase_middle(size_type pos) {
-        Node* node_to_erase = get_node_at(pos);
-        node_to_erase->next->prev = node_to_erase->prev;
-        node_to_erase->prev->next = std::move(node_to_erase->next);
-        --size_;
+    size_type finger_distance(size_type idx) const noexcept {
+        if (!finger_.node) return size_;
+        return idx > finger_.index ? idx - finger_.index : finger_.index - idx;
+    }
+    
+    // Стартуем с ближайшей к idx точки: головы, хвоста или пальца
+    // (или берём узел из индекса). Палец и индекс только читаются, поэтому
+    // const-доступ по номеру из разных потоков безопасен; устаревший индекс
+    // здесь не перестраивается, и поиск идёт по списку
+    Node* find_node(size_type idx) const {
+        if (index_.valid() && finger_distance(idx) > FINGER_REACH) {
+            this->stats_walk(0);
+            return index_.at(idx);
+        }
+        Node* current = head_;
+        size_type pos = 0;
+        size_type distance = idx;
+        if (size_ - 1 - idx < distance) {
+            current = tail_;
+            pos = size_ - 1;
+            distance = size_ - 1 - idx;
+        }
+        if (finger_.node) {
+            size_type from_finger = idx > finger_.index ? idx - finger_.index : finger_.index - idx;
+            if (from_finger < distance) {
+                current = finger_.node;
+                pos = finger_.index;
+            }
+        }
+        this->stats_walk(pos < idx ? idx - pos : pos - idx);
+        for (; pos < idx; ++pos) {
+            current = current->next;
+        }
+        for (; pos > idx; --pos) {
+            current = current->prev;
+        }
+        return current;
+    }
+    
+    // Поиск для изменяющих методов: устаревший индекс строится заново,
+    // палец переезжает на найденный узел
+    Node* get_node_at(size_type idx) {
+        if (index_.stale()) {
+            index_.build(head_, size_, [](Node* node) { return node->next; });
+        }
+        Node* node = find_node(idx);
+        finger_ = Finger{idx, node};
+        return node;
+    }
+    
+    void insert_middle(size_type pos, const T& value) {
+        emplace_before(pos, get_node_at(pos), value);
+    }
+    
+    void insert_middle(size_type pos, T&& value) {
+        emplace_before(pos, get_node_at(pos), std::move(value));
     }
 };
 
@@ -0,0 +1,51 @@
+#ifndef GROWTH_POLICY_H
+#define GROWTH_POLICY_H
+
+#include <cstddef>
+
+// Политика роста буфера SimpleVector.
+// Свою политику удобно получать наследованием с переопределением констант:
+//
+//     struct DoublingPolicy : DefaultGrowthPolicy {
+//         static constexpr double factor = 2.0;
+//     };
+//     SimpleVector<int, DoublingPolicy> v;
+struct DefaultGrowthPolicy {
+    // Во сколько раз увеличивается capacity при нехватке места
+    static constexpr double factor = 1.5;
+
+    // Округлять буферы от одной страницы и больше до целого числа страниц,
+    // чтобы хвост последней страницы не пропадал зря
+    static constexpr bool round_to_pages = false;
+
+    // Выравнивать отображённые буферы по huge page и просить ядро использовать THP
+    static constexpr bool huge_pages = false;
+
+    // Начиная с этого размера (в байтах) тривиально перемещаемые элементы
+    // хранятся в анонимном mmap и растут через mremap; меньшие буферы растут через realloc
+    static constexpr std::size_t mmap_threshold = std::size_t(64) << 20;
+
+    // Когда после erase или clear элементов остаётся меньше этой доли capacity,
+    // буфер уменьшается до size * factor; 0 — буфер только растёт
+    static constexpr double shrink_fraction = 0.0;
+};
+
+// Удвоение с выравниванием по страницам — для больших буферов данных
+struct PageGrowthPolicy : DefaultGrowthPolicy {
+    static constexpr double factor = 2.0;
+    static constexpr bool round_to_pages = true;
+};
+
+// Рост как у DefaultGrowthPolicy, но после всплеска нагрузки буфер отдаёт
+// память обратно, когда заполнен меньше чем на четверть
+struct ShrinkingGrowthPolicy : DefaultGrowthPolicy {
+    static constexpr double shrink_fraction = 0.25;
+};
+
+// Huge pages для многогигабайтных буферов
+struct HugePageGrowthPolicy : PageGrowthPolicy {
+    static constexpr bool huge_pages = true;
+    static constexpr std::size_t mmap_threshold = std::size_t(2) << 20;
+};
+
+#endif // GROWTH_POLICY_H
@@ -0,0 +1,207 @@
+#ifndef HAZARD_POINTERS_H
+#define HAZARD_POINTERS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// Указатели опасности (hazard pointers, M. Michael, 2004) — безопасное
+// освобождение узлов lock-free структур. Поток, собирающийся разыменовать
+// разделяемый узел, публикует его адрес в своей записи; удалённый из структуры
+// узел не освобождается сразу, а откладывается (retire), и освобождается, когда
+// ни одна запись на него не указывает.
+//
+// Работа со слотами идёт через HazardPointers::Guard. Запись выдаётся потоку
+// при первом обращении и возвращается при его завершении; неосвобождённые
+// отложенные узлы завершившегося потока передаются в общий список
+// и освобождаются при следующих проверках.
+class HazardPointers {
+public:
+    // Сколько узлов поток может защищать одновременно
+    static constexpr std::size_t kSlots = 2;
+
+    using Deleter = void (*)(void*);
+
+    static HazardPointers& instance() {
+        static HazardPointers domain;
+        return domain;
+    }
+
+    HazardPointers(const HazardPointers&) = delete;
+    HazardPointers& operator=(const HazardPointers&) = delete;
+
+    ~HazardPointers() {
+        // Потоков больше нет: всё отложенное можно освободить
+        for (auto& retired : orphans_) {
+            retired.deleter(retired.pointer);
+        }
+        Record* record = records_.load();
+        while (record) {
+            Record* next = record->next;
+            delete record;
+            record = next;
+        }
+    }
+
+    class Guard;
+
+private:
+    struct Record {
+        std::atomic<const void*> slots[kSlots] = {};
+        std::atomic<bool> active{false};
+        // Записи только добавляются в голову списка и не удаляются до конца программы
+        Record* next = nullptr;
+    };
+
+    struct Retired {
+        void* pointer;
+        Deleter deleter;
+    };
+
+    struct ThreadState {
+        Record* record;
+        std::vector<Retired> retired;
+
+        ThreadState() : record(instance().acquire()) {}
+
+        ~ThreadState() {
+            HazardPointers& domain = instance();
+            for (auto& slot : record->slots) {
+                slot.store(nullptr);
+            }
+            domain.scan(retired);
+            domain.adopt(retired);
+            record->active.store(false, std::memory_order_release);
+        }
+    };
+
+    std::atomic<Record*> records_{nullptr};
+    std::atomic<std::size_t> record_count_{0};
+
+    std::mutex orphans_mutex_;
+    std::vector<Retired> orphans_;
+    std::atomic<bool> has_orphans_{false};
+
+    HazardPointers() = default;
+
+    static ThreadState& local() {
+        // Домен создаётся раньше состояния потока и поэтому переживает его
+        instance();
+        thread_local ThreadState state;
+        return state;
+    }
+
+    Record* acquire() {
+        for (Record* record = records_.load(); record; record = record->next) {
+            bool expected = false;
+            if (!record->active.load(std::memory_order_relaxed) &&
+                record->active.compare_exchange_strong(expected, true)) {
+                return record;
+            }
+        }
+        Record* record = new Record;
+        record->active.store(true, std::memory_order_relaxed);
+        Record* head = records_.load();
+        do {
+            record->next = head;
+        } while (!records_.compare_exchange_weak(head, record));
+        record_count_.fetch_add(1, std::memory_order_relaxed);
+        return record;
+    }
+
+    // Проверка окупается, когда отложенных узлов заметно больше, чем всех
+    // слотов: тогда хотя бы половина из них освобождается
+    std::size_t scan_threshold() const noexcept {
+        return 2 * kSlots * record_count_.load(std::memory_order_relaxed) + 64;
+    }
+
+    void scan(std::vector<Retired>& retired) {
+        if (has_orphans_.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(orphans_mutex_);
+            retired.insert(retired.end(), orphans_.begin(), orphans_.end());
+            orphans_.clear();
+            has_orphans_.store(false, std::memory_order_relaxed);
+        }
+
+        std::vector<const void*> hazards;
+        hazards.reserve(kSlots * record_count_.load(std::memory_order_relaxed));
+        for (Record* record = records_.load(); record; record = record->next) {
+            for (auto& slot : record->slots) {
+                if (const void* pointer = slot.load()) hazards.push_back(pointer);
+            }
+        }
+        std::sort(hazards.begin(), hazards.end());
+
+        auto kept = std::partition(retired.begin(), retired.end(), [&](const Retired& r) {
+            return std::binary_search(hazards.begin(), hazards.end(), r.pointer);
+        });
+        for (auto it = kept; it != retired.end(); ++it) {
+            it->deleter(it->pointer);
+        }
+        retired.erase(kept, retired.end());
+    }
+
+    void adopt(std::vector<Retired>& retired) {
+        if (retired.empty()) return;
+        std::lock_guard<std::mutex> lock(orphans_mutex_);
+        orphans_.insert(orphans_.end(), retired.begin(), retired.end());
+        has_orphans_.store(true, std::memory_order_relaxed);
+        retired.clear();
+    }
+};
+
+// Доступ к слотам текущего потока на время одной операции над структурой.
+// Запись потока ищется один раз; при выходе из области слоты очищаются
+class HazardPointers::Guard {
+public:
+    Guard() : state_(local()) {}
+
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+
+    ~Guard() {
+        for (auto& slot : state_.record->slots) {
+            slot.store(nullptr, std::memory_order_release);
+        }
+    }
+
+    // Публикует значение source в слоте slot и перечитывает source, пока оно
+    // не совпадёт с опубликованным: после этого узел не будет освобождён,
+    // пока слот не очищен
+    template<typename T>
+    T* protect(std::size_t slot, const std::atomic<T*>& source) {
+        std::atomic<const void*>& hazard = state_.record->slots[slot];
+        T* pointer = source.load();
+        for (;;) {
+            hazard.store(pointer);
+            T* again = source.load();
+            if (again == pointer) return pointer;
+            pointer = again;
+        }
+    }
+
+    // Публикация без перепроверки — вызывающий проверяет сам
+    void set(std::size_t slot, const void* pointer) {
+        state_.record->slots[slot].store(pointer);
+    }
+
+    void clear(std::size_t slot) {
+        state_.record->slots[slot].store(nullptr, std::memory_order_release);
+    }
+
+    // Откладывает освобождение узла, уже недостижимого из структуры
+    void retire(void* pointer, Deleter deleter) {
+        state_.retired.push_back(Retired{pointer, deleter});
+        HazardPointers& domain = instance();
+        if (state_.retired.size() >= domain.scan_threshold()) {
+            domain.scan(state_.retired);
+        }
+    }
+
+private:
+    ThreadState& state_;
+};
+
+#endif // HAZARD_POINTERS_H
@@ -9,6 +9,11 @@
 // Функция для демонстрации всех операций из задания
 template <typename Container>
 void runDemo(const std::string& title) {
+#ifdef LAB3_HAS_CONCEPTS
+    static_assert(SequenceContainer<Container>);
+#else
+    static_assert(is_sequence_container_v<Container>, "runDemo needs a sequence container");
+#endif
     std::cout << "\n=== " << title << " ===" << std::endl;
     
     Container c;
@@ -54,6 +59,13 @@ void runDemo(const std::string& title) {
     std::cout << "After push_back(30): ";
     c.print();
     std::cout << std::endl;
+    
+    // Счётчики горячих путей (только в сборке с LAB3_STATS)
+    if constexpr (stats_enabled) {
+        std::cout << "Stats: ";
+        c.stats().print_json(std::cout);
+        std::cout << std::endl;
+    }
 }
 
 // Тестирование конструкторов и семантики перемещения
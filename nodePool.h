@@ -0,0 +1,235 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Пул блоков фиксированного размера для узлов списков.
+// Память берётся крупными непрерывными slab'ами, освобождённые блоки
+// складываются в интрузивный free list и выдаются повторно.
+// Пул не потокобезопасен.
+class NodePool {
+public:
+    NodePool(std::size_t block_size, std::size_t block_align) noexcept
+        : requested_size_(block_size),
+          requested_align_(block_align),
+          align_(std::max(block_align, alignof(FreeBlock))),
+          block_size_(round_up(std::max(block_size, sizeof(FreeBlock)), align_)),
+          next_slab_blocks_(std::max<std::size_t>(MIN_SLAB_BLOCKS, SLAB_TARGET_BYTES / block_size_)) {}
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    ~NodePool() { release(); }
+
+    // Подходит ли пул для объектов данного размера и выравнивания
+    bool matches(std::size_t size, std::size_t align) const noexcept {
+        return size == requested_size_ && align == requested_align_;
+    }
+
+    void* allocate() {
+        if (free_list_) {
+            FreeBlock* block = free_list_;
+            free_list_ = block->next;
+            return block;
+        }
+        if (bump_ == bump_end_) {
+            add_slab(next_slab_blocks_);
+            next_slab_blocks_ = std::min(next_slab_blocks_ * 2, MAX_SLAB_BLOCKS);
+        }
+        void* p = bump_;
+        bump_ += block_size_;
+        return p;
+    }
+
+    // Готовит не меньше count блоков без выделений в allocate(): нужное
+    // число добирается одним slab'ом, а остаток текущего slab'а уходит в
+    // free list, чтобы не пропасть
+    void reserve(std::size_t count) {
+        std::size_t available = static_cast<std::size_t>(bump_end_ - bump_) / block_size_;
+        for (FreeBlock* block = free_list_; block && available < count; block = block->next) ++available;
+        if (available >= count) return;
+        while (bump_ != bump_end_) {
+            deallocate(bump_);
+            bump_ += block_size_;
+        }
+        add_slab(std::max(count - available, next_slab_blocks_));
+    }
+
+    void deallocate(void* p) noexcept {
+        auto* block = static_cast<FreeBlock*>(p);
+        block->next = free_list_;
+        free_list_ = block;
+    }
+
+    // Освобождает все slab'ы целиком за O(#slabs).
+    // Вызывающий отвечает за то, что в пуле не осталось живых объектов.
+    void release() noexcept {
+        SlabHeader* slab = slabs_;
+        while (slab) {
+            SlabHeader* next = slab->next;
+            ::operator delete(slab, std::align_val_t(slab_align()));
+            slab = next;
+        }
+        slabs_ = nullptr;
+        slab_count_ = 0;
+        free_list_ = nullptr;
+        bump_ = bump_end_ = nullptr;
+    }
+
+    std::size_t slab_count() const noexcept { return slab_count_; }
+    std::size_t block_size() const noexcept { return block_size_; }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct SlabHeader {
+        SlabHeader* next;
+    };
+
+    static constexpr std::size_t MIN_SLAB_BLOCKS = 16;
+    static constexpr std::size_t MAX_SLAB_BLOCKS = 1 << 16;
+    static constexpr std::size_t SLAB_TARGET_BYTES = 4096;
+
+    std::size_t requested_size_;
+    std::size_t requested_align_;
+    std::size_t align_;
+    std::size_t block_size_;
+    std::size_t next_slab_blocks_;
+
+    SlabHeader* slabs_ = nullptr;
+    std::size_t slab_count_ = 0;
+    FreeBlock* free_list_ = nullptr;
+    unsigned char* bump_ = nullptr;
+    unsigned char* bump_end_ = nullptr;
+
+    static std::size_t round_up(std::size_t value, std::size_t align) noexcept {
+        return (value + align - 1) / align * align;
+    }
+
+    std::size_t slab_align() const noexcept { return std::max(align_, alignof(SlabHeader)); }
+
+    void add_slab(std::size_t blocks) {
+        std::size_t header = round_up(sizeof(SlabHeader), align_);
+        void* mem = ::operator new(header + blocks * block_size_, std::align_val_t(slab_align()));
+
+        auto* slab = static_cast<SlabHeader*>(mem);
+        slab->next = slabs_;
+        slabs_ = slab;
+        ++slab_count_;
+
+        bump_ = static_cast<unsigned char*>(mem) + header;
+        bump_end_ = bump_ + blocks * block_size_;
+    }
+};
+
+namespace detail {
+
+// Общее состояние копий PoolAllocator (в том числе после rebind).
+// Пул создаётся при первом выделении под размер запрошенного типа;
+// остальные размеры и массивы обслуживаются обычным operator new.
+struct PoolState {
+    std::unique_ptr<NodePool> pool;
+
+    NodePool* pool_for(std::size_t size, std::size_t align) {
+        if (!pool) pool = std::make_unique<NodePool>(size, align);
+        return pool->matches(size, align) ? pool.get() : nullptr;
+    }
+};
+
+} // namespace detail
+
+// Аллокатор для узловых контейнеров, выделяющий одиночные объекты из NodePool.
+// Копии аллокатора разделяют пул; копия контейнера получает свой пул.
+template<typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    template<typename U>
+    struct rebind {
+        using other = PoolAllocator<U>;
+    };
+
+    PoolAllocator() : state_(std::make_shared<detail::PoolState>()) {}
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : state_(other.state_) {}
+
+    T* allocate(std::size_t n) {
+        if (n == 1) {
+            if (NodePool* pool = state_->pool_for(sizeof(T), alignof(T))) {
+                return static_cast<T*>(pool->allocate());
+            }
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        NodePool* pool = state_->pool.get();
+        if (n == 1 && pool && pool->matches(sizeof(T), alignof(T))) {
+            pool->deallocate(p);
+        } else {
+            std::allocator<T>().deallocate(p, n);
+        }
+    }
+
+    // Заранее выделяет память под count объектов типа T одним slab'ом
+    void reserve(std::size_t count) {
+        if (NodePool* pool = state_->pool_for(sizeof(T), alignof(T))) pool->reserve(count);
+    }
+
+    PoolAllocator select_on_container_copy_construction() const { return PoolAllocator(); }
+
+    // Пул не разделяется ни с кем, кроме этого аллокатора
+    bool sole_owner() const noexcept { return state_.use_count() == 1; }
+
+    // Освобождает все slab'ы разом, если пул больше никем не разделяется.
+    // Возвращает false, если этого сделать нельзя и узлы надо освобождать по одному.
+    bool try_release_all() noexcept {
+        if (state_.use_count() != 1) return false;
+        if (state_->pool) state_->pool->release();
+        return true;
+    }
+
+    const NodePool* pool() const noexcept { return state_->pool.get(); }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U>& other) const noexcept { return state_ == other.state_; }
+    template<typename U>
+    bool operator!=(const PoolAllocator<U>& other) const noexcept { return state_ != other.state_; }
+
+private:
+    template<typename U> friend class PoolAllocator;
+
+    std::shared_ptr<detail::PoolState> state_;
+};
+
+// Умеет ли аллокатор освобождать все свои узлы одной операцией
+template<typename Alloc, typename = void>
+struct supports_bulk_release : std::false_type {};
+
+template<typename Alloc>
+struct supports_bulk_release<Alloc, std::void_t<decltype(std::declval<Alloc&>().try_release_all()),
+                                                decltype(std::declval<const Alloc&>().sole_owner())>>
+    : std::true_type {};
+
+// Умеет ли аллокатор заранее выделить память под несколько узлов
+template<typename Alloc, typename = void>
+struct supports_reserve : std::false_type {};
+
+template<typename Alloc>
+struct supports_reserve<Alloc, std::void_t<decltype(std::declval<Alloc&>().reserve(std::size_t()))>>
+    : std::true_type {};
+
+#endif // NODE_POOL_H
@@ -0,0 +1,357 @@
+#ifndef PARALLEL_ALGORITHMS_H
+#define PARALLEL_ALGORITHMS_H
+
+#include "threadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Параллельные алгоритмы над диапазонами итераторов произвольного доступа
+// (SimpleVector::Iterator, указатели). Диапазон режется на куски по grain
+// элементов, куски раздаются потокам ThreadPool; grain == 0 выбирает размер
+// сам — около четырёх кусков на поток. Без пула используется ThreadPool::global().
+//
+//     ThreadPool pool(8);
+//     parallel_sort(pool, v.begin(), v.end());
+//     long sum = parallel_reduce(pool, v.begin(), v.end(), 0L, std::plus<>());
+//
+// Функции и операции вызываются из разных потоков одновременно. op в
+// parallel_reduce и parallel_scan должна быть ассоциативной: частичные
+// результаты кусков объединяются слева направо, но группируются иначе,
+// чем при последовательном проходе.
+
+namespace parallel_detail {
+
+// Наименьший кусок по умолчанию: на меньших накладные расходы пула заметнее работы
+constexpr std::size_t kMinGrain = 2048;
+
+// Разбиение [0, size) на chunks кусков по grain элементов (последний короче)
+struct Partition {
+    std::size_t size;
+    std::size_t grain;
+    std::size_t chunks;
+
+    std::size_t begin(std::size_t chunk) const noexcept { return chunk * grain; }
+    std::size_t end(std::size_t chunk) const noexcept { return std::min(size, (chunk + 1) * grain); }
+};
+
+inline Partition partition(const ThreadPool& pool, std::size_t size, std::size_t grain) {
+    if (grain == 0) {
+        grain = std::max(kMinGrain, size / (pool.concurrency() * 4) + 1);
+    }
+    // Один поток — один кусок: последовательный путь без накладных расходов
+    if (pool.concurrency() == 1 || size <= grain) {
+        return Partition{size, std::max<std::size_t>(size, 1), std::size_t(size != 0)};
+    }
+    return Partition{size, grain, (size + grain - 1) / grain};
+}
+
+// Вызывает f(chunk, begin, end) для каждого куска; первый кусок выполняет вызывающий поток
+template<typename F>
+void run_chunks(ThreadPool& pool, const Partition& part, F&& f) {
+    if (part.chunks == 0) return;
+    if (part.chunks == 1) {
+        f(std::size_t(0), std::size_t(0), part.size);
+        return;
+    }
+    TaskGroup group(pool);
+    for (std::size_t c = 1; c < part.chunks; ++c) {
+        group.run([&f, &part, c] { f(c, part.begin(c), part.end(c)); });
+    }
+    f(std::size_t(0), part.begin(0), part.end(0));
+    group.wait();
+}
+
+template<typename RandomIt>
+RandomIt advance(RandomIt it, std::size_t n) {
+    return it + static_cast<typename std::iterator_traits<RandomIt>::difference_type>(n);
+}
+
+template<typename RandomIt, typename Compare>
+void sort_range(ThreadPool& pool, RandomIt first, RandomIt last, Compare comp,
+                std::size_t grain, int depth) {
+    TaskGroup group(pool);
+    while (static_cast<std::size_t>(last - first) > grain) {
+        // Слишком много неудачных опорных — досортировываем как есть, O(n log n) гарантирован
+        if (depth-- == 0) break;
+
+        // Медиана трёх становится опорным элементом и остаётся в *first
+        RandomIt mid = first + (last - first) / 2;
+        RandomIt back = last - 1;
+        if (comp(*mid, *first)) std::iter_swap(mid, first);
+        if (comp(*back, *mid)) std::iter_swap(back, mid);
+        if (comp(*mid, *first)) std::iter_swap(mid, first);
+        std::iter_swap(first, mid);
+
+        RandomIt less_end = std::partition(first + 1, last,
+            [&](const auto& x) { return comp(x, *first); });
+        // Равные опорному в рекурсию не идут: иначе одинаковые ключи делятся 1 : n - 1
+        RandomIt equal_end = std::partition(less_end, last,
+            [&](const auto& x) { return !comp(*first, x); });
+        std::iter_swap(first, less_end - 1);
+
+        RandomIt left_last = less_end - 1;
+        group.run([&pool, first, left_last, comp, grain, depth] {
+            sort_range(pool, first, left_last, comp, grain, depth);
+        });
+        first = equal_end;
+    }
+    std::sort(first, last, comp);
+    group.wait();
+}
+
+// Вызывает f(chunk, bounds[chunk], bounds[chunk + 1]) для каждого отрезка
+template<typename ForwardIt, typename F>
+void run_bounds(ThreadPool& pool, const std::vector<ForwardIt>& bounds, F&& f) {
+    if (bounds.size() < 2) return;
+    const std::size_t chunks = bounds.size() - 1;
+    run_chunks(pool, Partition{chunks, 1, chunks}, [&](std::size_t chunk, std::size_t, std::size_t) {
+        f(chunk, bounds[chunk], bounds[chunk + 1]);
+    });
+}
+
+// На сколько отрезков делить список: с запасом на неравную скорость потоков
+inline std::size_t list_chunks(const ThreadPool& pool) noexcept {
+    return pool.concurrency() == 1 ? 1 : pool.concurrency() * 4;
+}
+
+} // namespace parallel_detail
+
+// f(element) для каждого элемента [first, last)
+template<typename RandomIt, typename F>
+void parallel_for(ThreadPool& pool, RandomIt first, RandomIt last, F f, std::size_t grain = 0) {
+    const auto part = parallel_detail::partition(pool, static_cast<std::size_t>(last - first), grain);
+    parallel_detail::run_chunks(pool, part, [&](std::size_t, std::size_t begin, std::size_t end) {
+        RandomIt chunk_last = parallel_detail::advance(first, end);
+        for (RandomIt it = parallel_detail::advance(first, begin); it != chunk_last; ++it) {
+            f(*it);
+        }
+    });
+}
+
+// init op x0 op x1 op ... op xn-1
+template<typename RandomIt, typename T, typename BinaryOp>
+T parallel_reduce(ThreadPool& pool, RandomIt first, RandomIt last, T init, BinaryOp op,
+                  std::size_t grain = 0) {
+    const auto part = parallel_detail::partition(pool, static_cast<std::size_t>(last - first), grain);
+    std::vector<std::optional<T>> partials(part.chunks);
+    parallel_detail::run_chunks(pool, part, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        RandomIt it = parallel_detail::advance(first, begin);
+        RandomIt chunk_last = parallel_detail::advance(first, end);
+        T acc = *it;
+        for (++it; it != chunk_last; ++it) {
+            acc = op(std::move(acc), *it);
+        }
+        partials[chunk].emplace(std::move(acc));
+    });
+    for (auto& partial : partials) {
+        init = op(std::move(init), std::move(*partial));
+    }
+    return init;
+}
+
+// d_first[i] = op(first[i]); возвращает конец записанного диапазона.
+// Выходной диапазон может совпадать с входным
+template<typename RandomIt, typename OutputIt, typename UnaryOp>
+OutputIt parallel_transform(ThreadPool& pool, RandomIt first, RandomIt last, OutputIt d_first,
+                            UnaryOp op, std::size_t grain = 0) {
+    const std::size_t size = static_cast<std::size_t>(last - first);
+    const auto part = parallel_detail::partition(pool, size, grain);
+    parallel_detail::run_chunks(pool, part, [&](std::size_t, std::size_t begin, std::size_t end) {
+        RandomIt it = parallel_detail::advance(first, begin);
+        RandomIt chunk_last = parallel_detail::advance(first, end);
+        OutputIt out = parallel_detail::advance(d_first, begin);
+        for (; it != chunk_last; ++it, ++out) {
+            *out = op(*it);
+        }
+    });
+    return parallel_detail::advance(d_first, size);
+}
+
+// Включающий префиксный скан: d_first[i] = x0 op x1 op ... op xi.
+// Два прохода: суммы кусков, затем скан каждого куска со смещением.
+// Выходной диапазон может совпадать с входным
+template<typename RandomIt, typename OutputIt, typename BinaryOp = std::plus<>>
+OutputIt parallel_scan(ThreadPool& pool, RandomIt first, RandomIt last, OutputIt d_first,
+                       BinaryOp op = BinaryOp(), std::size_t grain = 0) {
+    using V = std::remove_cv_t<typename std::iterator_traits<RandomIt>::value_type>;
+    const std::size_t size = static_cast<std::size_t>(last - first);
+    const auto part = parallel_detail::partition(pool, size, grain);
+
+    // Смещение куска — свёртка всех предыдущих; последний кусок в свёртке не нужен
+    std::vector<std::optional<V>> offsets(part.chunks);
+    if (part.chunks > 1) {
+        const parallel_detail::Partition head{part.begin(part.chunks - 1), part.grain, part.chunks - 1};
+        parallel_detail::run_chunks(pool, head, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            RandomIt it = parallel_detail::advance(first, begin);
+            RandomIt chunk_last = parallel_detail::advance(first, end);
+            V acc = *it;
+            for (++it; it != chunk_last; ++it) {
+                acc = op(std::move(acc), *it);
+            }
+            offsets[chunk + 1].emplace(std::move(acc));
+        });
+        for (std::size_t c = 2; c < part.chunks; ++c) {
+            offsets[c].emplace(op(*offsets[c - 1], std::move(*offsets[c])));
+        }
+    }
+
+    parallel_detail::run_chunks(pool, part, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        RandomIt it = parallel_detail::advance(first, begin);
+        RandomIt chunk_last = parallel_detail::advance(first, end);
+        OutputIt out = parallel_detail::advance(d_first, begin);
+        V acc = offsets[chunk] ? op(*offsets[chunk], *it) : V(*it);
+        *out = acc;
+        for (++it, ++out; it != chunk_last; ++it, ++out) {
+            acc = op(std::move(acc), *it);
+            *out = acc;
+        }
+    });
+    return parallel_detail::advance(d_first, size);
+}
+
+// Параллельная быстрая сортировка: левая часть после разбиения уходит
+// задачей в пул, куски не длиннее grain сортируются std::sort. Неустойчива
+template<typename RandomIt, typename Compare = std::less<>>
+void parallel_sort(ThreadPool& pool, RandomIt first, RandomIt last, Compare comp = Compare(),
+                   std::size_t grain = 0) {
+    const std::size_t size = static_cast<std::size_t>(last - first);
+    const auto part = parallel_detail::partition(pool, size, grain);
+    if (part.chunks <= 1) {
+        std::sort(first, last, comp);
+        return;
+    }
+    int depth = 0;
+    for (std::size_t n = size; n > 1; n >>= 1) depth += 2;
+    parallel_detail::sort_range(pool, first, last, comp, part.grain, depth);
+}
+
+// Алгоритмы над отрезками [bounds[i], bounds[i + 1]) для контейнеров без
+// произвольного доступа — списков (границы даёт chunk_bounds). Каждый отрезок
+// обходится одной задачей; одни и те же границы годятся для нескольких проходов
+
+template<typename ForwardIt, typename F>
+void parallel_for_each(ThreadPool& pool, const std::vector<ForwardIt>& bounds, F f) {
+    parallel_detail::run_bounds(pool, bounds, [&](std::size_t, ForwardIt first, ForwardIt last) {
+        for (; first != last; ++first) {
+            f(*first);
+        }
+    });
+}
+
+template<typename ForwardIt, typename T, typename BinaryOp>
+T parallel_reduce(ThreadPool& pool, const std::vector<ForwardIt>& bounds, T init, BinaryOp op) {
+    std::vector<std::optional<T>> partials(bounds.empty() ? 0 : bounds.size() - 1);
+    parallel_detail::run_bounds(pool, bounds, [&](std::size_t chunk, ForwardIt first, ForwardIt last) {
+        if (first == last) return;
+        T acc = *first;
+        for (++first; first != last; ++first) {
+            acc = op(std::move(acc), *first);
+        }
+        partials[chunk].emplace(std::move(acc));
+    });
+    for (auto& partial : partials) {
+        if (partial) init = op(std::move(init), std::move(*partial));
+    }
+    return init;
+}
+
+// Первый по порядку элемент, для которого pred истинен, или bounds.back().
+// Отрезки за уже найденным прекращают поиск
+template<typename ForwardIt, typename Pred>
+ForwardIt parallel_find_if(ThreadPool& pool, const std::vector<ForwardIt>& bounds, Pred pred) {
+    const std::size_t chunks = bounds.empty() ? 0 : bounds.size() - 1;
+    std::vector<std::optional<ForwardIt>> found(chunks);
+    std::atomic<std::size_t> best{chunks};
+    parallel_detail::run_bounds(pool, bounds, [&](std::size_t chunk, ForwardIt first, ForwardIt last) {
+        for (; first != last; ++first) {
+            if (best.load(std::memory_order_relaxed) < chunk) return;
+            if (pred(*first)) {
+                found[chunk].emplace(first);
+                std::size_t current = best.load(std::memory_order_relaxed);
+                while (chunk < current &&
+                       !best.compare_exchange_weak(current, chunk, std::memory_order_relaxed)) {}
+                return;
+            }
+        }
+    });
+    return best < chunks ? *found[best] : bounds.back();
+}
+
+// Те же алгоритмы прямо над списком: границы считаются на каждый вызов
+// (четыре отрезка на поток), при одном потоке — обычный проход
+
+template<typename List, typename F,
+         typename = decltype(std::declval<List&>().chunk_bounds(1))>
+void parallel_for_each(ThreadPool& pool, List& list, F f) {
+    parallel_for_each(pool, list.chunk_bounds(parallel_detail::list_chunks(pool)), std::move(f));
+}
+
+template<typename List, typename T, typename BinaryOp,
+         typename = decltype(std::declval<List&>().chunk_bounds(1))>
+T parallel_reduce(ThreadPool& pool, List& list, T init, BinaryOp op) {
+    return parallel_reduce(pool, list.chunk_bounds(parallel_detail::list_chunks(pool)),
+                           std::move(init), std::move(op));
+}
+
+template<typename List, typename Pred,
+         typename = decltype(std::declval<List&>().chunk_bounds(1))>
+auto parallel_find_if(ThreadPool& pool, List& list, Pred pred) {
+    return parallel_find_if(pool, list.chunk_bounds(parallel_detail::list_chunks(pool)),
+                            std::move(pred));
+}
+
+// Те же алгоритмы на пуле по умолчанию
+
+template<typename RandomIt, typename F>
+void parallel_for(RandomIt first, RandomIt last, F f, std::size_t grain = 0) {
+    parallel_for(ThreadPool::global(), first, last, std::move(f), grain);
+}
+
+template<typename RandomIt, typename T, typename BinaryOp>
+T parallel_reduce(RandomIt first, RandomIt last, T init, BinaryOp op, std::size_t grain = 0) {
+    return parallel_reduce(ThreadPool::global(), first, last, std::move(init), std::move(op), grain);
+}
+
+template<typename RandomIt, typename OutputIt, typename UnaryOp>
+OutputIt parallel_transform(RandomIt first, RandomIt last, OutputIt d_first, UnaryOp op,
+                            std::size_t grain = 0) {
+    return parallel_transform(ThreadPool::global(), first, last, d_first, std::move(op), grain);
+}
+
+template<typename RandomIt, typename OutputIt, typename BinaryOp = std::plus<>>
+OutputIt parallel_scan(RandomIt first, RandomIt last, OutputIt d_first, BinaryOp op = BinaryOp(),
+                       std::size_t grain = 0) {
+    return parallel_scan(ThreadPool::global(), first, last, d_first, std::move(op), grain);
+}
+
+template<typename RandomIt, typename Compare = std::less<>>
+void parallel_sort(RandomIt first, RandomIt last, Compare comp = Compare(), std::size_t grain = 0) {
+    parallel_sort(ThreadPool::global(), first, last, std::move(comp), grain);
+}
+
+template<typename List, typename F,
+         typename = decltype(std::declval<List&>().chunk_bounds(1))>
+void parallel_for_each(List& list, F f) {
+    parallel_for_each(ThreadPool::global(), list, std::move(f));
+}
+
+template<typename List, typename T, typename BinaryOp,
+         typename = decltype(std::declval<List&>().chunk_bounds(1))>
+T parallel_reduce(List& list, T init, BinaryOp op) {
+    return parallel_reduce(ThreadPool::global(), list, std::move(init), std::move(op));
+}
+
+template<typename List, typename Pred,
+         typename = decltype(std::declval<List&>().chunk_bounds(1))>
+auto parallel_find_if(List& list, Pred pred) {
+    return parallel_find_if(ThreadPool::global(), list, std::move(pred));
+}
+
+#endif // PARALLEL_ALGORITHMS_H
@@ -0,0 +1,478 @@
+#ifndef PERSISTENT_VECTOR_H
+#define PERSISTENT_VECTOR_H
+
+#include "staticContainer.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace persistent_detail {
+
+// Степень двойки, при которой чанк занимает около килобайта
+template<typename T>
+constexpr std::size_t default_chunk() noexcept {
+    std::size_t n = 8;
+    while (n * 2 * sizeof(T) <= 1024) n *= 2;
+    return n;
+}
+
+constexpr unsigned log2_exact(std::size_t n) noexcept {
+    unsigned bits = 0;
+    while ((std::size_t(1) << bits) < n) ++bits;
+    return bits;
+}
+
+// Общий заголовок узлов: счётчик ссылок и число занятых слотов
+struct NodeBase {
+    std::atomic<std::size_t> refs{1};
+    std::size_t count = 0;
+};
+
+} // namespace persistent_detail
+
+// Вектор с общей структурой (persistent vector): копия стоит O(1) и делит
+// все элементы с оригиналом, а запись копирует только затронутый чанк.
+//
+// Элементы лежат в чанках по ChunkSize штук — листьях префиксного дерева с
+// ветвлением 32 (как у Clojure PersistentVector). Узлы считают ссылки;
+// узел, на который ссылается больше одного вектора, неизменяем. Запись
+// (push_back, pop_back, неконстантный operator[]) копирует разделяемые узлы
+// на пути к своему чанку: сам чанк и не больше log32(size / ChunkSize)
+// внутренних узлов, остальное дерево остаётся общим.
+//
+// Снимки для читателей в других потоках:
+//
+//     PersistentVector<int> v;                // пишет только этот поток
+//     auto snapshot = v;                      // O(1), на потоке писателя
+//     std::thread reader([s = std::move(snapshot)] { sum(s.begin(), s.end()); });
+//     v.push_back(1);                         // писатель продолжает, снимок не меняется
+//
+// Разные векторы, делящие узлы, можно читать и менять из разных потоков
+// одновременно, как разные std::shared_ptr на общий объект: счётчики
+// ссылок атомарны. Один и тот же объект вектора — нет, поэтому снимок
+// делается копированием на потоке, который владеет вектором.
+//
+// Неконстантный operator[] делает путь к элементу собственным даже для
+// чтения; для чтения разделяемого вектора берите константную ссылку.
+// Итераторы только константные и, как у SimpleVector, недействительны
+// после любого изменения вектора
+template<typename T, std::size_t ChunkSize = persistent_detail::default_chunk<T>()>
+class PersistentVector : public StaticContainer<PersistentVector<T, ChunkSize>, T> {
+    using Interface = StaticContainer<PersistentVector<T, ChunkSize>, T>;
+    using NodeBase = persistent_detail::NodeBase;
+
+    static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0,
+                  "PersistentVector chunk size must be a power of two");
+
+public:
+    using value_type = typename Interface::value_type;
+    using size_type = typename Interface::size_type;
+    using reference = typename Interface::reference;
+    using const_reference = typename Interface::const_reference;
+    using difference_type = std::ptrdiff_t;
+
+    static constexpr size_type chunk_size = ChunkSize;
+    static constexpr size_type branching = 32;
+
+private:
+    static constexpr unsigned kChunkBits = persistent_detail::log2_exact(ChunkSize);
+    static constexpr unsigned kBranchBits = 5;
+    static constexpr size_type kChunkMask = ChunkSize - 1;
+    static constexpr size_type kBranchMask = branching - 1;
+
+    // count — число созданных элементов
+    struct Leaf : NodeBase {
+        alignas(T) unsigned char storage[ChunkSize * sizeof(T)];
+
+        T* items() noexcept { return reinterpret_cast<T*>(storage); }
+        const T* items() const noexcept { return reinterpret_cast<const T*>(storage); }
+    };
+
+    // count — число детей; уровень узла (и тип детей) знает вектор
+    struct Inner : NodeBase {
+        NodeBase* children[branching];
+    };
+
+public:
+    class ConstIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        ConstIterator() noexcept = default;
+
+        reference operator*() const { return *current_; }
+        pointer operator->() const { return current_; }
+
+        // Внутри чанка — сдвиг указателя, на границе — спуск по дереву
+        ConstIterator& operator++() {
+            ++index_;
+            if (++current_ == chunk_end_) load();
+            return *this;
+        }
+        ConstIterator operator++(int) { ConstIterator tmp = *this; ++*this; return tmp; }
+
+        ConstIterator& operator--() { --index_; load(); return *this; }
+        ConstIterator operator--(int) { ConstIterator tmp = *this; --*this; return tmp; }
+
+        ConstIterator& operator+=(difference_type n) { index_ += n; load(); return *this; }
+        ConstIterator& operator-=(difference_type n) { index_ -= n; load(); return *this; }
+
+        ConstIterator operator+(difference_type n) const { ConstIterator tmp = *this; return tmp += n; }
+        ConstIterator operator-(difference_type n) const { ConstIterator tmp = *this; return tmp -= n; }
+
+        friend ConstIterator operator+(difference_type n, const ConstIterator& it) { return it + n; }
+
+        difference_type operator-(const ConstIterator& other) const {
+            return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+        }
+
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        bool operator==(const ConstIterator& other) const { return index_ == other.index_; }
+        bool operator!=(const ConstIterator& other) const { return index_ != other.index_; }
+        bool operator<(const ConstIterator& other) const { return index_ < other.index_; }
+        bool operator>(const ConstIterator& other) const { return index_ > other.index_; }
+        bool operator<=(const ConstIterator& other) const { return index_ <= other.index_; }
+        bool operator>=(const ConstIterator& other) const { return index_ >= other.index_; }
+
+    private:
+        friend class PersistentVector;
+
+        ConstIterator(const PersistentVector* vector, size_type index) : vector_(vector), index_(index) { load(); }
+
+        void load() {
+            if (index_ >= vector_->size_) {
+                current_ = chunk_end_ = nullptr;
+                return;
+            }
+            const Leaf* leaf = vector_->find_leaf(index_ >> kChunkBits);
+            current_ = leaf->items() + (index_ & kChunkMask);
+            chunk_end_ = leaf->items() + leaf->count;
+        }
+
+        const PersistentVector* vector_ = nullptr;
+        size_type index_ = 0;
+        const T* current_ = nullptr;
+        const T* chunk_end_ = nullptr;
+    };
+
+    using iterator = ConstIterator;
+    using const_iterator = ConstIterator;
+
+    PersistentVector() noexcept = default;
+
+    PersistentVector(std::initializer_list<T> init) {
+        try {
+            for (const auto& item : init) push_back(item);
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+
+    // O(1): новый вектор ссылается на тот же корень
+    PersistentVector(const PersistentVector& other) noexcept
+        : root_(other.root_), depth_(other.depth_), size_(other.size_) {
+        if (root_) root_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    PersistentVector(PersistentVector&& other) noexcept
+        : root_(std::exchange(other.root_, nullptr)), depth_(std::exchange(other.depth_, 0)),
+          size_(std::exchange(other.size_, 0)) {}
+
+    PersistentVector& operator=(const PersistentVector& other) noexcept {
+        PersistentVector(other).swap(*this);
+        return *this;
+    }
+
+    PersistentVector& operator=(PersistentVector&& other) noexcept {
+        PersistentVector(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    ~PersistentVector() { release(root_, depth_); }
+
+    // Снимок для другого потока; то же, что копия
+    PersistentVector snapshot() const noexcept { return *this; }
+
+    size_type size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    void clear() noexcept {
+        release(root_, depth_);
+        root_ = nullptr;
+        depth_ = 0;
+        size_ = 0;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template<typename... Args>
+    reference emplace_back(Args&&... args) {
+        if (size_ == capacity()) grow_root();
+        Leaf* leaf = unique_leaf(size_ >> kChunkBits);
+        T* slot = leaf->items() + (size_ & kChunkMask);
+        try {
+            ::new (static_cast<void*>(slot)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            // Только что достроенный пустой лист не должен оставаться в дереве
+            if (leaf->count == 0) drop_last_leaf();
+            throw;
+        }
+        ++leaf->count;
+        ++size_;
+        return *slot;
+    }
+
+    void pop_back() {
+        this->check_index(0, size_, "pop_back on empty vector");
+        Leaf* leaf = unique_leaf((size_ - 1) >> kChunkBits);
+        leaf->items()[--leaf->count].~T();
+        --size_;
+        if (leaf->count == 0) drop_last_leaf();
+    }
+
+    // Вставка со сдвигом хвоста: копируются только чанки от pos до конца
+    void insert(size_type pos, const T& value) {
+        this->check_position(pos, size_);
+        T carry(value);
+        for (size_type chunk = pos >> kChunkBits; chunk < chunk_count(); ++chunk) {
+            Leaf* leaf = unique_leaf(chunk);
+            T* items = leaf->items();
+            for (size_type k = chunk == (pos >> kChunkBits) ? (pos & kChunkMask) : 0; k < leaf->count; ++k) {
+                using std::swap;
+                swap(carry, items[k]);
+            }
+        }
+        push_back(std::move(carry));
+    }
+
+    void erase(size_type pos) {
+        this->check_index(pos, size_);
+        T* prev = nullptr;  // последний слот предыдущего чанка
+        for (size_type chunk = pos >> kChunkBits; chunk < chunk_count(); ++chunk) {
+            Leaf* leaf = unique_leaf(chunk);
+            T* items = leaf->items();
+            size_type k = chunk == (pos >> kChunkBits) ? (pos & kChunkMask) : 0;
+            if (prev) *prev = std::move(items[0]);
+            for (; k + 1 < leaf->count; ++k) items[k] = std::move(items[k + 1]);
+            prev = items + leaf->count - 1;
+        }
+        pop_back();
+    }
+
+    const_reference operator[](size_type idx) const {
+        this->check_index(idx, size_);
+        return find_leaf(idx >> kChunkBits)->items()[idx & kChunkMask];
+    }
+
+    // Запись: разделяемый чанк с элементом копируется
+    reference operator[](size_type idx) {
+        this->check_index(idx, size_);
+        return unique_leaf(idx >> kChunkBits)->items()[idx & kChunkMask];
+    }
+
+    const_reference at(size_type idx) const { return (*this)[idx]; }
+    reference at(size_type idx) { return (*this)[idx]; }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size_); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    // Обход по чанкам: f(const T* data, size_type count) для каждого листа
+    // по порядку. Внутренний цикл по непрерывному массиву векторизуется,
+    // в отличие от цикла по итераторам с проверкой границы чанка
+    template<typename F>
+    void for_each_chunk(F&& f) const {
+        if (root_) visit_chunks(root_, depth_, f);
+    }
+
+    void print(std::ostream& os = std::cout) const {
+        for (auto it = begin(); it != end(); ++it) {
+            if (it != begin()) os << " ";
+            os << *it;
+        }
+    }
+
+    void swap(PersistentVector& other) noexcept {
+        std::swap(root_, other.root_);
+        std::swap(depth_, other.depth_);
+        std::swap(size_, other.size_);
+    }
+
+    // Чанк с элементом idx общий с другим вектором (снимком): общий он сам
+    // или кто-то из его предков
+    bool shares_chunk(size_type idx) const {
+        this->check_index(idx, size_);
+        const size_type chunk = idx >> kChunkBits;
+        const NodeBase* node = root_;
+        for (unsigned level = depth_;; --level) {
+            if (!is_unique(node)) return true;
+            if (level == 0) return false;
+            node = static_cast<const Inner*>(node)->children[(chunk >> ((level - 1) * kBranchBits)) & kBranchMask];
+        }
+    }
+
+private:
+    NodeBase* root_ = nullptr;
+    unsigned depth_ = 0;  // число уровней внутренних узлов над листьями
+    size_type size_ = 0;
+
+    size_type chunk_count() const noexcept { return (size_ + ChunkSize - 1) >> kChunkBits; }
+
+    size_type capacity() const noexcept {
+        return root_ ? ChunkSize << (kBranchBits * depth_) : 0;
+    }
+
+    const Leaf* find_leaf(size_type chunk) const noexcept {
+        const NodeBase* node = root_;
+        for (unsigned level = depth_; level > 0; --level) {
+            node = static_cast<const Inner*>(node)->children[(chunk >> ((level - 1) * kBranchBits)) & kBranchMask];
+        }
+        return static_cast<const Leaf*>(node);
+    }
+
+    // Единственный владелец может менять узел на месте. acquire связывает
+    // проверку с release-декрементом последнего другого владельца: его
+    // чтения узла завершились до нашей записи
+    static bool is_unique(const NodeBase* node) noexcept {
+        return node->refs.load(std::memory_order_acquire) == 1;
+    }
+
+    static void release(NodeBase* node, unsigned level) noexcept {
+        if (!node || node->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+        if (level == 0) {
+            auto* leaf = static_cast<Leaf*>(node);
+            for (size_type i = 0; i < leaf->count; ++i) leaf->items()[i].~T();
+            delete leaf;
+        } else {
+            auto* inner = static_cast<Inner*>(node);
+            for (size_type i = 0; i < inner->count; ++i) release(inner->children[i], level - 1);
+            delete inner;
+        }
+    }
+
+    static NodeBase* clone(const NodeBase* node, unsigned level) {
+        if (level > 0) {
+            auto* copy = new Inner;
+            const auto* inner = static_cast<const Inner*>(node);
+            copy->count = inner->count;
+            for (size_type i = 0; i < inner->count; ++i) {
+                copy->children[i] = inner->children[i];
+                copy->children[i]->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+            return copy;
+        }
+        auto* copy = new Leaf;
+        const auto* leaf = static_cast<const Leaf*>(node);
+        try {
+            for (; copy->count < leaf->count; ++copy->count) {
+                ::new (static_cast<void*>(copy->items() + copy->count)) T(leaf->items()[copy->count]);
+            }
+        } catch (...) {
+            release(copy, 0);
+            throw;
+        }
+        return copy;
+    }
+
+    template<typename F>
+    static void visit_chunks(const NodeBase* node, unsigned level, F& f) {
+        if (level == 0) {
+            const auto* leaf = static_cast<const Leaf*>(node);
+            f(leaf->items(), leaf->count);
+            return;
+        }
+        const auto* inner = static_cast<const Inner*>(node);
+        for (size_type i = 0; i < inner->count; ++i) visit_chunks(inner->children[i], level - 1, f);
+    }
+
+    static NodeBase* make_node(unsigned level) {
+        if (level > 0) return new Inner;
+        return new Leaf;
+    }
+
+    // Делает путь от корня к листу chunk собственным, копируя разделяемые
+    // узлы, и достраивает недостающие узлы для нового чанка в конце
+    Leaf* unique_leaf(size_type chunk) {
+        NodeBase** slot = &root_;
+        for (unsigned level = depth_;; --level) {
+            NodeBase* node = *slot;
+            if (!is_unique(node)) {
+                NodeBase* copy = clone(node, level);
+                release(node, level);
+                *slot = node = copy;
+            }
+            if (level == 0) return static_cast<Leaf*>(node);
+            auto* inner = static_cast<Inner*>(node);
+            const size_type idx = (chunk >> ((level - 1) * kBranchBits)) & kBranchMask;
+            if (idx == inner->count) {
+                inner->children[idx] = make_node(level - 1);
+                ++inner->count;
+            }
+            slot = &inner->children[idx];
+        }
+    }
+
+    // Дерево заполнено: старый корень становится первым ребёнком нового
+    void grow_root() {
+        if (!root_) {
+            root_ = make_node(0);
+            return;
+        }
+        auto* inner = static_cast<Inner*>(make_node(depth_ + 1));
+        inner->children[0] = root_;
+        inner->count = 1;
+        root_ = inner;
+        ++depth_;
+    }
+
+    // Последний лист опустел: он и опустевшие предки удаляются, корень с
+    // единственным ребёнком заменяется ребёнком. Путь уже собственный
+    void drop_last_leaf() noexcept {
+        if (depth_ == 0) {
+            release(root_, 0);
+            root_ = nullptr;
+            return;
+        }
+        Inner* path[sizeof(size_type) * 8];
+        NodeBase* node = root_;
+        for (unsigned level = depth_; level > 0; --level) {
+            path[level] = static_cast<Inner*>(node);
+            node = path[level]->children[path[level]->count - 1];
+        }
+        release(node, 0);
+        for (unsigned level = 1; level <= depth_; ++level) {
+            if (--path[level]->count > 0) break;
+            if (level == depth_) {
+                release(root_, depth_);
+                root_ = nullptr;
+                depth_ = 0;
+                return;
+            }
+            release(path[level], level);
+        }
+        while (depth_ > 0 && root_->count == 1) {
+            auto* old_root = static_cast<Inner*>(root_);
+            root_ = old_root->children[0];
+            old_root->count = 0;
+            release(old_root, depth_);
+            --depth_;
+        }
+    }
+};
+
+#endif // PERSISTENT_VECTOR_H
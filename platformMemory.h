@@ -0,0 +1,147 @@
+#ifndef PLATFORM_MEMORY_H
+#define PLATFORM_MEMORY_H
+
+// Тонкая обёртка над системными вызовами работы с виртуальной памятью.
+// На платформах без mmap функции сообщают о неудаче (nullptr / false),
+// и контейнеры остаются на malloc/realloc.
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define LAB3_HAS_MMAP 1
+#else
+#define LAB3_HAS_MMAP 0
+#endif
+
+#if defined(__linux__)
+#define LAB3_HAS_MREMAP 1
+#else
+#define LAB3_HAS_MREMAP 0
+#endif
+
+namespace platform {
+
+constexpr bool has_mmap = LAB3_HAS_MMAP != 0;
+constexpr bool has_mremap = LAB3_HAS_MREMAP != 0;
+
+// Размер transparent huge page на x86-64 / AArch64 с 4К страницами
+constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+
+inline std::size_t page_size() noexcept {
+#if LAB3_HAS_MMAP
+    static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+#else
+    return 4096;
+#endif
+}
+
+inline std::size_t round_up(std::size_t value, std::size_t granularity) noexcept {
+    return (value + granularity - 1) / granularity * granularity;
+}
+
+// Анонимное отображение; при align > page_size адрес выравнивается по align
+inline void* map_anonymous(std::size_t bytes, std::size_t align = 0) noexcept {
+#if LAB3_HAS_MMAP
+    std::size_t extra = align > page_size() ? align : 0;
+    void* p = ::mmap(nullptr, bytes + extra, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) return nullptr;
+    if (extra == 0) return p;
+
+    // Отрезаем лишнее до и после выровненного участка
+    auto base = reinterpret_cast<std::uintptr_t>(p);
+    std::uintptr_t aligned = (base + align - 1) / align * align;
+    std::size_t head = aligned - base;
+    std::size_t tail = extra - head;
+    if (head) ::munmap(p, head);
+    if (tail) ::munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+    return reinterpret_cast<void*>(aligned);
+#else
+    (void)bytes;
+    (void)align;
+    return nullptr;
+#endif
+}
+
+// Изменение размера отображения; ядро может перенести его без копирования данных.
+// Возвращает nullptr, если mremap недоступен или не удался.
+inline void* remap(void* p, std::size_t old_bytes, std::size_t new_bytes) noexcept {
+#if LAB3_HAS_MREMAP
+    void* q = ::mremap(p, old_bytes, new_bytes, MREMAP_MAYMOVE);
+    return q == MAP_FAILED ? nullptr : q;
+#else
+    (void)p;
+    (void)old_bytes;
+    (void)new_bytes;
+    return nullptr;
+#endif
+}
+
+inline void unmap(void* p, std::size_t bytes) noexcept {
+#if LAB3_HAS_MMAP
+    if (p) ::munmap(p, bytes);
+#else
+    (void)p;
+    (void)bytes;
+#endif
+}
+
+// Отображение файла целиком в режиме MAP_PRIVATE: только для чтения или
+// с копированием при записи — изменённые страницы копируются и видны только
+// этому процессу, файл не меняется. В bytes — размер файла. Пустой или
+// недоступный файл даёт nullptr
+inline void* map_file(const char* path, bool copy_on_write, std::size_t& bytes) noexcept {
+#if LAB3_HAS_MMAP
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return nullptr;
+    void* p = nullptr;
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+        bytes = static_cast<std::size_t>(st.st_size);
+        int prot = PROT_READ | (copy_on_write ? PROT_WRITE : 0);
+        p = ::mmap(nullptr, bytes, prot, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) p = nullptr;
+    }
+    // Отображение держит файл само, дескриптор больше не нужен
+    ::close(fd);
+    return p;
+#else
+    (void)path;
+    (void)copy_on_write;
+    (void)bytes;
+    return nullptr;
+#endif
+}
+
+// Просьба к ядру подкладывать huge pages (Linux THP)
+inline void advise_huge_pages(void* p, std::size_t bytes) noexcept {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    ::madvise(p, bytes, MADV_HUGEPAGE);
+#else
+    (void)p;
+    (void)bytes;
+#endif
+}
+
+// Возвращает ядру физические страницы диапазона, сохраняя отображение:
+// память перестаёт учитываться в RSS, а при следующем обращении страницы
+// выдаются заново, заполненные нулями. Диапазон выровнен по странице
+inline bool release_pages(void* p, std::size_t bytes) noexcept {
+#if LAB3_HAS_MMAP && defined(MADV_DONTNEED)
+    return ::madvise(p, bytes, MADV_DONTNEED) == 0;
+#else
+    (void)p;
+    (void)bytes;
+    return false;
+#endif
+}
+
+} // namespace platform
+
+#endif // PLATFORM_MEMORY_H
@@ -0,0 +1,258 @@
+#ifndef POSITIONAL_INDEX_H
+#define POSITIONAL_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Позиционный индекс для связных списков: неявное декартово дерево (treap)
+// указателей на узлы, упорядоченных по позиции в списке. Поиск по номеру,
+// вставка и удаление — O(log n) в среднем; построение по готовому списку — O(n).
+//
+// Вершины дерева лежат в одном массиве и ссылаются друг на друга 32-битными
+// номерами (0 — пустая ссылка), освободившиеся вершины переиспользуются.
+template<typename Ptr>
+class PositionalIndex {
+public:
+    using size_type = std::size_t;
+
+    bool enabled() const noexcept { return enabled_; }
+
+    // Индекс включён и соответствует списку
+    bool valid() const noexcept { return enabled_ && !stale_; }
+
+    // Индекс включён, но список менялся без учёта позиций (правки по итераторам,
+    // splice, merge) — перед обращением по номеру его нужно построить заново
+    bool stale() const noexcept { return stale_; }
+
+    // Строит индекс по последовательности [first, first + count) указателей,
+    // next(p) возвращает следующий указатель
+    template<typename Next>
+    void build(Ptr first, size_type count, Next next) {
+        check_limit(count);
+        // Строим в стороне, чтобы при bad_alloc прежний индекс не пострадал
+        PositionalIndex fresh;
+        fresh.seed_ = seed_;
+        fresh.entries_.reserve(count + 1);
+        fresh.free_.reserve(count + 1);
+        fresh.entries_.push_back(Entry{});
+        for (size_type i = 0; i < count; ++i, first = next(first)) {
+            fresh.entries_.push_back(Entry{first, fresh.random_priority(), 0, 0, 1});
+        }
+        fresh.root_ = fresh.build_cartesian(count);
+        fresh.enabled_ = true;
+        swap(fresh);
+    }
+
+    void disable() noexcept {
+        enabled_ = false;
+        stale_ = false;
+        root_ = 0;
+        entries_.clear();
+        entries_.shrink_to_fit();
+        free_.clear();
+        free_.shrink_to_fit();
+    }
+
+    // Список опустел: индекс остаётся включённым
+    void reset() noexcept {
+        root_ = 0;
+        entries_.resize(entries_.empty() ? 0 : 1);
+        free_.clear();
+        stale_ = false;
+    }
+
+    void invalidate() noexcept {
+        if (!enabled_) return;
+        reset();
+        stale_ = true;
+    }
+
+    size_type size() const noexcept { return entries_.empty() ? 0 : entries_[root_].size; }
+
+    // Память, занятая вершинами и списком свободных вершин
+    size_type memory_bytes() const noexcept {
+        return entries_.capacity() * sizeof(Entry) + free_.capacity() * sizeof(Link);
+    }
+
+    Ptr at(size_type pos) const noexcept {
+        Link t = root_;
+        for (;;) {
+            size_type left = entries_[entries_[t].left].size;
+            if (pos < left) {
+                t = entries_[t].left;
+            } else if (pos == left) {
+                return entries_[t].value;
+            } else {
+                pos -= left + 1;
+                t = entries_[t].right;
+            }
+        }
+    }
+
+    // Память под вершину выделяется до перестройки дерева, поэтому
+    // при bad_alloc индекс остаётся прежним
+    void insert(size_type pos, Ptr value) {
+        Link node = new_entry(value);
+        root_ = insert_at(root_, pos, node);
+    }
+
+    void erase(size_type pos) noexcept {
+        Link left, middle, right;
+        split(root_, pos, left, right);
+        split(right, 1, middle, right);
+        free_.push_back(middle);
+        root_ = merge(left, right);
+    }
+
+    void swap(PositionalIndex& other) noexcept {
+        using std::swap;
+        swap(entries_, other.entries_);
+        swap(free_, other.free_);
+        swap(root_, other.root_);
+        swap(enabled_, other.enabled_);
+        swap(stale_, other.stale_);
+        swap(seed_, other.seed_);
+    }
+
+private:
+    using Link = std::uint32_t;
+
+    struct Entry {
+        Ptr value = nullptr;
+        std::uint32_t priority = 0;
+        Link left = 0;
+        Link right = 0;
+        Link size = 0;
+    };
+
+    // entries_[0] — пустая вершина с size == 0
+    std::vector<Entry> entries_;
+    std::vector<Link> free_;
+    Link root_ = 0;
+    bool enabled_ = false;
+    bool stale_ = false;
+    std::uint32_t seed_ = 2463534242u;
+
+    static void check_limit(size_type count) {
+        if (count >= UINT32_MAX) {
+            throw std::length_error("PositionalIndex supports up to 2^32 - 1 elements");
+        }
+    }
+
+    // xorshift32
+    std::uint32_t random_priority() noexcept {
+        seed_ ^= seed_ << 13;
+        seed_ ^= seed_ >> 17;
+        seed_ ^= seed_ << 5;
+        return seed_;
+    }
+
+    Link new_entry(Ptr value) {
+        Entry entry{value, random_priority(), 0, 0, 1};
+        if (!free_.empty()) {
+            Link node = free_.back();
+            free_.pop_back();
+            entries_[node] = entry;
+            return node;
+        }
+        if (entries_.empty()) entries_.push_back(Entry{});
+        check_limit(entries_.size());
+        // Место в free_ под каждую вершину резервируется заранее, чтобы erase не выделял память
+        if (free_.capacity() < entries_.size() + 1) free_.reserve(2 * (entries_.size() + 1));
+        entries_.push_back(entry);
+        return static_cast<Link>(entries_.size() - 1);
+    }
+
+    void update(Link t) noexcept {
+        entries_[t].size = entries_[entries_[t].left].size + entries_[entries_[t].right].size + 1;
+    }
+
+    // Первые pos элементов дерева t уходят в left, остальные — в right
+    void split(Link t, size_type pos, Link& left, Link& right) noexcept {
+        if (!t) {
+            left = right = 0;
+            return;
+        }
+        size_type left_size = entries_[entries_[t].left].size;
+        if (pos <= left_size) {
+            split(entries_[t].left, pos, left, entries_[t].left);
+            right = t;
+        } else {
+            split(entries_[t].right, pos - left_size - 1, entries_[t].right, right);
+            left = t;
+        }
+        update(t);
+    }
+
+    // Спуск до места, где приоритет новой вершины выше, и один split
+    // вместо split + двух merge
+    Link insert_at(Link t, size_type pos, Link node) noexcept {
+        if (!t) return node;
+        if (entries_[node].priority > entries_[t].priority) {
+            split(t, pos, entries_[node].left, entries_[node].right);
+            update(node);
+            return node;
+        }
+        size_type left_size = entries_[entries_[t].left].size;
+        if (pos <= left_size) {
+            entries_[t].left = insert_at(entries_[t].left, pos, node);
+        } else {
+            entries_[t].right = insert_at(entries_[t].right, pos - left_size - 1, node);
+        }
+        update(t);
+        return t;
+    }
+
+    Link merge(Link left, Link right) noexcept {
+        if (!left) return right;
+        if (!right) return left;
+        if (entries_[left].priority > entries_[right].priority) {
+            entries_[left].right = merge(entries_[left].right, right);
+            update(left);
+            return left;
+        }
+        entries_[right].left = merge(left, entries_[right].left);
+        update(right);
+        return right;
+    }
+
+    // Декартово дерево по вершинам 1..count, уже стоящим в порядке списка:
+    // правая ветвь держится на стеке, затем размеры считаются обратным обходом
+    Link build_cartesian(size_type count) {
+        std::vector<Link> stack;
+        for (Link i = 1; i <= count; ++i) {
+            Link last = 0;
+            while (!stack.empty() && entries_[stack.back()].priority < entries_[i].priority) {
+                last = stack.back();
+                stack.pop_back();
+            }
+            entries_[i].left = last;
+            if (!stack.empty()) entries_[stack.back()].right = i;
+            stack.push_back(i);
+        }
+        if (stack.empty()) return 0;
+        Link root = stack.front();
+
+        // Обратный обход без рекурсии: глубина дерева не ограничена логарифмом
+        stack.clear();
+        std::vector<Link> order;
+        order.reserve(count);
+        stack.push_back(root);
+        while (!stack.empty()) {
+            Link t = stack.back();
+            stack.pop_back();
+            order.push_back(t);
+            if (entries_[t].left) stack.push_back(entries_[t].left);
+            if (entries_[t].right) stack.push_back(entries_[t].right);
+        }
+        for (size_type i = order.size(); i-- > 0;) {
+            update(order[i]);
+        }
+        return root;
+    }
+};
+
+#endif // POSITIONAL_INDEX_H
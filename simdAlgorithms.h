@@ -0,0 +1,742 @@
+#ifndef SIMD_ALGORITHMS_H
+#define SIMD_ALGORITHMS_H
+
+#include "checkPolicy.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+// Векторизованные алгоритмы для непрерывных массивов арифметических типов:
+// поиск, подсчёт, минимум и максимум, сумма, сравнение и выборка по условию
+// (stream compaction). Работают с указателем и длиной или с любым контейнером,
+// у которого есть data() и size(): SimpleVector, SmallVector, столбец SoAVector.
+//
+//     SimpleVector<int> v = ...;
+//     std::size_t pos = simd::find(v, 42);           // v.size(), если не найден
+//     auto total = simd::sum(v);                     // сумма в int64_t
+//     simd::compact(v, simd::Compare::greater, 0);   // оставить только > 0
+//
+// Каждое ядро написано один раз на векторных расширениях GCC/Clang и
+// компилируется трижды — для SSE2, AVX2 и AVX-512 (атрибут target); набор
+// инструкций выбирается во время выполнения по возможностям процессора.
+// На других компиляторах и архитектурах, при макросе LAB3_NO_SIMD, а также
+// для long double работают обычные циклы.
+//
+// Сумма чисел с плавающей точкой накапливается по дорожкам вектора, поэтому
+// может отличаться от последовательной в последних разрядах. Минимум и
+// максимум массива с NaN не определены.
+#if !defined(LAB3_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define LAB3_SIMD_X86 1
+#define LAB3_TARGET_SSE2 __attribute__((target("sse2")))
+#define LAB3_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#define LAB3_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl,avx2,popcnt")))
+#define LAB3_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define LAB3_SIMD_X86 0
+#endif
+
+namespace simd {
+
+// Наборы инструкций по возрастанию возможностей
+enum class Isa { scalar, sse2, avx2, avx512 };
+
+// Условие выборки: элемент op value
+enum class Compare { equal, not_equal, less, less_equal, greater, greater_equal };
+
+inline const char* isa_name(Isa isa) noexcept {
+    switch (isa) {
+    case Isa::sse2: return "sse2";
+    case Isa::avx2: return "avx2";
+    case Isa::avx512: return "avx512";
+    default: return "scalar";
+    }
+}
+
+namespace simd_detail {
+
+inline Isa detect_isa() noexcept {
+#if LAB3_SIMD_X86
+    // Проверка может понадобиться до main (в статических конструкторах)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl")) {
+        return Isa::avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) return Isa::avx2;
+    if (__builtin_cpu_supports("sse2")) return Isa::sse2;
+#endif
+    return Isa::scalar;
+}
+
+inline std::atomic<Isa>& isa_limit() noexcept {
+    static std::atomic<Isa> limit{Isa::avx512};
+    return limit;
+}
+
+} // namespace simd_detail
+
+// Лучший набор инструкций, который поддерживают процессор и ОС
+inline Isa detected_isa() noexcept {
+    static const Isa isa = simd_detail::detect_isa();
+    return isa;
+}
+
+// Набор инструкций, которым пользуются алгоритмы
+inline Isa active_isa() noexcept {
+    return std::min(detected_isa(), simd_detail::isa_limit().load(std::memory_order_relaxed));
+}
+
+// Запрещает наборы инструкций старше isa — для сравнения путей в бенчмарках
+// и проверки запасных путей на новом процессоре
+inline void set_max_isa(Isa isa) noexcept {
+    simd_detail::isa_limit().store(isa, std::memory_order_relaxed);
+}
+
+// Тип суммы: целые складываются в 64 бита, числа с плавающей точкой — в своём типе
+template<typename T>
+using sum_t = std::conditional_t<std::is_floating_point_v<T>, T,
+                                 std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>;
+
+namespace simd_detail {
+
+template<typename T>
+struct Identity {
+    using type = T;
+};
+
+// Значение не участвует в выводе типа: simd::find(p, n, 0) для float* допустим
+template<typename T>
+using identity_t = typename Identity<T>::type;
+
+template<std::size_t Size, bool Signed>
+struct IntOfSize;
+
+template<> struct IntOfSize<1, true> { using type = std::int8_t; };
+template<> struct IntOfSize<1, false> { using type = std::uint8_t; };
+template<> struct IntOfSize<2, true> { using type = std::int16_t; };
+template<> struct IntOfSize<2, false> { using type = std::uint16_t; };
+template<> struct IntOfSize<4, true> { using type = std::int32_t; };
+template<> struct IntOfSize<4, false> { using type = std::uint32_t; };
+template<> struct IntOfSize<8, true> { using type = std::int64_t; };
+template<> struct IntOfSize<8, false> { using type = std::uint64_t; };
+
+// Тип дорожки вектора для T: char, long и long long сводятся к целым
+// фиксированной ширины; void — T не векторизуется
+template<typename T, typename = void>
+struct Element {
+    using type = void;
+};
+
+template<typename T>
+struct Element<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8>> {
+    using type = typename IntOfSize<sizeof(T), std::is_signed_v<T>>::type;
+};
+
+template<> struct Element<float, void> { using type = float; };
+template<> struct Element<double, void> { using type = double; };
+
+template<typename T>
+using element_t = typename Element<std::remove_cv_t<T>>::type;
+
+template<typename T>
+inline constexpr bool vectorizable_v = LAB3_SIMD_X86 && !std::is_void_v<element_t<T>>;
+
+// Наибольшее и наименьшее значения — начальные для минимума и максимума пустого массива
+template<typename T>
+constexpr T min_identity() noexcept {
+    if constexpr (std::numeric_limits<T>::has_infinity) return std::numeric_limits<T>::infinity();
+    else return std::numeric_limits<T>::max();
+}
+
+template<typename T>
+constexpr T max_identity() noexcept {
+    if constexpr (std::numeric_limits<T>::has_infinity) return -std::numeric_limits<T>::infinity();
+    else return std::numeric_limits<T>::lowest();
+}
+
+template<Compare Op, typename T>
+constexpr bool compare(T a, T b) noexcept {
+    if constexpr (Op == Compare::equal) return a == b;
+    else if constexpr (Op == Compare::not_equal) return a != b;
+    else if constexpr (Op == Compare::less) return a < b;
+    else if constexpr (Op == Compare::less_equal) return a <= b;
+    else if constexpr (Op == Compare::greater) return a > b;
+    else return a >= b;
+}
+
+// Обычные циклы: запасной путь и обработка хвоста, не кратного вектору
+
+template<typename T>
+std::size_t find_scalar(const T* p, std::size_t n, T value) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (p[i] == value) return i;
+    }
+    return n;
+}
+
+template<typename T>
+std::size_t count_scalar(const T* p, std::size_t n, T value) noexcept {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; ++i) count += p[i] == value;
+    return count;
+}
+
+template<bool Max, typename T>
+T minmax_scalar(const T* p, std::size_t n, T best) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (Max ? best < p[i] : p[i] < best) best = p[i];
+    }
+    return best;
+}
+
+// Целые складываются по модулю 2^64, как в векторном пути
+template<typename T>
+sum_t<T> sum_scalar(const T* p, std::size_t n) noexcept {
+    if constexpr (std::is_floating_point_v<T>) {
+        T sum = 0;
+        for (std::size_t i = 0; i < n; ++i) sum += p[i];
+        return sum;
+    } else {
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < n; ++i) sum += static_cast<std::uint64_t>(p[i]);
+        return static_cast<sum_t<T>>(sum);
+    }
+}
+
+template<typename T>
+std::size_t mismatch_scalar(const T* a, const T* b, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!(a[i] == b[i])) return i;
+    }
+    return n;
+}
+
+// Запись без ветвления: каждый элемент пишется на место k, а k растёт только
+// для подходящих, поэтому непредсказуемое условие не сбивает предсказатель
+template<Compare Op, typename T>
+std::size_t copy_if_scalar(const T* src, std::size_t n, T* dst, T value) noexcept {
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const T x = src[i];
+        dst[k] = x;
+        k += compare<Op>(x, value);
+    }
+    return k;
+}
+
+#if LAB3_SIMD_X86
+
+// Векторный тип из Bytes байт с дорожками E
+template<typename E, std::size_t Bytes> struct Vec;
+template<std::size_t Bytes> struct Vec<std::int8_t, Bytes> { typedef std::int8_t type __attribute__((vector_size(Bytes))); };
+template<std::size_t Bytes> struct Vec<std::uint8_t, Bytes> { typedef std::uint8_t type __attribute__((vector_size(Bytes))); };
+template<std::size_t Bytes> struct Vec<std::int16_t, Bytes> { typedef std::int16_t type __attribute__((vector_size(Bytes))); };
+template<std::size_t Bytes> struct Vec<std::uint16_t, Bytes> { typedef std::uint16_t type __attribute__((vector_size(Bytes))); };
+template<std::size_t Bytes> struct Vec<std::int32_t, Bytes> { typedef std::int32_t type __attribute__((vector_size(Bytes))); };
+template<std::size_t Bytes> struct Vec<std::uint32_t, Bytes> { typedef std::uint32_t type __attribute__((vector_size(Bytes))); };
+template<std::size_t Bytes> struct Vec<std::int64_t, Bytes> { typedef std::int64_t type __attribute__((vector_size(Bytes))); };
+template<std::size_t Bytes> struct Vec<std::uint64_t, Bytes> { typedef std::uint64_t type __attribute__((vector_size(Bytes))); };
+template<std::size_t Bytes> struct Vec<float, Bytes> { typedef float type __attribute__((vector_size(Bytes))); };
+template<std::size_t Bytes> struct Vec<double, Bytes> { typedef double type __attribute__((vector_size(Bytes))); };
+
+template<typename E, std::size_t Bytes>
+using vec_t = typename Vec<E, Bytes>::type;
+
+// Ядра — шаблоны по ширине вектора без собственного атрибута target: они
+// встраиваются в точки входа run_sse2 / run_avx2 / run_avx512 и там
+// компилируются под нужный набор инструкций. Векторы не передаются между
+// функциями (загрузка через memcpy прямо в теле), чтобы не зависеть от ABI.
+
+struct FindOp {
+    template<std::size_t Bytes, typename T>
+    static LAB3_ALWAYS_INLINE std::size_t run(const T* p, std::size_t n, T value) noexcept {
+        using E = element_t<T>;
+        using V = vec_t<E, Bytes>;
+        constexpr std::size_t L = Bytes / sizeof(E);
+        const V needle = V{} + static_cast<E>(value);
+        std::size_t i = 0;
+        // Четыре вектора за шаг: одна проверка «есть ли совпадение» на 4L элементов
+        for (; i + 4 * L <= n; i += 4 * L) {
+            V a, b, c, d;
+            std::memcpy(&a, p + i, Bytes);
+            std::memcpy(&b, p + i + L, Bytes);
+            std::memcpy(&c, p + i + 2 * L, Bytes);
+            std::memcpy(&d, p + i + 3 * L, Bytes);
+            // Маски вычитаются, а не объединяются через |: так GCC не разбирает
+            // их по дорожкам в ядре, собранном для SSE2 до встраивания
+            decltype(a == needle) hits{};
+            hits -= (a == needle);
+            hits -= (b == needle);
+            hits -= (c == needle);
+            hits -= (d == needle);
+            std::uint64_t words[Bytes / 8];
+            std::memcpy(words, &hits, Bytes);
+            std::uint64_t any = 0;
+            for (std::uint64_t word : words) any |= word;
+            if (any) break;
+        }
+        return i + find_scalar(p + i, n - i, value);
+    }
+
+    template<typename T>
+    static std::size_t scalar(const T* p, std::size_t n, T value) noexcept { return find_scalar(p, n, value); }
+};
+
+struct CountOp {
+    template<std::size_t Bytes, typename T>
+    static LAB3_ALWAYS_INLINE std::size_t run(const T* p, std::size_t n, T value) noexcept {
+        using E = element_t<T>;
+        using V = vec_t<E, Bytes>;
+        using M = decltype(V{} == V{});
+        using Lane = std::remove_cv_t<std::remove_reference_t<decltype(M{}[0])>>;
+        constexpr std::size_t L = Bytes / sizeof(E);
+        // Совпадение даёт -1 в дорожке; счётчики дорожек сбрасываются
+        // в общий раньше, чем переполнятся (для 8-битных — каждые 127 шагов)
+        constexpr std::size_t kFlush = static_cast<std::size_t>(
+            std::min<std::uint64_t>(std::numeric_limits<Lane>::max(), std::uint64_t(1) << 32));
+        const V needle = V{} + static_cast<E>(value);
+        std::size_t count = 0;
+        std::size_t i = 0;
+        while (i + L <= n) {
+            M acc{};
+            const std::size_t steps = std::min((n - i) / L, kFlush);
+            for (std::size_t s = 0; s < steps; ++s, i += L) {
+                V x;
+                std::memcpy(&x, p + i, Bytes);
+                acc -= (x == needle);
+            }
+            for (std::size_t k = 0; k < L; ++k) count += static_cast<std::size_t>(acc[k]);
+        }
+        return count + count_scalar(p + i, n - i, value);
+    }
+
+    template<typename T>
+    static std::size_t scalar(const T* p, std::size_t n, T value) noexcept { return count_scalar(p, n, value); }
+};
+
+template<bool Max>
+struct MinMaxOp {
+    // n > 0
+    template<std::size_t Bytes, typename T>
+    static LAB3_ALWAYS_INLINE T run(const T* p, std::size_t n) noexcept {
+        using E = element_t<T>;
+        using V = vec_t<E, Bytes>;
+        constexpr std::size_t L = Bytes / sizeof(E);
+        if (n < 2 * L) return scalar(p, n);
+        // Два аккумулятора скрывают задержку сравнения; дорожки читаются
+        // из копии, чтобы сами аккумуляторы остались в регистрах
+        V first, second;
+        std::memcpy(&first, p, Bytes);
+        std::memcpy(&second, p + L, Bytes);
+        V best0 = first, best1 = second;
+        std::size_t i = 2 * L;
+        for (; i + 2 * L <= n; i += 2 * L) {
+            V a, b;
+            std::memcpy(&a, p + i, Bytes);
+            std::memcpy(&b, p + i + L, Bytes);
+            if constexpr (Max) {
+                best0 = best0 < a ? a : best0;
+                best1 = best1 < b ? b : best1;
+            } else {
+                best0 = a < best0 ? a : best0;
+                best1 = b < best1 ? b : best1;
+            }
+        }
+        if constexpr (Max) best0 = best0 < best1 ? best1 : best0;
+        else best0 = best1 < best0 ? best1 : best0;
+        E lanes[L];
+        std::memcpy(lanes, &best0, Bytes);
+        T result = static_cast<T>(lanes[0]);
+        for (std::size_t k = 1; k < L; ++k) {
+            const T lane = static_cast<T>(lanes[k]);
+            if (Max ? result < lane : lane < result) result = lane;
+        }
+        return minmax_scalar<Max>(p + i, n - i, result);
+    }
+
+    template<typename T>
+    static T scalar(const T* p, std::size_t n) noexcept { return minmax_scalar<Max>(p + 1, n - 1, p[0]); }
+};
+
+struct SumOp {
+    template<std::size_t Bytes, typename T>
+    static LAB3_ALWAYS_INLINE sum_t<T> run(const T* p, std::size_t n) noexcept {
+        using E = element_t<T>;
+        std::size_t i = 0;
+        if constexpr (std::is_floating_point_v<E>) {
+            using V = vec_t<E, Bytes>;
+            constexpr std::size_t L = Bytes / sizeof(E);
+            // Два независимых аккумулятора скрывают задержку сложения
+            V acc0{}, acc1{};
+            for (; i + 2 * L <= n; i += 2 * L) {
+                V a, b;
+                std::memcpy(&a, p + i, Bytes);
+                std::memcpy(&b, p + i + L, Bytes);
+                acc0 += a;
+                acc1 += b;
+            }
+            acc0 += acc1;
+            E lanes[L];
+            std::memcpy(lanes, &acc0, Bytes);
+            T sum = 0;
+            for (E lane : lanes) sum += lane;
+            return sum + sum_scalar(p + i, n - i);
+        } else {
+            // Соседние дорожки попарно складываются в дорожки вдвое шире, пока
+            // не станут 64-битными: маски, логические сдвиги и сложения на всю
+            // ширину вектора есть и в SSE2, в отличие от расширяющих
+            // преобразований. Знаковые сначала сдвигаются в беззнаковые
+            // инверсией старшего бита, а смещение вычитается из суммы в конце.
+            // Вся арифметика идёт по модулю 2^64
+            using UE = std::make_unsigned_t<E>;
+            using U = vec_t<UE, Bytes>;
+            using U16 = vec_t<std::uint16_t, Bytes>;
+            using U32 = vec_t<std::uint32_t, Bytes>;
+            using U64 = vec_t<std::uint64_t, Bytes>;
+            constexpr std::size_t L = Bytes / sizeof(E);
+            constexpr UE kBias = std::is_signed_v<E> && sizeof(E) < 8 ? UE(UE(1) << (8 * sizeof(E) - 1)) : UE(0);
+            U64 acc{};
+            for (; i + L <= n; i += L) {
+                U x;
+                std::memcpy(&x, p + i, Bytes);
+                x ^= kBias;
+                U16 w16 = (U16)x;
+                if constexpr (sizeof(E) == 1) w16 = (w16 & 0xFF) + (w16 >> 8);
+                U32 w32 = (U32)w16;
+                if constexpr (sizeof(E) <= 2) w32 = (w32 & 0xFFFF) + (w32 >> 16);
+                U64 w64 = (U64)w32;
+                if constexpr (sizeof(E) <= 4) w64 = (w64 & 0xFFFFFFFF) + (w64 >> 32);
+                acc += w64;
+            }
+            std::uint64_t lanes[Bytes / 8];
+            std::memcpy(lanes, &acc, Bytes);
+            std::uint64_t sum = 0;
+            for (std::uint64_t lane : lanes) sum += lane;
+            sum -= static_cast<std::uint64_t>(i) * kBias;
+            return static_cast<sum_t<T>>(sum + static_cast<std::uint64_t>(sum_scalar(p + i, n - i)));
+        }
+    }
+
+    template<typename T>
+    static sum_t<T> scalar(const T* p, std::size_t n) noexcept { return sum_scalar(p, n); }
+};
+
+struct MismatchOp {
+    template<std::size_t Bytes, typename T>
+    static LAB3_ALWAYS_INLINE std::size_t run(const T* a, const T* b, std::size_t n) noexcept {
+        using E = element_t<T>;
+        using V = vec_t<E, Bytes>;
+        constexpr std::size_t L = Bytes / sizeof(E);
+        std::size_t i = 0;
+        for (; i + 2 * L <= n; i += 2 * L) {
+            V a0, a1, b0, b1;
+            std::memcpy(&a0, a + i, Bytes);
+            std::memcpy(&a1, a + i + L, Bytes);
+            std::memcpy(&b0, b + i, Bytes);
+            std::memcpy(&b1, b + i + L, Bytes);
+            // != верно и для NaN — как !(x == y) в обычном цикле
+            decltype(a0 != b0) diff{};
+            diff -= (a0 != b0);
+            diff -= (a1 != b1);
+            std::uint64_t words[Bytes / 8];
+            std::memcpy(words, &diff, Bytes);
+            std::uint64_t any = 0;
+            for (std::uint64_t word : words) any |= word;
+            if (any) break;
+        }
+        return i + mismatch_scalar(a + i, b + i, n - i);
+    }
+
+    template<typename T>
+    static std::size_t scalar(const T* a, const T* b, std::size_t n) noexcept { return mismatch_scalar(a, b, n); }
+};
+
+// Выборка на AVX-512 для 4- и 8-байтных дорожек: маска сравнения и
+// vpcompress записывают подходящие элементы подряд одной инструкцией
+template<Compare Op, typename T>
+LAB3_TARGET_AVX512 std::size_t compress_avx512(const T* src, std::size_t n, T* dst, T value) noexcept {
+    using E = element_t<T>;
+    using V = vec_t<E, 64>;
+    constexpr std::size_t L = 64 / sizeof(E);
+    const V needle = V{} + static_cast<E>(value);
+    std::size_t k = 0;
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+        V x;
+        std::memcpy(&x, src + i, 64);
+        V mask;
+        if constexpr (Op == Compare::equal) mask = (V)(x == needle);
+        else if constexpr (Op == Compare::not_equal) mask = (V)(x != needle);
+        else if constexpr (Op == Compare::less) mask = (V)(x < needle);
+        else if constexpr (Op == Compare::less_equal) mask = (V)(x <= needle);
+        else if constexpr (Op == Compare::greater) mask = (V)(x > needle);
+        else mask = (V)(x >= needle);
+        const __m512i bits = (__m512i)mask;
+        if constexpr (sizeof(E) == 4) {
+            const __mmask16 keep = _mm512_test_epi32_mask(bits, bits);
+            _mm512_mask_compressstoreu_epi32(dst + k, keep, (__m512i)x);
+            k += static_cast<std::size_t>(__builtin_popcount(keep));
+        } else {
+            const __mmask8 keep = _mm512_test_epi64_mask(bits, bits);
+            _mm512_mask_compressstoreu_epi64(dst + k, keep, (__m512i)x);
+            k += static_cast<std::size_t>(__builtin_popcount(keep));
+        }
+    }
+    return k + copy_if_scalar<Op>(src + i, n - i, dst + k, value);
+}
+
+template<Compare Op>
+struct CopyIfOp {
+    template<std::size_t Bytes, typename T>
+    static LAB3_ALWAYS_INLINE std::size_t run(const T* src, std::size_t n, T* dst, T value) noexcept {
+        using E = element_t<T>;
+        if constexpr (Bytes == 64 && (sizeof(E) == 4 || sizeof(E) == 8)) {
+            return compress_avx512<Op>(src, n, dst, value);
+        } else if constexpr (sizeof(E) < 4) {
+            // Разбор узких дорожек по одной дороже цикла без ветвлений, а
+            // vpcompressb/w есть только в AVX-512 VBMI2
+            return copy_if_scalar<Op>(src, n, dst, value);
+        } else {
+            // Маска считается вектором, запись — без ветвлений по дорожкам
+            using V = vec_t<E, Bytes>;
+            constexpr std::size_t L = Bytes / sizeof(E);
+            const V needle = V{} + static_cast<E>(value);
+            std::size_t k = 0;
+            std::size_t i = 0;
+            for (; i + L <= n; i += L) {
+                V x;
+                std::memcpy(&x, src + i, Bytes);
+                decltype(x == needle) mask;
+                if constexpr (Op == Compare::equal) mask = x == needle;
+                else if constexpr (Op == Compare::not_equal) mask = x != needle;
+                else if constexpr (Op == Compare::less) mask = x < needle;
+                else if constexpr (Op == Compare::less_equal) mask = x <= needle;
+                else if constexpr (Op == Compare::greater) mask = x > needle;
+                else mask = x >= needle;
+                for (std::size_t j = 0; j < L; ++j) {
+                    const E lane = x[j];
+                    std::memcpy(dst + k, &lane, sizeof(E));
+                    k += static_cast<std::size_t>(mask[j] & 1);
+                }
+            }
+            return k + copy_if_scalar<Op>(src + i, n - i, dst + k, value);
+        }
+    }
+
+    template<typename T>
+    static std::size_t scalar(const T* src, std::size_t n, T* dst, T value) noexcept {
+        return copy_if_scalar<Op>(src, n, dst, value);
+    }
+};
+
+// Точки входа под каждый набор инструкций
+template<typename Op, typename... Args>
+LAB3_TARGET_SSE2 auto run_sse2(Args... args) noexcept {
+    return Op::template run<16>(args...);
+}
+
+template<typename Op, typename... Args>
+LAB3_TARGET_AVX2 auto run_avx2(Args... args) noexcept {
+    return Op::template run<32>(args...);
+}
+
+template<typename Op, typename... Args>
+LAB3_TARGET_AVX512 auto run_avx512(Args... args) noexcept {
+    return Op::template run<64>(args...);
+}
+
+#endif // LAB3_SIMD_X86
+
+// Выбор пути по типу элемента и набору инструкций процессора
+template<typename Op, typename T, typename... Args>
+auto dispatch(Args... args) noexcept {
+#if LAB3_SIMD_X86
+    if constexpr (vectorizable_v<T>) {
+        switch (active_isa()) {
+        case Isa::avx512: return run_avx512<Op>(args...);
+        case Isa::avx2: return run_avx2<Op>(args...);
+        case Isa::sse2: return run_sse2<Op>(args...);
+        default: break;
+        }
+    }
+#endif
+    return Op::scalar(args...);
+}
+
+#if !LAB3_SIMD_X86
+// Без векторных ядер точки выбора те же, работают обычные циклы
+struct FindOp {
+    template<typename T>
+    static std::size_t scalar(const T* p, std::size_t n, T value) noexcept { return find_scalar(p, n, value); }
+};
+
+struct CountOp {
+    template<typename T>
+    static std::size_t scalar(const T* p, std::size_t n, T value) noexcept { return count_scalar(p, n, value); }
+};
+
+template<bool Max>
+struct MinMaxOp {
+    template<typename T>
+    static T scalar(const T* p, std::size_t n) noexcept { return minmax_scalar<Max>(p + 1, n - 1, p[0]); }
+};
+
+struct SumOp {
+    template<typename T>
+    static sum_t<T> scalar(const T* p, std::size_t n) noexcept { return sum_scalar(p, n); }
+};
+
+struct MismatchOp {
+    template<typename T>
+    static std::size_t scalar(const T* a, const T* b, std::size_t n) noexcept { return mismatch_scalar(a, b, n); }
+};
+
+template<Compare Op>
+struct CopyIfOp {
+    template<typename T>
+    static std::size_t scalar(const T* src, std::size_t n, T* dst, T value) noexcept {
+        return copy_if_scalar<Op>(src, n, dst, value);
+    }
+};
+#endif // !LAB3_SIMD_X86
+
+template<Compare Op, typename T>
+std::size_t copy_if_dispatch(const T* src, std::size_t n, T* dst, T value) noexcept {
+    return dispatch<CopyIfOp<Op>, T>(src, n, dst, value);
+}
+
+template<typename T>
+inline constexpr bool supported_v = std::is_arithmetic_v<T> && !std::is_same_v<std::remove_cv_t<T>, bool>;
+
+} // namespace simd_detail
+
+// Алгоритмы над массивом [p, p + n)
+
+// Номер первого элемента, равного value; n, если такого нет
+template<typename T>
+std::size_t find(const T* p, std::size_t n, simd_detail::identity_t<T> value) noexcept {
+    static_assert(simd_detail::supported_v<T>, "simd algorithms need an arithmetic element type");
+    return simd_detail::dispatch<simd_detail::FindOp, T>(p, n, value);
+}
+
+template<typename T>
+std::size_t count(const T* p, std::size_t n, simd_detail::identity_t<T> value) noexcept {
+    static_assert(simd_detail::supported_v<T>, "simd algorithms need an arithmetic element type");
+    return simd_detail::dispatch<simd_detail::CountOp, T>(p, n, value);
+}
+
+// Минимум; для пустого массива — наибольшее значение типа (+inf для чисел с плавающей точкой)
+template<typename T>
+T min(const T* p, std::size_t n) noexcept {
+    static_assert(simd_detail::supported_v<T>, "simd algorithms need an arithmetic element type");
+    if (LAB3_UNLIKELY(n == 0)) return simd_detail::min_identity<T>();
+    return simd_detail::dispatch<simd_detail::MinMaxOp<false>, T>(p, n);
+}
+
+// Максимум; для пустого массива — наименьшее значение типа (-inf для чисел с плавающей точкой)
+template<typename T>
+T max(const T* p, std::size_t n) noexcept {
+    static_assert(simd_detail::supported_v<T>, "simd algorithms need an arithmetic element type");
+    if (LAB3_UNLIKELY(n == 0)) return simd_detail::max_identity<T>();
+    return simd_detail::dispatch<simd_detail::MinMaxOp<true>, T>(p, n);
+}
+
+template<typename T>
+sum_t<T> sum(const T* p, std::size_t n) noexcept {
+    static_assert(simd_detail::supported_v<T>, "simd algorithms need an arithmetic element type");
+    return simd_detail::dispatch<simd_detail::SumOp, T>(p, n);
+}
+
+// Номер первой позиции, где a и b различаются; n, если массивы равны
+template<typename T>
+std::size_t mismatch(const T* a, const T* b, std::size_t n) noexcept {
+    static_assert(simd_detail::supported_v<T>, "simd algorithms need an arithmetic element type");
+    return simd_detail::dispatch<simd_detail::MismatchOp, T>(a, b, n);
+}
+
+template<typename T>
+bool equal(const T* a, const T* b, std::size_t n) noexcept {
+    return simd::mismatch(a, b, n) == n;
+}
+
+// Копирует в dst элементы x, для которых верно x op value, сохраняя порядок;
+// возвращает их число. В dst должно быть место под n элементов; dst может
+// совпадать с src (выборка на месте), но не начинаться дальше него
+template<typename T>
+std::size_t copy_if(const T* src, std::size_t n, T* dst, Compare op, simd_detail::identity_t<T> value) noexcept {
+    static_assert(simd_detail::supported_v<T>, "simd algorithms need an arithmetic element type");
+    using simd_detail::copy_if_dispatch;
+    switch (op) {
+    case Compare::equal: return copy_if_dispatch<Compare::equal>(src, n, dst, value);
+    case Compare::not_equal: return copy_if_dispatch<Compare::not_equal>(src, n, dst, value);
+    case Compare::less: return copy_if_dispatch<Compare::less>(src, n, dst, value);
+    case Compare::less_equal: return copy_if_dispatch<Compare::less_equal>(src, n, dst, value);
+    case Compare::greater: return copy_if_dispatch<Compare::greater>(src, n, dst, value);
+    default: return copy_if_dispatch<Compare::greater_equal>(src, n, dst, value);
+    }
+}
+
+// Те же алгоритмы для непрерывных контейнеров с data() и size()
+
+template<typename Range>
+std::size_t find(const Range& r, typename Range::value_type value) noexcept {
+    return simd::find(r.data(), r.size(), value);
+}
+
+template<typename Range>
+std::size_t count(const Range& r, typename Range::value_type value) noexcept {
+    return simd::count(r.data(), r.size(), value);
+}
+
+template<typename Range>
+typename Range::value_type min(const Range& r) noexcept {
+    return simd::min(r.data(), r.size());
+}
+
+template<typename Range>
+typename Range::value_type max(const Range& r) noexcept {
+    return simd::max(r.data(), r.size());
+}
+
+template<typename Range>
+sum_t<typename Range::value_type> sum(const Range& r) noexcept {
+    return simd::sum(r.data(), r.size());
+}
+
+// Номер первого различия; при разной длине — не больше длины короткого
+template<typename Range>
+std::size_t mismatch(const Range& a, const Range& b) noexcept {
+    return simd::mismatch(a.data(), b.data(), std::min<std::size_t>(a.size(), b.size()));
+}
+
+template<typename Range>
+bool equal(const Range& a, const Range& b) noexcept {
+    return a.size() == b.size() && simd::equal(a.data(), b.data(), a.size());
+}
+
+// Новый контейнер из элементов x, для которых верно x op value
+template<typename Vector>
+Vector filter(const Vector& v, Compare op, typename Vector::value_type value) {
+    Vector result;
+    result.resize(v.size());
+    result.resize(simd::copy_if(v.data(), v.size(), result.data(), op, value));
+    return result;
+}
+
+// Оставляет в v только элементы x, для которых верно x op value; новый размер
+template<typename Vector>
+std::size_t compact(Vector& v, Compare op, typename Vector::value_type value) {
+    const std::size_t kept = simd::copy_if(v.data(), v.size(), v.data(), op, value);
+    v.resize(kept);
+    return kept;
+}
+
+} // namespace simd
+
+#endif // SIMD_ALGORITHMS_H
@@ -1,22 +1,45 @@
 #ifndef SIMPLE_VECTOR_H
 #define SIMPLE_VECTOR_H
 
-#include "baseContainer.h"
+#include "staticContainer.h"
+#include "checkPolicy.h"
+#include "containerTraits.h"
+#include "growthPolicy.h"
+#include "platformMemory.h"
+#include "binaryIO.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
 #include <utility>
 #include <stdexcept>
 #include <algorithm>
 #include <initializer_list>
+#include <iostream>
 #include <iterator>
+#include <limits>
 #include <new>
+#include <type_traits>
+
+template<typename T, std::size_t N, typename GrowthPolicy, typename CheckPolicy>
+class SmallVector;
+
+template<typename T, typename GrowthPolicy = DefaultGrowthPolicy,
+         typename CheckPolicy = DefaultCheckPolicy>
+class SimpleVector : public StaticContainer<SimpleVector<T, GrowthPolicy, CheckPolicy>, T> {
+    using Interface = StaticContainer<SimpleVector<T, GrowthPolicy, CheckPolicy>, T>;
+    
+    // Иначе уменьшенный буфер сразу снова оказывался бы заполнен меньше
+    // чем на shrink_fraction и уменьшался при каждом erase
+    static_assert(GrowthPolicy::shrink_fraction * GrowthPolicy::factor < 1.0,
+                  "shrink_fraction * factor must be below 1");
 
-template<typename T>
-class SimpleVector : public BaseContainer<T> {
 public:
-    using value_type = typename BaseContainer<T>::value_type;
-    using size_type = typename BaseContainer<T>::size_type;
-    using reference = typename BaseContainer<T>::reference;
-    using const_reference = typename BaseContainer<T>::const_reference;
+    using value_type = typename Interface::value_type;
+    using size_type = typename Interface::size_type;
+    using reference = typename Interface::reference;
+    using const_reference = typename Interface::const_reference;
     using difference_type = std::ptrdiff_t;
     using pointer = T*;
     using const_pointer = const T*;
@@ -127,7 +150,7 @@ public:
     SimpleVector(std::initializer_list<T> init) : size_(init.size()), capacity_(init.size()) {
         if (capacity_ > 0) {
             // Выделяем сырую память
-            data_ = static_cast<T*>(::operator new(capacity_ * sizeof(T)));
+            data_ = allocate_storage(capacity_);
             size_type i = 0;
             try {
                 for (auto it = init.begin(); it != init.end(); ++it, ++i) {
@@ -138,16 +161,17 @@ public:
                 for (size_type j = 0; j < i; ++j) {
                     data_[j].~T();
                 }
-                ::operator delete(data_);
+                deallocate_storage(data_, capacity_);
                 throw;
             }
+            this->stats_capacity(capacity_);
         }
     }
     
     // Конструктор копирования
     SimpleVector(const SimpleVector& other) : size_(other.size_), capacity_(other.size_) {
         if (capacity_ > 0) {
-            data_ = static_cast<T*>(::operator new(capacity_ * sizeof(T)));
+            data_ = allocate_storage(capacity_);
             size_type i = 0;
             try {
                 for (; i < size_; ++i) {
@@ -157,18 +181,27 @@ public:
                 for (size_type j = 0; j < i; ++j) {
                     data_[j].~T();
                 }
-                ::operator delete(data_);
+                deallocate_storage(data_, capacity_);
                 throw;
             }
+            this->stats_capacity(capacity_);
         }
     }
     
-    // Конструктор перемещения
-    SimpleVector(SimpleVector&& other) noexcept
-        : size_(other.size_), capacity_(other.capacity_), data_(other.data_) {
-        other.size_ = 0;
-        other.capacity_ = 0;
-        other.data_ = nullptr;
+    // Конструктор перемещения: буфер из кучи забирается целиком. Через
+    // SimpleVector&& может прийти и SmallVector со встроенным буфером — его
+    // элементы переносятся в новый буфер из кучи, поэтому конструктор не
+    // noexcept. SmallVector известного типа попадает в перегрузку ниже
+    SimpleVector(SimpleVector&& other) {
+        take(other);
+    }
+    
+    // Элементы из встроенного буфера SmallVector переносятся поштучно в новый
+    // буфер из кучи, поэтому такое перемещение может бросить bad_alloc
+    template<std::size_t N>
+    SimpleVector(SmallVector<T, N, GrowthPolicy, CheckPolicy>&& other) {
+        take(other);
+        other.shrink_to_fit();  // пустой other возвращается во встроенный буфер
     }
     
     // Оператор присваивания копированием
@@ -180,17 +213,21 @@ public:
         return *this;
     }
     
-    // Оператор присваивания перемещением
-    SimpleVector& operator=(SimpleVector&& other) noexcept {
+    // Оператор присваивания перемещением; не noexcept по той же причине
+    SimpleVector& operator=(SimpleVector&& other) {
         if (this != &other) {
             clear_memory();
-            size_ = other.size_;
-            capacity_ = other.capacity_;
-            data_ = other.data_;
-            
-            other.size_ = 0;
-            other.capacity_ = 0;
-            other.data_ = nullptr;
+            take(other);
+        }
+        return *this;
+    }
+    
+    template<std::size_t N>
+    SimpleVector& operator=(SmallVector<T, N, GrowthPolicy, CheckPolicy>&& other) {
+        if (this != &other) {
+            clear_memory();
+            take(other);
+            other.shrink_to_fit();
         }
         return *this;
     }
@@ -199,104 +236,284 @@ public:
         clear_memory();
     }
     
-    // Реализация методов BaseContainer
-    size_type size() const noexcept override { return size_; }
-    bool empty() const noexcept override { return size_ == 0; }
+    // Интерфейс последовательного контейнера (is_sequence_container)
+    size_type size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
     
-    void clear() override {
+    // С политикой уменьшения буфер освобождается; большой отображённый буфер
+    // остаётся зарезервированным, но его страницы возвращаются ядру
+    void clear() {
         destroy_elements();
         size_ = 0;
+        if constexpr (AUTO_SHRINK) release_unused();
     }
     
-    void push_back(const T& value) override {
-        ensure_capacity(size_ + 1);
-        new (&data_[size_]) T(value);
-        ++size_;
+    void push_back(const T& value) {
+        emplace_back(value);
     }
     
-    void push_back(T&& value) override {
-        ensure_capacity(size_ + 1);
-        new (&data_[size_]) T(std::move(value));
-        ++size_;
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
     }
     
-    void insert(size_type pos, const T& value) override {
+    void insert(size_type pos, const T& value) {
         this->check_position(pos, size_);
-        ensure_capacity(size_ + 1);
         
         if (pos == size_) {
             // Вставка в конец
-            new (&data_[size_]) T(value);
+            emplace_back(value);
         } else {
-            // Вставка в середину или начало
-            // Создаем новый элемент в конце
-            new (&data_[size_]) T(std::move(data_[size_ - 1]));
-            
-            // Сдвигаем элементы вправо
-            for (size_type i = size_; i > pos; --i) {
-                data_[i] = std::move(data_[i - 1]);
-            }
-            
-            // Вставляем новый элемент
-            data_[pos] = value;
+            // value может ссылаться на элемент этого же вектора, поэтому копируем до сдвига
+            insert_shift(pos, T(value));
         }
-        ++size_;
     }
     
-    void insert(size_type pos, T&& value) override {
+    void insert(size_type pos, T&& value) {
         this->check_position(pos, size_);
-        ensure_capacity(size_ + 1);
         
         if (pos == size_) {
             // Вставка в конец
-            new (&data_[size_]) T(std::move(value));
+            emplace_back(std::move(value));
+        } else if (size_ == capacity()) {
+            // Переаллокация переместит элементы, на которые может ссылаться value
+            insert_shift(pos, T(std::move(value)));
         } else {
-            // Вставка в середину или начало
-            // Создаем новый элемент в конце
-            new (&data_[size_]) T(std::move(data_[size_ - 1]));
-            
-            // Сдвигаем элементы вправо
-            for (size_type i = size_; i > pos; --i) {
-                data_[i] = std::move(data_[i - 1]);
-            }
-            
-            // Вставляем новый элемент
-            data_[pos] = std::move(value);
+            insert_shift(pos, std::move(value));
         }
-        ++size_;
     }
     
-    void erase(size_type pos) override {
+    void erase(size_type pos) {
         this->check_index(pos, size_);
         
         // Уничтожаем элемент на позиции pos
         data_[pos].~T();
         
         // Сдвигаем элементы влево
-        for (size_type i = pos; i < size_ - 1; ++i) {
-            new (&data_[i]) T(std::move(data_[i + 1]));
-            data_[i + 1].~T();
+        this->stats_shift(size_ - pos - 1);
+        if constexpr (is_trivially_relocatable_v<T>) {
+            relocate_bytes(data_ + pos, data_ + pos + 1, size_ - pos - 1);
+        } else {
+            for (size_type i = pos; i < size_ - 1; ++i) {
+                new (&data_[i]) T(std::move(data_[i + 1]));
+                data_[i + 1].~T();
+            }
         }
         
         --size_;
+        if constexpr (AUTO_SHRINK) release_unused();
+    }
+    
+    // Номер проверяется по CheckPolicy; без проверки цикл по номерам векторизуется
+    reference operator[](size_type idx) {
+        if constexpr (CheckPolicy::check_index) {
+            this->check_index(idx, size_);
+        }
+        return data_[idx];
+    }
+    
+    const_reference operator[](size_type idx) const {
+        if constexpr (CheckPolicy::check_index) {
+            this->check_index(idx, size_);
+        }
+        return data_[idx];
     }
     
-    reference operator[](size_type idx) override {
+    // Доступ с проверкой номера при любой политике
+    reference at(size_type idx) {
         this->check_index(idx, size_);
         return data_[idx];
     }
     
-    const_reference operator[](size_type idx) const override {
+    const_reference at(size_type idx) const {
         this->check_index(idx, size_);
         return data_[idx];
     }
     
-    void print(std::ostream& os = std::cout) const override {
+    // Непрерывный буфер элементов; nullptr, если память ещё не выделялась
+    pointer data() noexcept { return data_; }
+    const_pointer data() const noexcept { return data_; }
+    
+    void print(std::ostream& os = std::cout) const {
         for (size_type i = 0; i < size_; ++i) {
             os << data_[i];
             if (i != size_ - 1) os << " ";
         }
     }
+
+    // Двоичное сохранение (формат описан в binaryIO.h). Ошибки записи, как
+    // и у print, остаются в состоянии потока
+    void save(std::ostream& os) const {
+        binary::write_header<T>(os, size_);
+        binary::write_elements(os, data_, size_);
+    }
+
+    // Заменяет содержимое сохранённым через save любого контейнера с теми же
+    // элементами. Бросает binary::format_error на чужом или обрезанном файле;
+    // при исключении вектор не меняется. Тривиально копируемые элементы
+    // читаются прямо в буфер, выделенный один раз под всё содержимое
+    void load(std::istream& is) {
+        std::uint64_t remaining = 0;
+        const std::uint64_t count = binary::read_header<T>(is, remaining);
+        if (LAB3_UNLIKELY(count > std::numeric_limits<size_type>::max())) throw std::bad_alloc();
+        SimpleVector loaded;
+        loaded.reserve(static_cast<size_type>(count));
+        if constexpr (binary::Serializer<T>::codec == binary::Codec::raw) {
+            constexpr size_type per_chunk = std::max<size_type>(1, (size_type(1) << 20) / sizeof(T));
+            while (loaded.size_ < count) {
+                const size_type n = std::min<size_type>(static_cast<size_type>(count) - loaded.size_, per_chunk);
+                binary::binary_detail::read_bytes(is, loaded.data_ + loaded.size_, n * sizeof(T));
+                loaded.size_ += n;
+            }
+        } else {
+            binary::read_elements<T>(is, count, remaining,
+                                     [&loaded](T&& value) { loaded.push_back(std::move(value)); });
+        }
+        swap(loaded);
+    }
+
+    // Отображение файла, сохранённого через save, без чтения и копирования:
+    // map_view — только для чтения, map_private — с копированием изменённых
+    // страниц (файл не меняется). Только для тривиально копируемых T
+    static binary::MappedArray<const T> map_view(const std::string& path) {
+        return binary::MappedArray<const T>::open(path);
+    }
+
+    static binary::MappedArray<T> map_private(const std::string& path) {
+        return binary::MappedArray<T>::open(path);
+    }
+
+    // Конструирование на месте
+    template<typename... Args>
+    reference emplace_back(Args&&... args) {
+        if (size_ == capacity()) {
+            // Аргументы могут ссылаться на элементы вектора — создаём объект до переаллокации
+            T value(std::forward<Args>(args)...);
+            ensure_capacity(size_ + 1);
+            new (&data_[size_]) T(std::move(value));
+        } else {
+            new (&data_[size_]) T(std::forward<Args>(args)...);
+        }
+        return data_[size_++];
+    }
+    
+    template<typename... Args>
+    reference emplace(size_type pos, Args&&... args) {
+        this->check_position(pos, size_);
+        if (pos == size_) {
+            return emplace_back(std::forward<Args>(args)...);
+        }
+        insert(pos, T(std::forward<Args>(args)...));
+        return data_[pos];
+    }
+    
+    // Групповые операции: один сдвиг хвоста и не больше одной переаллокации
+    void insert(size_type pos, size_type count, const T& value) {
+        this->check_position(pos, size_);
+        if (count == 0) return;
+        const T copy(value);
+        insert_gap(pos, count, [&copy](T* slot, size_type) { new (slot) T(copy); });
+    }
+    
+    template<typename InputIt, typename = std::enable_if_t<is_iterator_v<InputIt>>>
+    void insert(size_type pos, InputIt first, InputIt last) {
+        this->check_position(pos, size_);
+        using category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+            auto count = static_cast<size_type>(std::distance(first, last));
+            if (count == 0) return;
+            insert_gap(pos, count, [&first](T* slot, size_type) {
+                new (slot) T(*first);
+                ++first;
+            });
+        } else {
+            // Длина однопроходного диапазона заранее неизвестна
+            SimpleVector buffer;
+            for (; first != last; ++first) buffer.emplace_back(*first);
+            insert(pos, std::make_move_iterator(buffer.begin()), std::make_move_iterator(buffer.end()));
+        }
+    }
+    
+    void insert(size_type pos, std::initializer_list<T> init) {
+        insert(pos, init.begin(), init.end());
+    }
+    
+    // Удаление диапазона индексов [first, last)
+    void erase(size_type first, size_type last) {
+        this->check_position(last, size_);
+        this->check_position(first, last, "Invalid erase range");
+        size_type count = last - first;
+        if (count == 0) return;
+        destroy_range(data_ + first, count);
+        this->stats_shift(size_ - last);
+        relocate_range(data_ + first, data_ + last, size_ - last);
+        size_ -= count;
+        if constexpr (AUTO_SHRINK) release_unused();
+    }
+    
+    void assign(size_type count, const T& value) {
+        const T copy(value);
+        // Буфер переиспользуется, даже если политика уменьшает его в clear()
+        destroy_elements();
+        size_ = 0;
+        if (count > capacity()) change_capacity(count);
+        insert_gap(0, count, [&copy](T* slot, size_type) { new (slot) T(copy); });
+    }
+    
+    template<typename InputIt, typename = std::enable_if_t<is_iterator_v<InputIt>>>
+    void assign(InputIt first, InputIt last) {
+        destroy_elements();
+        size_ = 0;
+        insert(0, first, last);
+    }
+    
+    void assign(std::initializer_list<T> init) {
+        assign(init.begin(), init.end());
+    }
+    
+    void resize(size_type new_size) {
+        if (new_size <= size_) {
+            erase(new_size, size_);
+            return;
+        }
+        ensure_capacity(new_size);
+        insert_gap(size_, new_size - size_, [](T* slot, size_type) { new (slot) T(); });
+    }
+    
+    // Как resize, но новые элементы инициализируются по умолчанию: у
+    // тривиальных типов они остаются незаполненными, и буфер под чтение
+    // файла или вызов read не обнуляется зря перед перезаписью
+    void resize_for_overwrite(size_type new_size) {
+        if (new_size <= size_) {
+            erase(new_size, size_);
+            return;
+        }
+        ensure_capacity(new_size);
+        insert_gap(size_, new_size - size_, [](T* slot, size_type) { new (slot) T; });
+    }
+
+    void resize(size_type new_size, const T& value) {
+        if (new_size <= size_) {
+            erase(new_size, size_);
+            return;
+        }
+        insert(size_, new_size - size_, value);
+    }
+    
+    // Добавление всех элементов диапазона (контейнера, массива, initializer_list) в конец
+    template<typename Range>
+    void append_range(const Range& range) {
+        if constexpr (std::is_same_v<Range, SimpleVector>) {
+            if (&range == this) {
+                // Переаллокация сделала бы итераторы на собственный буфер недействительными
+                SimpleVector copy(range);
+                insert(size_, std::make_move_iterator(copy.begin()), std::make_move_iterator(copy.end()));
+                return;
+            }
+        }
+        using std::begin;
+        using std::end;
+        insert(size_, begin(range), end(range));
+    }
     
     // Итераторы
     iterator begin() noexcept { return iterator(data_); }
@@ -317,26 +534,164 @@ public:
     const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
     const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
     
+    // Буферы из кучи меняются указателями. Встроенный буфер бывает только у
+    // SmallVector, и такие векторы обменивает его swap (и перегрузка ниже);
+    // здесь он встречается, лишь если SmallVector передан как SimpleVector&,
+    // и тогда нехватка памяти при поштучном обмене завершает программу
     void swap(SimpleVector& other) noexcept {
-        using std::swap;
-        swap(size_, other.size_);
-        swap(capacity_, other.capacity_);
-        swap(data_, other.data_);
+        if (LAB3_LIKELY(!is_inline() && !other.is_inline())) {
+            using std::swap;
+            swap(size_, other.size_);
+            swap(capacity_, other.capacity_);
+            swap(data_, other.data_);
+            return;
+        }
+        swap_elements(other);
+    }
+    
+    template<std::size_t N>
+    void swap(SmallVector<T, N, GrowthPolicy, CheckPolicy>& other) {
+        other.swap(*this);
+    }
+    
+    friend void swap(SimpleVector& a, SimpleVector& b) noexcept {
+        a.swap(b);
     }
     
     void reserve(size_type new_cap) {
-        if (new_cap <= capacity_) return;
+        if (new_cap <= capacity()) return;
         change_capacity(new_cap);
     }
     
-    size_type capacity() const noexcept { return capacity_; }
+    size_type capacity() const noexcept { return capacity_ & ~INLINE_BIT; }
+    
+    // Уменьшает буфер до size() (с учётом округления до страниц); пустой
+    // вектор освобождает буфер совсем, SmallVector возвращается во встроенный
+    void shrink_to_fit() {
+        if (capacity() > size_) change_capacity(size_);
+    }
+    
+    MemoryUsage memory_usage() const noexcept {
+        MemoryUsage usage;
+        usage.used = size_ * sizeof(T);
+        if (data_ && capacity() > 0) {
+            usage.reserved = !is_inline() && is_mapped_capacity(capacity()) ? mapped_bytes(capacity())
+                                                                            : capacity() * sizeof(T);
+        }
+        return usage;
+    }
+    
+protected:
+    // Вектор поверх чужого неинициализированного буфера на inline_capacity элементов
+    // (встроенное хранилище SmallVector). Буфер не освобождается; в кучу элементы
+    // уходят только когда перестают в нём помещаться
+    SimpleVector(T* inline_buffer, size_type inline_capacity) noexcept
+        : capacity_(inline_capacity | INLINE_BIT), data_(inline_buffer) {}
+    
+    bool is_inline() const noexcept { return (capacity_ & INLINE_BIT) != 0; }
+    
+    // Переносит элементы во встроенный буфер SmallVector и освобождает буфер
+    // из кучи; элементов не больше inline_capacity. Адрес и размер буфера
+    // знает только SmallVector, поэтому вернуться в него может только он
+    void use_inline_buffer(T* inline_buffer, size_type inline_capacity) {
+        if (data_ == inline_buffer) return;
+        relocate_range(inline_buffer, data_, size_);
+        release_storage();
+        data_ = inline_buffer;
+        capacity_ = inline_capacity | INLINE_BIT;
+        this->stats_reallocation(capacity(), size_ * sizeof(T));
+    }
+    
+    // Обмен, когда хотя бы один вектор во встроенном буфере: элементы общей
+    // длины меняются местами, остальные переносятся; короткому вектору может
+    // понадобиться буфер из кучи
+    void swap_elements(SimpleVector& other) {
+        using std::swap;
+        if (!is_inline() && !other.is_inline()) {
+            swap(size_, other.size_);
+            swap(capacity_, other.capacity_);
+            swap(data_, other.data_);
+            return;
+        }
+        SimpleVector& shorter = size_ <= other.size_ ? *this : other;
+        SimpleVector& longer = size_ <= other.size_ ? other : *this;
+        shorter.reserve(longer.size_);
+        for (size_type i = 0; i < shorter.size_; ++i) {
+            swap(shorter.data_[i], longer.data_[i]);
+        }
+        relocate_range(shorter.data_ + shorter.size_, longer.data_ + shorter.size_,
+                       longer.size_ - shorter.size_);
+        swap(shorter.size_, longer.size_);
+    }
+    
+    // Забирает содержимое other в пустой вектор без своего буфера в куче
+    // (встроенный допускается); other становится пустым и без буфера. Чужой
+    // встроенный буфер забрать нельзя: если свой для его элементов мал,
+    // выделяется новый, и take может бросить bad_alloc. Элементы встроенного
+    // буфера сначала переносятся все (с бросающим перемещением — копией),
+    // потом уничтожаются в источнике: если перенос бросит, other не меняется
+    void take(SimpleVector& other) {
+        if (other.is_inline()) {
+            if (other.size_ > capacity()) change_capacity(other.size_);
+            if constexpr (is_trivially_relocatable_v<T>) {
+                relocate_bytes(data_, other.data_, other.size_);
+            } else {
+                size_type i = 0;
+                try {
+                    for (; i < other.size_; ++i) {
+                        new (&data_[i]) T(std::move_if_noexcept(other.data_[i]));
+                    }
+                } catch (...) {
+                    destroy_range(data_, i);
+                    throw;
+                }
+                destroy_range(other.data_, other.size_);
+            }
+        } else {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            other.data_ = nullptr;
+            other.capacity_ = 0;
+        }
+        size_ = other.size_;
+        other.size_ = 0;
+        this->stats_capacity(capacity());
+    }
     
 private:
+    // Старший бит capacity_: data_ — встроенный буфер SmallVector, который
+    // вектору не принадлежит. Ёмкость буфера не превышает PTRDIFF_MAX
+    // (check_capacity), так что бит всегда свободен, а обычный SimpleVector
+    // остаётся размером в три слова
+    static constexpr size_type INLINE_BIT = ~(~size_type(0) >> 1);
+    
     size_type size_ = 0;
     size_type capacity_ = 0;
     T* data_ = nullptr;
     
-    static constexpr double GROWTH_FACTOR = 1.5;
+    // Тривиально перемещаемые элементы с обычным выравниванием лежат в памяти
+    // malloc/mmap, чтобы буфер можно было расширять на месте через realloc/mremap
+    static constexpr bool RAW_STORAGE =
+        is_trivially_relocatable_v<T> && alignof(T) <= alignof(std::max_align_t);
+    
+    static constexpr bool AUTO_SHRINK = GrowthPolicy::shrink_fraction > 0.0;
+    
+    // Политика уменьшения: заполненный меньше чем на shrink_fraction буфер
+    // сжимается до size * factor. Пустой отображённый буфер не освобождается,
+    // а отдаёт страницы через madvise: адреса остаются за вектором, и новый
+    // всплеск заполняет его без mmap и mremap. Уменьшение — необязательная
+    // оптимизация, поэтому его неудача (нехватка памяти) не ошибка
+    void release_unused() noexcept {
+        if (LAB3_LIKELY(size_ >= capacity() * GrowthPolicy::shrink_fraction) || is_inline()) return;
+        if (size_ == 0 && is_mapped_capacity(capacity())) {
+            platform::release_pages(data_, mapped_bytes(capacity()));
+            return;
+        }
+        try {
+            change_capacity(static_cast<size_type>(size_ * GrowthPolicy::factor));
+        } catch (...) {
+        }
+    }
     
     void destroy_elements() {
         if (data_) {
@@ -348,60 +703,302 @@ private:
     
     void clear_memory() {
         destroy_elements();
-        ::operator delete(data_);
+        release_storage();
         data_ = nullptr;
         size_ = 0;
         capacity_ = 0;
     }
     
+    // Освобождает текущий буфер, если он не встроенный
+    void release_storage() noexcept {
+        if (!is_inline()) deallocate_storage(data_, capacity());
+    }
+    
     void ensure_capacity(size_type required_capacity) {
-        if (required_capacity <= capacity_) return;
-        
-        size_type new_capacity = capacity_ == 0 ? 1 : 
-                                 static_cast<size_type>(capacity_ * GROWTH_FACTOR);
+        if (required_capacity <= capacity()) return;
+        change_capacity(grown_capacity(required_capacity));
+    }
+    
+    size_type grown_capacity(size_type required_capacity) const noexcept {
+        size_type new_capacity = capacity() == 0 ? 1 : 
+                                 static_cast<size_type>(capacity() * GrowthPolicy::factor);
         if (new_capacity < required_capacity) {
             new_capacity = required_capacity;
         }
-        
-        change_capacity(new_capacity);
+        return new_capacity;
+    }
+    
+    static void destroy_range(T* first, size_type count) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_type i = 0; i < count; ++i) {
+                first[i].~T();
+            }
+        }
+    }
+    
+    // Перенос count элементов на новое место; области могут перекрываться.
+    // Исходные ячейки после переноса считаются неинициализированными.
+    // Для типов с бросающим конструктором перемещения гарантий нет.
+    static void relocate_range(T* dst, T* src, size_type count) {
+        if constexpr (is_trivially_relocatable_v<T>) {
+            relocate_bytes(dst, src, count);
+        } else if (dst < src) {
+            for (size_type i = 0; i < count; ++i) {
+                new (&dst[i]) T(std::move(src[i]));
+                src[i].~T();
+            }
+        } else if (dst > src) {
+            for (size_type i = count; i-- > 0;) {
+                new (&dst[i]) T(std::move(src[i]));
+                src[i].~T();
+            }
+        }
+    }
+    
+    // Раздвигает элементы, оставляя в позиции pos count неинициализированных ячеек.
+    // Переаллокация (если нужна) делается один раз и сразу раскладывает
+    // префикс и хвост по местам
+    void open_gap(size_type pos, size_type count) {
+        if (size_ + count > capacity()) {
+            size_type new_capacity = grown_capacity(size_ + count);
+            if constexpr (RAW_STORAGE) {
+                // realloc/mremap переносят буфер на месте, хвост сдвигаем ниже
+                change_capacity(new_capacity);
+            } else {
+                T* new_data = allocate_storage(new_capacity);
+                relocate_range(new_data, data_, pos);
+                relocate_range(new_data + pos + count, data_ + pos, size_ - pos);
+                release_storage();
+                data_ = new_data;
+                capacity_ = new_capacity;
+                this->stats_reallocation(capacity(), size_ * sizeof(T));
+                return;
+            }
+        }
+        this->stats_shift(size_ - pos);
+        relocate_range(data_ + pos + count, data_ + pos, size_ - pos);
+    }
+    
+    // Заполняет открытый промежуток функцией fill(slot, index); при исключении
+    // уничтожает уже созданные элементы и смыкает промежуток обратно
+    template<typename Fill>
+    void insert_gap(size_type pos, size_type count, Fill fill) {
+        open_gap(pos, count);
+        size_type built = 0;
+        try {
+            for (; built < count; ++built) {
+                fill(data_ + pos + built, built);
+            }
+        } catch (...) {
+            destroy_range(data_ + pos, built);
+            relocate_range(data_ + pos, data_ + pos + count, size_ - pos);
+            throw;
+        }
+        size_ += count;
     }
     
     void change_capacity(size_type new_capacity) {
-        if (new_capacity == capacity_) return;
+        if (new_capacity == capacity()) return;
         
         if (new_capacity < size_) {
             // Нельзя уменьшить capacity меньше текущего размера
             return;
         }
         
+        // Встроенный буфер не уменьшается; обратно в него переносит SmallVector
+        if (is_inline() && new_capacity < capacity()) return;
+        
+        if constexpr (RAW_STORAGE) {
+            reallocate_raw(new_capacity);
+            return;
+        }
+        
         T* new_data = nullptr;
         if (new_capacity > 0) {
-            new_data = static_cast<T*>(::operator new(new_capacity * sizeof(T)));
-            size_type i = 0;
-            try {
-                for (; i < size_; ++i) {
-                    new (&new_data[i]) T(std::move(data_[i]));
-                }
-            } catch (...) {
-                for (size_type j = 0; j < i; ++j) {
-                    new_data[j].~T();
+            new_data = allocate_storage(new_capacity);
+            if constexpr (is_trivially_relocatable_v<T>) {
+                relocate_bytes(new_data, data_, size_);
+            } else {
+                size_type i = 0;
+                try {
+                    for (; i < size_; ++i) {
+                        new (&new_data[i]) T(std::move(data_[i]));
+                    }
+                } catch (...) {
+                    for (size_type j = 0; j < i; ++j) {
+                        new_data[j].~T();
+                    }
+                    deallocate_storage(new_data, new_capacity);
+                    throw;
                 }
-                ::operator delete(new_data);
-                throw;
             }
         }
         
         // Уничтожаем старые элементы и освобождаем память
+        // (перемещённые побайтово объекты уничтожать не нужно)
         if (data_) {
-            for (size_type i = 0; i < size_; ++i) {
-                data_[i].~T();
+            if constexpr (!is_trivially_relocatable_v<T>) {
+                for (size_type i = 0; i < size_; ++i) {
+                    data_[i].~T();
+                }
             }
-            ::operator delete(data_);
+            release_storage();
         }
         
         data_ = new_data;
         capacity_ = new_capacity;
         // size_ не меняется
+        this->stats_reallocation(capacity(), size_ * sizeof(T));
+    }
+    
+    // Попадает ли буфер такой ёмкости в mmap
+    static bool is_mapped_capacity(size_type cap) noexcept {
+        return RAW_STORAGE && platform::has_mmap && cap * sizeof(T) >= GrowthPolicy::mmap_threshold;
+    }
+    
+    static std::size_t mapped_bytes(size_type cap) noexcept {
+        std::size_t granularity = GrowthPolicy::huge_pages ? platform::huge_page_size
+                                                           : platform::page_size();
+        return platform::round_up(cap * sizeof(T), granularity);
+    }
+    
+    // Ёмкость с учётом округления буфера до страниц
+    static size_type round_capacity(size_type cap) noexcept {
+        std::size_t bytes = cap * sizeof(T);
+        if (is_mapped_capacity(cap)) {
+            bytes = mapped_bytes(cap);
+        } else if (GrowthPolicy::round_to_pages && bytes >= platform::page_size()) {
+            bytes = platform::round_up(bytes, platform::page_size());
+        } else {
+            return cap;
+        }
+        return bytes / sizeof(T);
+    }
+    
+    // Буфер больше PTRDIFF_MAX байт невозможен; без проверки cap * sizeof(T)
+    // переполнился бы, и буфер оказался бы меньше записанной ёмкости
+    static void check_capacity(size_type cap) {
+        if (LAB3_UNLIKELY(cap > static_cast<size_type>(std::numeric_limits<std::ptrdiff_t>::max()) / sizeof(T))) {
+            throw std::bad_alloc();
+        }
+    }
+    
+    // Выделяет буфер под cap элементов; cap может увеличиться после округления
+    static T* allocate_storage(size_type& cap) {
+        check_capacity(cap);
+        cap = round_capacity(cap);
+        if (cap == 0) return nullptr;
+        if constexpr (RAW_STORAGE) {
+            void* p = is_mapped_capacity(cap) ? map_storage(cap) : std::malloc(cap * sizeof(T));
+            if (!p) throw std::bad_alloc();
+            return static_cast<T*>(p);
+        } else {
+            return static_cast<T*>(::operator new(cap * sizeof(T)));
+        }
+    }
+    
+    static void deallocate_storage(T* p, size_type cap) noexcept {
+        if (!p) return;
+        if constexpr (RAW_STORAGE) {
+            if (is_mapped_capacity(cap)) {
+                platform::unmap(p, mapped_bytes(cap));
+            } else {
+                std::free(p);
+            }
+        } else {
+            ::operator delete(p);
+        }
+    }
+    
+    static void* map_storage(size_type cap) noexcept {
+        std::size_t bytes = mapped_bytes(cap);
+        void* p = platform::map_anonymous(bytes, GrowthPolicy::huge_pages ? platform::huge_page_size : 0);
+        if (p && GrowthPolicy::huge_pages) platform::advise_huge_pages(p, bytes);
+        return p;
+    }
+    
+    // Смена ёмкости для RAW_STORAGE: сначала пробуем расширить буфер на месте
+    // (realloc для буферов из malloc, mremap для отображений) и только
+    // при переезде между malloc и mmap копируем данные в новый буфер
+    void reallocate_raw(size_type new_capacity) {
+        check_capacity(new_capacity);
+        new_capacity = round_capacity(new_capacity);
+        if (new_capacity == capacity()) return;
+        
+        if (new_capacity == 0) {
+            release_storage();
+            data_ = nullptr;
+            capacity_ = 0;
+            return;
+        }
+        
+        bool old_mapped = data_ && !is_inline() && is_mapped_capacity(capacity());
+        bool new_mapped = is_mapped_capacity(new_capacity);
+        void* p = nullptr;
+        // mremap переносит страницы без копирования, realloc копирует, если сменил адрес
+        std::size_t bytes_moved = 0;
+        
+        if (!old_mapped && !new_mapped && !is_inline()) {
+            const auto old_address = reinterpret_cast<std::uintptr_t>(data_);
+            p = std::realloc(static_cast<void*>(data_), new_capacity * sizeof(T));
+            if (!p) throw std::bad_alloc();
+            if (reinterpret_cast<std::uintptr_t>(p) != old_address) bytes_moved = size_ * sizeof(T);
+        } else if (old_mapped && new_mapped) {
+            p = platform::remap(data_, mapped_bytes(capacity()), mapped_bytes(new_capacity));
+            if (p && GrowthPolicy::huge_pages) {
+                platform::advise_huge_pages(p, mapped_bytes(new_capacity));
+            }
+        }
+        
+        if (!p) {
+            size_type cap = new_capacity;
+            T* fresh = allocate_storage(cap);
+            relocate_bytes(fresh, data_, size_);
+            release_storage();
+            p = fresh;
+            bytes_moved = size_ * sizeof(T);
+        }
+        
+        data_ = static_cast<T*>(p);
+        capacity_ = new_capacity;
+        this->stats_reallocation(capacity(), bytes_moved);
+    }
+    
+    // Побайтовый перенос count объектов; области могут перекрываться
+    static void relocate_bytes(T* dst, const T* src, size_type count) noexcept {
+        if (count > 0) {
+            std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(T));
+        }
+    }
+    
+    // Вставка в середину или начало; value не должен ссылаться на элементы вектора
+    void insert_shift(size_type pos, T&& value) {
+        ensure_capacity(size_ + 1);
+        this->stats_shift(size_ - pos);
+        
+        if constexpr (is_trivially_relocatable_v<T>) {
+            // Хвост сдвигается одним memmove
+            relocate_bytes(data_ + pos + 1, data_ + pos, size_ - pos);
+            try {
+                new (&data_[pos]) T(std::move(value));
+            } catch (...) {
+                // Возвращаем хвост на место, вектор остаётся прежним
+                relocate_bytes(data_ + pos, data_ + pos + 1, size_ - pos);
+                throw;
+            }
+        } else {
+            // Создаем новый элемент в конце
+            new (&data_[size_]) T(std::move(data_[size_ - 1]));
+            
+            // Сдвигаем элементы вправо
+            for (size_type i = size_ - 1; i > pos; --i) {
+                data_[i] = std::move(data_[i - 1]);
+            }
+            
+            // Вставляем новый элемент
+            data_[pos] = std::move(value);
+        }
+        ++size_;
     }
 };
 
@@ -1,32 +1,48 @@
 #ifndef SINGLY_LINKED_LIST_H
 #define SINGLY_LINKED_LIST_H
 
-#include "baseContainer.h"
+#include "staticContainer.h"
+#include "binaryIO.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <utility>
 #include <stdexcept>
 #include <initializer_list>
+#include <iostream>
 #include <iterator>
+#include <type_traits>
+#include <vector>
+#include "nodePool.h"
+#include "positionalIndex.h"
+
+template<typename T, typename Allocator = std::allocator<T>>
+class SinglyLinkedList : public StaticContainer<SinglyLinkedList<T, Allocator>, T> {
+    using Interface = StaticContainer<SinglyLinkedList<T, Allocator>, T>;
 
-template<typename T>
-class SinglyLinkedList : public BaseContainer<T> {
 private:
     struct Node {
         T data;
-        std::unique_ptr<Node> next;
+        Node* next;
         
-        Node(const T& v) : data(v), next(nullptr) {}
-        Node(T&& v) : data(std::move(v)), next(nullptr) {}
-        Node(const T& v, std::unique_ptr<Node> next_ptr) : data(v), next(std::move(next_ptr)) {}
+        template<typename... Args>
+        explicit Node(Node* next_ptr, Args&&... args)
+            : data(std::forward<Args>(args)...), next(next_ptr) {}
     };
     
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+    
 public:
-    using value_type = typename BaseContainer<T>::value_type;
-    using size_type = typename BaseContainer<T>::size_type;
-    using reference = typename BaseContainer<T>::reference;
-    using const_reference = typename BaseContainer<T>::const_reference;
+    using value_type = typename Interface::value_type;
+    using size_type = typename Interface::size_type;
+    using reference = typename Interface::reference;
+    using const_reference = typename Interface::const_reference;
+    using allocator_type = Allocator;
     
-    // Forward Iterator
+    // Forward Iterator. У before_begin() узла нет, как и у end(); их
+    // различает before_ — список, перед головой которого стоит итератор
     class Iterator {
     public:
         using iterator_category = std::forward_iterator_tag;
@@ -35,28 +51,37 @@ public:
         using pointer = T*;
         using reference = T&;
         
-        Iterator() noexcept : node_(nullptr) {}
-        explicit Iterator(Node* node) noexcept : node_(node) {}
+        Iterator() noexcept : node_(nullptr), before_(nullptr) {}
+        explicit Iterator(Node* node) noexcept : node_(node), before_(nullptr) {}
         
         reference operator*() const { return node_->data; }
         pointer operator->() const { return &node_->data; }
         
         Iterator& operator++() {
-            node_ = node_->next.get();
+            node_ = LAB3_UNLIKELY(before_ != nullptr) ? before_->head_ : node_->next;
+            before_ = nullptr;
             return *this;
         }
         
         Iterator operator++(int) {
             Iterator temp = *this;
-            node_ = node_->next.get();
+            ++*this;
             return temp;
         }
         
-        bool operator==(const Iterator& other) const { return node_ == other.node_; }
-        bool operator!=(const Iterator& other) const { return node_ != other.node_; }
+        bool operator==(const Iterator& other) const {
+            return node_ == other.node_ && before_ == other.before_;
+        }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
         
     private:
+        Iterator(Node* node, const SinglyLinkedList* before) noexcept : node_(node), before_(before) {}
+        
         Node* node_;
+        const SinglyLinkedList* before_;
+        
+        friend class ConstIterator;
+        friend class SinglyLinkedList;
     };
     
     class ConstIterator {
@@ -67,56 +92,120 @@ public:
         using pointer = const T*;
         using reference = const T&;
         
-        ConstIterator() noexcept : node_(nullptr) {}
-        explicit ConstIterator(Node* node) noexcept : node_(node) {}
-        ConstIterator(const Iterator& it) noexcept : node_(it.node_) {}
+        ConstIterator() noexcept : node_(nullptr), before_(nullptr) {}
+        explicit ConstIterator(Node* node) noexcept : node_(node), before_(nullptr) {}
+        ConstIterator(const Iterator& it) noexcept : node_(it.node_), before_(it.before_) {}
         
         reference operator*() const { return node_->data; }
         pointer operator->() const { return &node_->data; }
         
         ConstIterator& operator++() {
-            node_ = node_->next.get();
+            node_ = LAB3_UNLIKELY(before_ != nullptr) ? before_->head_ : node_->next;
+            before_ = nullptr;
             return *this;
         }
         
         ConstIterator operator++(int) {
             ConstIterator temp = *this;
-            node_ = node_->next.get();
+            ++*this;
             return temp;
         }
         
-        bool operator==(const ConstIterator& other) const { return node_ == other.node_; }
-        bool operator!=(const ConstIterator& other) const { return node_ != other.node_; }
+        bool operator==(const ConstIterator& other) const {
+            return node_ == other.node_ && before_ == other.before_;
+        }
+        bool operator!=(const ConstIterator& other) const { return !(*this == other); }
         
     private:
+        ConstIterator(Node* node, const SinglyLinkedList* before) noexcept : node_(node), before_(before) {}
+        
         Node* node_;
+        const SinglyLinkedList* before_;
+        
+        friend class SinglyLinkedList;
     };
     
     using iterator = Iterator;
     using const_iterator = ConstIterator;
     
+    // Курсор для последовательной правки списка: помнит узел, его
+    // предшественника и номер, поэтому вставка и удаление в позиции курсора
+    // и шаг вперёд — O(1). Правки через сам курсор его не портят; после любых
+    // других вставок и удалений в списке курсор нужно получить заново
+    class Cursor {
+    public:
+        // Курсор стоит на элементе (а не за последним)
+        bool valid() const noexcept { return node_ != nullptr; }
+        size_type index() const noexcept { return index_; }
+        
+        reference operator*() const { return node_->data; }
+        T* operator->() const { return &node_->data; }
+        
+        Cursor& operator++() {
+            prev_ = node_;
+            node_ = node_->next;
+            ++index_;
+            return *this;
+        }
+        
+        // Вставка перед текущим элементом; курсор остаётся на нём же
+        void insert(const T& value) {
+            prev_ = list_->emplace_at(index_, prev_, value);
+            ++index_;
+        }
+        
+        void insert(T&& value) {
+            prev_ = list_->emplace_at(index_, prev_, std::move(value));
+            ++index_;
+        }
+        
+        // Удаление текущего элемента; курсор переходит на следующий
+        void erase() {
+            node_ = list_->erase_at(index_, prev_);
+        }
+        
+    private:
+        friend class SinglyLinkedList;
+        
+        Cursor(SinglyLinkedList* list, Node* prev, Node* node, size_type index) noexcept
+            : list_(list), prev_(prev), node_(node), index_(index) {}
+        
+        SinglyLinkedList* list_;
+        Node* prev_;
+        Node* node_;
+        size_type index_;
+    };
+    
     SinglyLinkedList() = default;
     
-    SinglyLinkedList(std::initializer_list<T> init) {
+    explicit SinglyLinkedList(const Allocator& alloc) : alloc_(alloc) {}
+    
+    SinglyLinkedList(std::initializer_list<T> init, const Allocator& alloc = Allocator())
+        : alloc_(alloc) {
         for (const auto& item : init) {
             push_back(item);
         }
     }
     
     // Конструктор копирования
-    SinglyLinkedList(const SinglyLinkedList& other) {
-        Node* current = other.head_.get();
+    SinglyLinkedList(const SinglyLinkedList& other)
+        : alloc_(NodeTraits::select_on_container_copy_construction(other.alloc_)) {
+        Node* current = other.head_;
         while (current) {
             push_back(current->data);
-            current = current->next.get();
+            current = current->next;
         }
+        if (other.index_enabled()) enable_index();
     }
     
     // Конструктор перемещения
     SinglyLinkedList(SinglyLinkedList&& other) noexcept
-        : head_(std::move(other.head_)), tail_(other.tail_), size_(other.size_) {
+        : alloc_(other.alloc_), head_(other.head_), tail_(other.tail_), size_(other.size_) {
+        other.head_ = nullptr;
         other.tail_ = nullptr;
         other.size_ = 0;
+        index_.swap(other.index_);
+        std::swap(finger_, other.finger_);
     }
     
     // Оператор присваивания копированием
@@ -129,62 +218,83 @@ public:
     }
     
     // Оператор присваивания перемещением
-    SinglyLinkedList& operator=(SinglyLinkedList&& other) noexcept {
+    SinglyLinkedList& operator=(SinglyLinkedList&& other)
+        noexcept(NodeTraits::propagate_on_container_move_assignment::value ||
+                 NodeTraits::is_always_equal::value) {
         if (this != &other) {
             clear();
-            head_ = std::move(other.head_);
+            if (NodeTraits::propagate_on_container_move_assignment::value) {
+                alloc_ = other.alloc_;
+            } else if (alloc_ != other.alloc_) {
+                // Узлы чужого пула забрать нельзя — переносим элементы
+                for (Node* current = other.head_; current; current = current->next) {
+                    push_back(std::move(current->data));
+                }
+                other.clear();
+                return *this;
+            }
+            head_ = other.head_;
             tail_ = other.tail_;
             size_ = other.size_;
+            index_.swap(other.index_);
+            finger_ = other.finger_;
             
+            other.head_ = nullptr;
             other.tail_ = nullptr;
             other.size_ = 0;
+            other.index_.disable();
+            other.finger_ = Finger{};
         }
         return *this;
     }
     
-    ~SinglyLinkedList() = default;
+    ~SinglyLinkedList() {
+        clear();
+    }
     
-    // Реализация методов BaseContainer
-    size_type size() const noexcept override { return size_; }
-    bool empty() const noexcept override { return size_ == 0; }
+    // Интерфейс последовательного контейнера (is_sequence_container)
+    size_type size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
     
-    void clear() override {
-        while (head_) {
-            head_ = std::move(head_->next);
+    void clear() {
+        // Пул, которым владеет только этот список, освобождается slab'ами целиком:
+        // узлы не возвращаются в free list по одному, а при тривиально
+        // разрушаемых элементах цепочка не обходится вовсе
+        if constexpr (supports_bulk_release<NodeAllocator>::value) {
+            if (alloc_.sole_owner()) {
+                if constexpr (!std::is_trivially_destructible_v<T>) {
+                    Node* current = head_;
+                    while (current) {
+                        Node* next = current->next;
+                        NodeTraits::destroy(alloc_, current);
+                        current = next;
+                    }
+                }
+                alloc_.try_release_all();
+                forget_nodes();
+                return;
+            }
         }
-        tail_ = nullptr;
-        size_ = 0;
-    }
-    
-    void push_back(const T& value) override {
-        auto new_node = std::make_unique<Node>(value);
-        Node* raw_ptr = new_node.get();
         
-        if (!head_) {
-            head_ = std::move(new_node);
-            tail_ = raw_ptr;
-        } else {
-            tail_->next = std::move(new_node);
-            tail_ = raw_ptr;
+        // Обход без рекурсии: длина списка не ограничена глубиной стека
+        Node* current = head_;
+        while (current) {
+            Node* next = current->next;
+            destroy_node(current);
+            current = next;
         }
-        ++size_;
+        forget_nodes();
     }
     
-    void push_back(T&& value) override {
-        auto new_node = std::make_unique<Node>(std::move(value));
-        Node* raw_ptr = new_node.get();
-        
-        if (!head_) {
-            head_ = std::move(new_node);
-            tail_ = raw_ptr;
-        } else {
-            tail_->next = std::move(new_node);
-            tail_ = raw_ptr;
-        }
-        ++size_;
+    void push_back(const T& value) {
+        link_back(create_node(nullptr, value));
     }
     
-    void insert(size_type pos, const T& value) override {
+    void push_back(T&& value) {
+        link_back(create_node(nullptr, std::move(value)));
+    }
+    
+    void insert(size_type pos, const T& value) {
         this->check_position(pos, size_);
         
         if (pos == 0) {
@@ -196,7 +306,7 @@ public:
         }
     }
     
-    void insert(size_type pos, T&& value) override {
+    void insert(size_type pos, T&& value) {
         this->check_position(pos, size_);
         
         if (pos == 0) {
@@ -208,112 +318,523 @@ public:
         }
     }
     
-    void erase(size_type pos) override {
+    void erase(size_type pos) {
         this->check_index(pos, size_);
-        
-        if (pos == 0) {
-            head_ = std::move(head_->next);
-            if (!head_) tail_ = nullptr;
-        } else {
-            Node* prev = head_.get();
-            for (size_type i = 0; i < pos - 1; ++i) {
-                prev = prev->next.get();
-            }
-            
-            auto node_to_erase = std::move(prev->next);
-            prev->next = std::move(node_to_erase->next);
-            
-            if (!prev->next) {
-                tail_ = prev;
-            }
-        }
-        --size_;
+        erase_at(pos, pos == 0 ? nullptr : get_node_at(pos - 1));
     }
     
-    reference operator[](size_type idx) override {
+    reference operator[](size_type idx) {
         this->check_index(idx, size_);
         return get_node_at(idx)->data;
     }
     
-    const_reference operator[](size_type idx) const override {
+    // Константный доступ не двигает палец и не перестраивает индекс, поэтому
+    // его можно вызывать из нескольких потоков одновременно (кроме сборки с
+    // LAB3_STATS: счётчики контейнера общие). Неконстантный operator[]
+    // запоминает найденный узел и требует внешней синхронизации
+    const_reference operator[](size_type idx) const {
         this->check_index(idx, size_);
-        return get_node_at(idx)->data;
+        return find_node(idx)->data;
     }
     
-    void print(std::ostream& os = std::cout) const override {
-        Node* current = head_.get();
+    void print(std::ostream& os = std::cout) const {
+        Node* current = head_;
         while (current) {
             os << current->data;
-            current = current->next.get();
+            current = current->next;
             if (current) os << " ";
         }
     }
+
+    // Двоичное сохранение (формат binaryIO.h, общий с SimpleVector).
+    // Тривиально копируемые элементы собираются в буфер и пишутся блоками
+    void save(std::ostream& os) const {
+        binary::write_header<T>(os, size_);
+        binary::write_elements<T>(os, begin(), end());
+    }
+
+    // Заменяет содержимое сохранённым через save любого контейнера с теми же
+    // элементами. Бросает binary::format_error на чужом или обрезанном файле;
+    // при исключении список не меняется
+    void load(std::istream& is) {
+        std::uint64_t remaining = 0;
+        const std::uint64_t count = binary::read_header<T>(is, remaining);
+        SinglyLinkedList loaded(get_allocator());
+        binary::read_elements<T>(is, count, remaining,
+                                 [&loaded](T&& value) { loaded.push_back(std::move(value)); });
+        swap(loaded);
+    }
     
     // Дополнительные методы
     void push_front(const T& value) {
-        auto new_node = std::make_unique<Node>(value, std::move(head_));
-        head_ = std::move(new_node);
-        if (!tail_) tail_ = head_.get();
-        ++size_;
+        emplace_at(0, nullptr, value);
     }
     
     void push_front(T&& value) {
-        auto new_node = std::make_unique<Node>(std::move(value), std::move(head_));
-        head_ = std::move(new_node);
-        if (!tail_) tail_ = head_.get();
-        ++size_;
+        emplace_at(0, nullptr, std::move(value));
+    }
+    
+    allocator_type get_allocator() const { return allocator_type(alloc_); }
+    
+    // Заранее выделяет память под count узлов одним блоком, если аллокатор
+    // это умеет (PoolAllocator); с std::allocator ничего не делает
+    void reserve_nodes(size_type count) {
+        if constexpr (supports_reserve<NodeAllocator>::value) alloc_.reserve(count);
+    }
+    
+    // Позиция «перед первым элементом» для операций *_after; шаг вперёд ведёт
+    // на begin(). Разыменовывать её нельзя
+    iterator before_begin() noexcept { return iterator(nullptr, this); }
+    const_iterator before_begin() const noexcept { return const_iterator(nullptr, this); }
+    const_iterator cbefore_begin() const noexcept { return const_iterator(nullptr, this); }
+    
+    // Правки по итератору за O(1): номер позиции не вычисляется, поэтому
+    // включённый позиционный индекс перестроится при следующем обращении по номеру
+    template<typename... Args>
+    iterator emplace_after(const_iterator pos, Args&&... args) {
+        Node* prev = after_position(pos);
+        forget_positions();
+        return iterator(emplace_at(0, prev, std::forward<Args>(args)...));
+    }
+    
+    iterator insert_after(const_iterator pos, const T& value) {
+        return emplace_after(pos, value);
+    }
+    
+    iterator insert_after(const_iterator pos, T&& value) {
+        return emplace_after(pos, std::move(value));
+    }
+    
+    // Удаляет элемент после pos; возвращает итератор на следующий за удалённым
+    iterator erase_after(const_iterator pos) {
+        Node* prev = after_position(pos);
+        forget_positions();
+        return iterator(erase_at(0, prev));
+    }
+    
+    // Удаляет элементы в интервале (first, last)
+    iterator erase_after(const_iterator first, const_iterator last) {
+        after_position(first);
+        forget_positions();
+        while (node_after(first.node_) != last.node_) {
+            erase_at(0, first.node_);
+        }
+        return iterator(last.node_);
+    }
+    
+    // Перенос узлов other (всех, одного после it или интервала (first, last))
+    // после pos перецеплением, без выделения памяти и копирования. Для подсчёта
+    // размера диапазон проходится один раз. При неравных аллокаторах узлы чужого
+    // пула забрать нельзя, и элементы переносятся перемещением
+    void splice_after(const_iterator pos, SinglyLinkedList& other) {
+        splice_after(pos, other, other.before_begin(), other.end());
+    }
+    
+    void splice_after(const_iterator pos, SinglyLinkedList&& other) {
+        splice_after(pos, other);
+    }
+    
+    void splice_after(const_iterator pos, SinglyLinkedList& other, const_iterator it) {
+        after_position(pos);
+        Node* node = other.node_after(other.after_position(it));
+        // Узел уже стоит после pos или сам является pos: перецепление к самому
+        // себе выкинуло бы его из цепочки
+        if (!node || (&other == this && (pos.node_ == it.node_ || pos.node_ == node))) return;
+        splice_after(pos, other, it, const_iterator(node->next));
+    }
+    
+    void splice_after(const_iterator pos, SinglyLinkedList& other,
+                      const_iterator first, const_iterator last) {
+        after_position(pos);
+        if (other.node_after(other.after_position(first)) == last.node_) return;
+        forget_positions();
+        other.forget_positions();
+        if (!same_pool(other)) {
+            Node* prev = pos.node_;
+            while (other.node_after(first.node_) != last.node_) {
+                prev = emplace_at(0, prev, std::move(other.node_after(first.node_)->data));
+                other.erase_at(0, first.node_);
+            }
+            return;
+        }
+        
+        Node* first_node = other.node_after(first.node_);
+        size_type count = 0;
+        Node* back = other.unlink_after(first.node_, last.node_, count);
+        if (&other != this) {
+            other.size_ -= count;
+            size_ += count;
+        }
+        link_after(pos.node_, first_node, back);
+    }
+    
+    // Слияние с отсортированным other (этот список тоже отсортирован) перецеплением
+    // узлов; устойчиво. Если comp бросит исключение, оба списка останутся корректными
+    void merge(SinglyLinkedList& other) {
+        merge(other, std::less<>());
+    }
+    
+    void merge(SinglyLinkedList&& other) {
+        merge(other);
+    }
+    
+    template<typename Compare>
+    void merge(SinglyLinkedList& other, Compare comp) {
+        if (&other == this || other.empty()) return;
+        forget_positions();
+        other.forget_positions();
+        const bool steal = same_pool(other);
+        
+        Node* prev = nullptr;
+        Node* current = head_;
+        while (other.head_) {
+            Node* node = other.head_;
+            if (current && !comp(node->data, current->data)) {
+                prev = current;
+                current = current->next;
+                continue;
+            }
+            if (!steal) {
+                prev = emplace_at(0, prev, std::move(node->data));
+                other.erase_at(0, nullptr);
+                continue;
+            }
+            // Хвост other целиком встаёт в конец
+            size_type count = 1;
+            Node* back = current ? other.unlink_after(nullptr, node->next, count)
+                                 : other.unlink_after(nullptr, nullptr, count);
+            other.size_ -= count;
+            link_after(prev, node, back);
+            size_ += count;
+            prev = back;
+        }
+    }
+    
+    // Отрезает (pos, end()) в новый список с тем же аллокатором; O(длины хвоста)
+    SinglyLinkedList split_after(const_iterator pos) {
+        SinglyLinkedList tail(get_allocator());
+        Node* first = node_after(after_position(pos));
+        if (!first) return tail;
+        forget_positions();
+        size_type count = 0;
+        Node* back = unlink_after(pos.node_, nullptr, count);
+        size_ -= count;
+        tail.link_after(nullptr, first, back);
+        tail.size_ = count;
+        return tail;
+    }
+    
+    // Курсор на позиции pos; pos == size() — за последним элементом
+    Cursor cursor(size_type pos = 0) {
+        this->check_position(pos, size_);
+        Node* prev = pos == 0 ? nullptr : get_node_at(pos - 1);
+        return Cursor(this, prev, prev ? prev->next : head_, pos);
+    }
+    
+    // Границы k отрезков почти равной длины для параллельного обхода
+    // (parallel_for_each и др.): k + 1 итератор, последний — end().
+    // С позиционным индексом — O(k log n), иначе один проход по списку.
+    // Границы годятся, пока узлы не вставляются и не удаляются
+    std::vector<iterator> chunk_bounds(size_type k) {
+        std::vector<iterator> bounds;
+        collect_bounds(k, [&bounds](Node* node) { bounds.push_back(iterator(node)); });
+        return bounds;
+    }
+    
+    std::vector<const_iterator> chunk_bounds(size_type k) const {
+        std::vector<const_iterator> bounds;
+        collect_bounds(k, [&bounds](Node* node) { bounds.push_back(const_iterator(node)); });
+        return bounds;
+    }
+    
+    // Позиционный индекс: operator[], insert(pos) и erase(pos) за O(log n)
+    // ценой ~24 байт на элемент. Включённый индекс обновляется при каждой
+    // вставке и удалении; построение по текущему списку — O(n)
+    void enable_index() {
+        if (!index_.valid()) {
+            index_.build(head_, size_, [](Node* node) { return node->next; });
+        }
+    }
+    
+    void disable_index() noexcept { index_.disable(); }
+    
+    bool index_enabled() const noexcept { return index_.enabled(); }
+    
+    // Узел целиком (значение и ссылки) плюс позиционный индекс
+    MemoryUsage memory_usage() const noexcept {
+        MemoryUsage usage;
+        usage.used = size_ * sizeof(T);
+        usage.reserved = size_ * sizeof(Node) + index_.memory_bytes();
+        return usage;
     }
     
     // Итераторы
-    iterator begin() noexcept { return iterator(head_.get()); }
+    iterator begin() noexcept { return iterator(head_); }
     iterator end() noexcept { return iterator(nullptr); }
     
-    const_iterator begin() const noexcept { return const_iterator(head_.get()); }
+    const_iterator begin() const noexcept { return const_iterator(head_); }
     const_iterator end() const noexcept { return const_iterator(nullptr); }
     
-    const_iterator cbegin() const noexcept { return const_iterator(head_.get()); }
+    const_iterator cbegin() const noexcept { return const_iterator(head_); }
     const_iterator cend() const noexcept { return const_iterator(nullptr); }
     
     void swap(SinglyLinkedList& other) noexcept {
         using std::swap;
+        if (NodeTraits::propagate_on_container_swap::value) {
+            swap(alloc_, other.alloc_);
+        }
         swap(head_, other.head_);
         swap(tail_, other.tail_);
         swap(size_, other.size_);
+        index_.swap(other.index_);
+        swap(finger_, other.finger_);
     }
     
 private:
-    std::unique_ptr<Node> head_;
+    NodeAllocator alloc_;
+    Node* head_ = nullptr;
     Node* tail_ = nullptr;
     size_type size_ = 0;
+    PositionalIndex<Node*> index_;
+    
+    // Последний найденный по номеру узел: поиск дальше по списку начинается
+    // с него, поэтому проход list[0], list[1], ... занимает O(n) в сумме.
+    // Меняется только неконстантными методами; const-поиск его лишь читает
+    struct Finger {
+        size_type index = 0;
+        Node* node = nullptr;
+    };
+    Finger finger_;
     
-    Node* get_node_at(size_type idx) const {
-        Node* current = head_.get();
-        for (size_type i = 0; i < idx; ++i) {
-            current = current->next.get();
+    // С включённым индексом палец используется только для совсем близких позиций
+    static constexpr size_type FINGER_REACH = 8;
+    
+    template<typename... Args>
+    Node* create_node(Node* next, Args&&... args) {
+        Node* node = NodeTraits::allocate(alloc_, 1);
+        try {
+            NodeTraits::construct(alloc_, node, next, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(alloc_, node, 1);
+            throw;
         }
-        return current;
+        this->stats_node_allocation();
+        return node;
     }
     
-    void insert_middle(size_type pos, const T& value) {
-        Node* prev = head_.get();
-        for (size_type i = 0; i < pos - 1; ++i) {
-            prev = prev->next.get();
+    void destroy_node(Node* node) noexcept {
+        NodeTraits::destroy(alloc_, node);
+        NodeTraits::deallocate(alloc_, node, 1);
+    }
+    
+    // Узлы other можно перецепить в этот список
+    bool same_pool(const SinglyLinkedList& other) const noexcept {
+        if constexpr (NodeTraits::is_always_equal::value) {
+            return true;
+        } else {
+            return alloc_ == other.alloc_;
         }
-        
-        auto new_node = std::make_unique<Node>(value, std::move(prev->next));
-        prev->next = std::move(new_node);
+    }
+    
+    // Узел попадает в индекс до перецепления: если индексу не хватило памяти,
+    // узел уничтожается и список остаётся прежним
+    void index_insert(size_type pos, Node* node) {
+        if (!index_.valid()) return;
+        try {
+            index_.insert(pos, node);
+        } catch (...) {
+            destroy_node(node);
+            throw;
+        }
+    }
+    
+    void index_erase(size_type pos) noexcept {
+        if (index_.valid()) index_.erase(pos);
+    }
+    
+    // Все узлы уже уничтожены или освобождены вместе с пулом
+    void forget_nodes() noexcept {
+        head_ = nullptr;
+        tail_ = nullptr;
+        size_ = 0;
+        index_.reset();
+        finger_ = Finger{};
+    }
+    
+    // Список меняется без знания номеров позиций: палец сбрасывается,
+    // индекс перестроится при следующем обращении по номеру
+    void forget_positions() noexcept {
+        index_.invalidate();
+        finger_ = Finger{};
+    }
+    
+    // Узел позиции pos операций *_after; nullptr — before_begin() этого
+    // списка. Позиция end() (или before_begin() другого списка) отвергается:
+    // её узел тоже nullptr, и операция молча ушла бы в голову списка
+    Node* after_position(const_iterator pos) const {
+        if (LAB3_UNLIKELY(!pos.node_ && pos.before_ != this)) {
+            throw std::out_of_range("Iterator is not a position of this list");
+        }
+        return pos.node_;
+    }
+    
+    // Узел после prev; prev == nullptr (before_begin) — голова
+    Node* node_after(Node* prev) const noexcept {
+        return prev ? prev->next : head_;
+    }
+    
+    // Вырезает цепочку после prev до last (не включая); возвращает последний
+    // вырезанный узел и число узлов в count
+    Node* unlink_after(Node* prev, Node* last, size_type& count) noexcept {
+        Node* first = node_after(prev);
+        Node* back = first;
+        count = 1;
+        while (back->next != last) {
+            back = back->next;
+            ++count;
+        }
+        if (prev) {
+            prev->next = last;
+        } else {
+            head_ = last;
+        }
+        if (!last) tail_ = prev;
+        return back;
+    }
+    
+    // Вставляет цепочку [first, back] после prev; size_ не меняется
+    void link_after(Node* prev, Node* first, Node* back) noexcept {
+        Node* next = node_after(prev);
+        back->next = next;
+        if (prev) {
+            prev->next = first;
+        } else {
+            head_ = first;
+        }
+        if (!next) tail_ = back;
+    }
+    
+    void link_back(Node* node) {
+        index_insert(size_, node);
+        if (!head_) {
+            head_ = node;
+        } else {
+            tail_->next = node;
+        }
+        tail_ = node;
         ++size_;
     }
     
-    void insert_middle(size_type pos, T&& value) {
-        Node* prev = head_.get();
-        for (size_type i = 0; i < pos - 1; ++i) {
-            prev = prev->next.get();
+    // Вставка на позицию pos после prev (nullptr — в начало)
+    template<typename... Args>
+    Node* emplace_at(size_type pos, Node* prev, Args&&... args) {
+        Node* next = prev ? prev->next : head_;
+        Node* node = create_node(next, std::forward<Args>(args)...);
+        index_insert(pos, node);
+        if (prev) {
+            prev->next = node;
+        } else {
+            head_ = node;
         }
-        
-        auto new_node = std::make_unique<Node>(std::move(value), std::move(prev->next));
-        prev->next = std::move(new_node);
+        if (!next) tail_ = node;
         ++size_;
+        if (finger_.node && pos <= finger_.index) ++finger_.index;
+        return node;
+    }
+    
+    // Удаляет узел на позиции pos после prev и возвращает следующий за ним
+    Node* erase_at(size_type pos, Node* prev) noexcept {
+        index_erase(pos);
+        Node* node = prev ? prev->next : head_;
+        Node* next = node->next;
+        if (prev) {
+            prev->next = next;
+        } else {
+            head_ = next;
+        }
+        if (!next) tail_ = prev;
+        destroy_node(node);
+        --size_;
+        if (finger_.node) {
+            if (pos < finger_.index) {
+                --finger_.index;
+            } else if (pos == finger_.index) {
+                // На место удалённого встаёт следующий узел
+                finger_.node = next;
+            }
+        }
+        return next;
+    }
+    
+    // Начала отрезков по номерам i * size / k, затем nullptr (конец)
+    template<typename Push>
+    void collect_bounds(size_type k, Push push) const {
+        k = std::max<size_type>(1, std::min(k, size_));
+        if (index_.valid()) {
+            for (size_type i = 0; i < k && size_; ++i) {
+                push(index_.at(i * size_ / k));
+            }
+        } else {
+            Node* node = head_;
+            size_type pos = 0;
+            for (size_type i = 0; i < k && size_; ++i) {
+                for (size_type target = i * size_ / k; pos < target; ++pos) {
+                    node = node->next;
+                }
+                push(node);
+            }
+        }
+        push(nullptr);
+    }
+    
+    // Назад от пальца односвязный список идти не умеет
+    size_type finger_distance(size_type idx) const noexcept {
+        if (!finger_.node || idx < finger_.index) return size_;
+        return idx - finger_.index;
+    }
+    
+    // Идём вперёд от пальца, если он не дальше idx, иначе от головы
+    // (или берём узел из индекса). Палец и индекс только читаются, поэтому
+    // const-доступ по номеру из разных потоков безопасен; устаревший индекс
+    // здесь не перестраивается, и поиск идёт по списку
+    Node* find_node(size_type idx) const {
+        if (index_.valid() && finger_distance(idx) > FINGER_REACH) {
+            this->stats_walk(0);
+            return index_.at(idx);
+        }
+        Node* current = head_;
+        size_type pos = 0;
+        if (idx == size_ - 1) {
+            current = tail_;
+            pos = idx;
+        } else if (finger_.node && finger_.index <= idx) {
+            current = finger_.node;
+            pos = finger_.index;
+        }
+        this->stats_walk(idx - pos);
+        for (; pos < idx; ++pos) {
+            current = current->next;
+        }
+        return current;
+    }
+    
+    // Поиск для изменяющих методов: устаревший индекс строится заново,
+    // палец переезжает на найденный узел
+    Node* get_node_at(size_type idx) {
+        if (index_.stale()) {
+            index_.build(head_, size_, [](Node* node) { return node->next; });
+        }
+        Node* node = find_node(idx);
+        finger_ = Finger{idx, node};
+        return node;
+    }
+    
+    void insert_middle(size_type pos, const T& value) {
+        emplace_at(pos, get_node_at(pos - 1), value);
+    }
+    
+    void insert_middle(size_type pos, T&& value) {
+        emplace_at(pos, get_node_at(pos - 1), std::move(value));
     }
 };
 
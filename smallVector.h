@@ -0,0 +1,127 @@
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include "simpleVector.h"
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+// SimpleVector со встроенным буфером на N элементов: пока элементов не больше N,
+// контейнер не обращается к куче. При переполнении элементы переезжают в кучу
+// по обычной политике роста SimpleVector.
+//
+// Буфер и N хранит только SmallVector; в самом SimpleVector о нём остаётся
+// один бит ёмкости, поэтому обычный SimpleVector не становится больше.
+//
+// Перемещение вектора, живущего в куче, забирает буфер целиком; вектор во
+// встроенном буфере переносит элементы поштучно. Между SmallVector одного N
+// элементы всегда помещаются в приёмник, и перемещение noexcept, если
+// noexcept перемещение T. В SimpleVector или в SmallVector меньшего N
+// встроенные элементы могут не поместиться без буфера из кучи, поэтому такие
+// перемещения могут бросить bad_alloc. То же с источником, переданным как
+// SimpleVector&&: за ним может стоять SmallVector во встроенном буфере.
+template<typename T, std::size_t N, typename GrowthPolicy = DefaultGrowthPolicy,
+         typename CheckPolicy = DefaultCheckPolicy>
+class SmallVector : public SimpleVector<T, GrowthPolicy, CheckPolicy> {
+    using Base = SimpleVector<T, GrowthPolicy, CheckPolicy>;
+
+    static_assert(N > 0, "SmallVector needs a non-empty inline buffer");
+
+public:
+    using typename Base::value_type;
+    using typename Base::size_type;
+
+    static constexpr size_type inline_capacity = N;
+
+    SmallVector() noexcept : Base(inline_buffer(), N) {}
+
+    SmallVector(std::initializer_list<T> init) : SmallVector() {
+        this->assign(init.begin(), init.end());
+    }
+
+    SmallVector(const SmallVector& other) : SmallVector() {
+        this->assign(other.begin(), other.end());
+    }
+
+    // Буфер SimpleVector из кучи забирается без копирования. За other может
+    // стоять SmallVector с другим N во встроенном буфере, поэтому не noexcept
+    SmallVector(Base&& other) : SmallVector() {
+        this->take(other);
+    }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : SmallVector() {
+        this->take(other);
+        other.shrink_to_fit();
+    }
+
+    // SmallVector с другим N: элементы из его встроенного буфера могут не
+    // поместиться в наш
+    template<std::size_t M>
+    SmallVector(SmallVector<T, M, GrowthPolicy, CheckPolicy>&& other) : SmallVector() {
+        this->take(other);
+        other.shrink_to_fit();
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            this->assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        move_from(other);
+        return *this;
+    }
+
+    template<std::size_t M>
+    SmallVector& operator=(SmallVector<T, M, GrowthPolicy, CheckPolicy>&& other) {
+        move_from(other);
+        return *this;
+    }
+
+    ~SmallVector() {
+        // Элементы уничтожаются, пока встроенный буфер ещё жив
+        this->clear();
+    }
+
+    // Хранятся ли элементы во встроенном буфере
+    bool is_small() const noexcept { return this->is_inline(); }
+
+    // Элементы, которые помещаются во встроенный буфер, возвращаются в него
+    void shrink_to_fit() {
+        if (this->size() <= N) {
+            this->use_inline_buffer(inline_buffer(), N);
+        } else {
+            Base::shrink_to_fit();
+        }
+    }
+
+    // Встроенный буфер обменивается поштучно и может потребовать буфер из кучи
+    void swap(Base& other) {
+        this->swap_elements(other);
+    }
+
+    friend void swap(SmallVector& a, SmallVector& b) {
+        a.swap(b);
+    }
+
+private:
+    T* inline_buffer() noexcept { return reinterpret_cast<T*>(storage_); }
+
+    // Приёмник возвращается во встроенный буфер, забирает элементы other,
+    // а опустевший other возвращается в свой
+    template<std::size_t M>
+    void move_from(SmallVector<T, M, GrowthPolicy, CheckPolicy>& other) {
+        if (static_cast<Base*>(this) == static_cast<Base*>(&other)) return;
+        this->clear();
+        shrink_to_fit();
+        this->take(other);
+        other.shrink_to_fit();
+    }
+
+    alignas(T) unsigned char storage_[N * sizeof(T)];
+};
+
+#endif
@@ -0,0 +1,335 @@
+#ifndef SOA_VECTOR_H
+#define SOA_VECTOR_H
+
+#include "checkPolicy.h"
+#include "containerStats.h"
+#include "simpleVector.h"
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Вектор записей, разложенных по столбцам (structure of arrays): каждое поле
+// хранится в своём непрерывном SimpleVector, и просмотр одного поля читает
+// только его байты, а не всю запись. Цикл по column<I>() идёт по обычному
+// массиву и векторизуется компилятором.
+//
+// Строка доступна как прокси — кортеж ссылок на поля:
+//
+//     SoAVector<int, double> v;
+//     v.emplace_back(1, 2.5);
+//     auto [id, price] = v[0];         // ссылки на элементы столбцов
+//     std::get<1>(v[0]) *= 2;
+//     std::tuple<int, double> row = v[0];
+//
+// Столбцы растут синхронно по политике SimpleVector. Прокси-итератор строк
+// произвольного доступа, но его operator* возвращает кортеж по значению,
+// поэтому алгоритмы, переставляющие элементы (std::sort), с ним не работают.
+template<typename... Fields>
+class SoAVector {
+    static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field");
+
+    template<typename F>
+    using ColumnVector = SimpleVector<F, DefaultGrowthPolicy, NeverCheck>;
+
+    using Indices = std::index_sequence_for<Fields...>;
+
+public:
+    using value_type = std::tuple<Fields...>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::tuple<Fields&...>;
+    using const_reference = std::tuple<const Fields&...>;
+
+    static constexpr size_type field_count = sizeof...(Fields);
+
+    template<size_type I>
+    using field_type = std::tuple_element_t<I, value_type>;
+
+    // Непрерывный массив одного поля; действителен до изменения размера вектора
+    template<typename T>
+    class Column {
+    public:
+        using value_type = std::remove_const_t<T>;
+        using size_type = std::size_t;
+        using iterator = T*;
+
+        Column(T* data, size_type size) noexcept : data_(data), size_(size) {}
+
+        T* data() const noexcept { return data_; }
+        size_type size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+
+        T& operator[](size_type idx) const noexcept { return data_[idx]; }
+
+        T* begin() const noexcept { return data_; }
+        T* end() const noexcept { return data_ + size_; }
+
+    private:
+        T* data_;
+        size_type size_;
+    };
+
+    // Итератор строк: по указателю на каждый столбец
+    template<bool Const>
+    class RowIterator {
+        using Pointers = std::tuple<std::conditional_t<Const, const Fields*, Fields*>...>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = SoAVector::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::conditional_t<Const, SoAVector::const_reference, SoAVector::reference>;
+
+        RowIterator() noexcept = default;
+
+        // Неконстантный итератор приводится к константному
+        template<bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+        RowIterator(const RowIterator<OtherConst>& other) noexcept : ptrs_(other.ptrs_) {}
+
+        reference operator*() const noexcept {
+            return std::apply([](auto*... p) { return reference(*p...); }, ptrs_);
+        }
+        reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+        RowIterator& operator++() noexcept { return *this += 1; }
+        RowIterator operator++(int) noexcept { RowIterator tmp = *this; *this += 1; return tmp; }
+        RowIterator& operator--() noexcept { return *this -= 1; }
+        RowIterator operator--(int) noexcept { RowIterator tmp = *this; *this -= 1; return tmp; }
+
+        RowIterator& operator+=(difference_type n) noexcept {
+            std::apply([n](auto*&... p) { ((p += n), ...); }, ptrs_);
+            return *this;
+        }
+        RowIterator& operator-=(difference_type n) noexcept { return *this += -n; }
+        RowIterator operator+(difference_type n) const noexcept { RowIterator tmp = *this; return tmp += n; }
+        RowIterator operator-(difference_type n) const noexcept { RowIterator tmp = *this; return tmp -= n; }
+        friend RowIterator operator+(difference_type n, const RowIterator& it) noexcept { return it + n; }
+
+        // Свободные друзья, чтобы iterator и const_iterator сравнивались в
+        // любом порядке. Столбцы сдвигаются вместе, сравнивать достаточно первый
+        friend difference_type operator-(const RowIterator& a, const RowIterator& b) noexcept {
+            return a.first() - b.first();
+        }
+        friend bool operator==(const RowIterator& a, const RowIterator& b) noexcept { return a.first() == b.first(); }
+        friend bool operator!=(const RowIterator& a, const RowIterator& b) noexcept { return a.first() != b.first(); }
+        friend bool operator<(const RowIterator& a, const RowIterator& b) noexcept { return a.first() < b.first(); }
+        friend bool operator>(const RowIterator& a, const RowIterator& b) noexcept { return a.first() > b.first(); }
+        friend bool operator<=(const RowIterator& a, const RowIterator& b) noexcept { return a.first() <= b.first(); }
+        friend bool operator>=(const RowIterator& a, const RowIterator& b) noexcept { return a.first() >= b.first(); }
+
+    private:
+        Pointers ptrs_{};
+
+        explicit RowIterator(Pointers ptrs) noexcept : ptrs_(ptrs) {}
+
+        auto first() const noexcept { return std::get<0>(ptrs_); }
+
+        friend class SoAVector;
+        friend class RowIterator<!Const>;
+    };
+
+    using iterator = RowIterator<false>;
+    using const_iterator = RowIterator<true>;
+
+    SoAVector() noexcept = default;
+
+    SoAVector(std::initializer_list<value_type> init) {
+        reserve(init.size());
+        for (const auto& row : init) push_back(row);
+    }
+
+    size_type size() const noexcept { return std::get<0>(columns_).size(); }
+    bool empty() const noexcept { return size() == 0; }
+
+    // Столбцы могут округлять ёмкость по-разному — берём наименьшую
+    size_type capacity() const noexcept {
+        return std::apply([](const auto&... c) { return std::min({c.capacity()...}); }, columns_);
+    }
+
+    void reserve(size_type new_cap) {
+        for_each_column([new_cap](auto& c) { c.reserve(new_cap); });
+    }
+
+    void shrink_to_fit() {
+        for_each_column([](auto& c) { c.shrink_to_fit(); });
+    }
+
+    void clear() noexcept {
+        for_each_column([](auto& c) { c.clear(); });
+    }
+
+    // Столбцы целиком, по одному на поле
+    MemoryUsage memory_usage() const noexcept {
+        MemoryUsage usage;
+        for_each_column([&usage](const auto& c) { usage += c.memory_usage(); });
+        return usage;
+    }
+
+    void push_back(const value_type& row) {
+        std::apply([this](const Fields&... fields) { emplace_back(fields...); }, row);
+    }
+
+    void push_back(value_type&& row) {
+        std::apply([this](Fields&... fields) { emplace_back(std::move(fields)...); }, row);
+    }
+
+    // По одному аргументу на поле, в порядке полей
+    template<typename... Args>
+    reference emplace_back(Args&&... args) {
+        static_assert(sizeof...(Args) == field_count, "emplace_back takes one argument per field");
+        if (size() == capacity()) {
+            // Аргументы могут ссылаться на элементы вектора — создаём строку до переаллокации
+            value_type row(std::forward<Args>(args)...);
+            reserve(grown_capacity());
+            std::apply([this](Fields&... fields) { append(Indices{}, std::move(fields)...); }, row);
+        } else {
+            append(Indices{}, std::forward<Args>(args)...);
+        }
+        return (*this)[size() - 1];
+    }
+
+    // Поля в столбцах: строка приходит копией, поэтому ссылаться на вектор не может
+    void insert(size_type pos, value_type row) {
+        check_position(pos, size());
+        if (size() == capacity()) reserve(grown_capacity());
+        insert_row(Indices{}, pos, std::move(row));
+    }
+
+    void erase(size_type pos) {
+        check_index(pos, size());
+        for_each_column([pos](auto& c) { c.erase(pos); });
+    }
+
+    void erase(size_type first, size_type last) {
+        check_position(last, size());
+        check_position(first, last);
+        for_each_column([first, last](auto& c) { c.erase(first, last); });
+    }
+
+    reference operator[](size_type idx) noexcept { return row(Indices{}, idx); }
+    const_reference operator[](size_type idx) const noexcept { return row(Indices{}, idx); }
+
+    reference at(size_type idx) {
+        check_index(idx, size());
+        return (*this)[idx];
+    }
+
+    const_reference at(size_type idx) const {
+        check_index(idx, size());
+        return (*this)[idx];
+    }
+
+    // Столбец поля I — основной путь для просмотров по одному полю
+    template<size_type I>
+    Column<field_type<I>> column() noexcept {
+        auto& c = std::get<I>(columns_);
+        return Column<field_type<I>>(c.data(), c.size());
+    }
+
+    template<size_type I>
+    Column<const field_type<I>> column() const noexcept {
+        const auto& c = std::get<I>(columns_);
+        return Column<const field_type<I>>(c.data(), c.size());
+    }
+
+    template<size_type I>
+    field_type<I>* data() noexcept { return std::get<I>(columns_).data(); }
+
+    template<size_type I>
+    const field_type<I>* data() const noexcept { return std::get<I>(columns_).data(); }
+
+    iterator begin() noexcept { return iterator(pointers(Indices{}, 0)); }
+    iterator end() noexcept { return iterator(pointers(Indices{}, size())); }
+    const_iterator begin() const noexcept { return const_iterator(pointers(Indices{}, 0)); }
+    const_iterator end() const noexcept { return const_iterator(pointers(Indices{}, size())); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    void swap(SoAVector& other) noexcept {
+        columns_.swap(other.columns_);
+    }
+
+private:
+    std::tuple<ColumnVector<Fields>...> columns_;
+
+    template<typename F>
+    void for_each_column(F f) {
+        std::apply([&f](auto&... c) { (f(c), ...); }, columns_);
+    }
+
+    template<typename F>
+    void for_each_column(F f) const {
+        std::apply([&f](const auto&... c) { (f(c), ...); }, columns_);
+    }
+
+    size_type grown_capacity() const noexcept {
+        const size_type cap = capacity();
+        const auto grown = static_cast<size_type>(cap * DefaultGrowthPolicy::factor);
+        return std::max(cap == 0 ? size_type(1) : grown, size() + 1);
+    }
+
+    // Место под новую строку уже есть во всех столбцах, поэтому поля добавляются
+    // без переаллокаций; если конструктор поля бросил, уже добавленные поля
+    // строки удаляются и вектор остаётся прежним
+    template<std::size_t... Is, typename... Args>
+    void append(std::index_sequence<Is...>, Args&&... args) {
+        std::size_t built = 0;
+        try {
+            ((std::get<Is>(columns_).emplace_back(std::forward<Args>(args)), ++built), ...);
+        } catch (...) {
+            ((Is < built ? std::get<Is>(columns_).erase(std::get<Is>(columns_).size() - 1) : void()), ...);
+            throw;
+        }
+    }
+
+    template<std::size_t... Is>
+    void insert_row(std::index_sequence<Is...>, size_type pos, value_type&& row) {
+        std::size_t built = 0;
+        try {
+            ((std::get<Is>(columns_).insert(pos, std::move(std::get<Is>(row))), ++built), ...);
+        } catch (...) {
+            ((Is < built ? std::get<Is>(columns_).erase(pos) : void()), ...);
+            throw;
+        }
+    }
+
+    template<std::size_t... Is>
+    reference row(std::index_sequence<Is...>, size_type idx) noexcept {
+        return reference(std::get<Is>(columns_)[idx]...);
+    }
+
+    template<std::size_t... Is>
+    const_reference row(std::index_sequence<Is...>, size_type idx) const noexcept {
+        return const_reference(std::get<Is>(columns_)[idx]...);
+    }
+
+    template<std::size_t... Is>
+    std::tuple<Fields*...> pointers(std::index_sequence<Is...>, size_type idx) noexcept {
+        return std::tuple<Fields*...>(std::get<Is>(columns_).data() + idx...);
+    }
+
+    template<std::size_t... Is>
+    std::tuple<const Fields*...> pointers(std::index_sequence<Is...>, size_type idx) const noexcept {
+        return std::tuple<const Fields*...>(std::get<Is>(columns_).data() + idx...);
+    }
+
+    static void check_index(size_type idx, size_type size) {
+        if (LAB3_UNLIKELY(idx >= size)) throw_out_of_range("Index out of range");
+    }
+
+    static void check_position(size_type pos, size_type size) {
+        if (LAB3_UNLIKELY(pos > size)) throw_out_of_range("Position out of range");
+    }
+
+    [[noreturn]] LAB3_COLD static void throw_out_of_range(const char* msg) {
+        throw std::out_of_range(msg);
+    }
+};
+
+#endif // SOA_VECTOR_H
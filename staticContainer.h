@@ -0,0 +1,106 @@
+#ifndef STATIC_CONTAINER_H
+#define STATIC_CONTAINER_H
+
+#include "checkPolicy.h"
+#include "containerStats.h"
+#include <cstddef>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+#include <concepts>
+#define LAB3_HAS_CONCEPTS 1
+#endif
+
+// Общая основа контейнеров со статической диспетчеризацией (CRTP).
+// Виртуальных функций нет: обобщённый код получает конкретный тип контейнера
+// параметром шаблона, и вызовы size(), operator[], push_back встраиваются.
+// Если контейнер нужно выбирать во время выполнения, его оборачивают
+// в ContainerAdaptor из baseContainer.h.
+//
+// Основа StatsCounter даёт контейнерам stats() и счётчики горячих путей;
+// без LAB3_STATS она пуста и места в объекте не занимает.
+template<typename Derived, typename T>
+class StaticContainer : public StatsCounter<> {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+    Derived& derived() noexcept { return static_cast<Derived&>(*this); }
+    const Derived& derived() const noexcept { return static_cast<const Derived&>(*this); }
+
+protected:
+    // Удалять контейнер через указатель на основу нельзя — деструктор защищён
+    StaticContainer() = default;
+    StaticContainer(const StaticContainer&) = default;
+    StaticContainer(StaticContainer&&) = default;
+    StaticContainer& operator=(const StaticContainer&) = default;
+    StaticContainer& operator=(StaticContainer&&) = default;
+    ~StaticContainer() = default;
+
+    static void check_index(size_type idx, size_type size, const char* msg = "Index out of range") {
+        if (LAB3_UNLIKELY(idx >= size)) {
+            throw_out_of_range(msg);
+        }
+    }
+
+    static void check_position(size_type pos, size_type size, const char* msg = "Position out of range") {
+        if (LAB3_UNLIKELY(pos > size)) {
+            throw_out_of_range(msg);
+        }
+    }
+
+private:
+    // Выброс исключения вынесен из встраиваемых проверок, чтобы не раздувать горячий код
+    [[noreturn]] LAB3_COLD static void throw_out_of_range(const char* msg) {
+        throw std::out_of_range(msg);
+    }
+};
+
+// Тип предоставляет интерфейс последовательного контейнера лабораторной:
+// size, empty, clear, push_back, insert и erase по номеру, operator[], print
+template<typename C, typename = void>
+struct is_sequence_container : std::false_type {};
+
+template<typename C>
+struct is_sequence_container<C, std::void_t<
+    typename C::value_type,
+    typename C::size_type,
+    decltype(std::declval<const C&>().size()),
+    decltype(std::declval<const C&>().empty()),
+    decltype(std::declval<C&>().clear()),
+    decltype(std::declval<C&>().push_back(std::declval<const typename C::value_type&>())),
+    decltype(std::declval<C&>().push_back(std::declval<typename C::value_type&&>())),
+    decltype(std::declval<C&>().insert(std::declval<typename C::size_type>(),
+                                       std::declval<const typename C::value_type&>())),
+    decltype(std::declval<C&>().erase(std::declval<typename C::size_type>())),
+    decltype(std::declval<C&>()[std::declval<typename C::size_type>()]),
+    decltype(std::declval<const C&>()[std::declval<typename C::size_type>()]),
+    decltype(std::declval<const C&>().print(std::declval<std::ostream&>()))>>
+    : std::true_type {};
+
+template<typename C>
+inline constexpr bool is_sequence_container_v = is_sequence_container<C>::value;
+
+#ifdef LAB3_HAS_CONCEPTS
+// То же требование в виде концепта (при сборке в режиме C++20)
+template<typename C>
+concept SequenceContainer = requires(C& c, const C& cc, typename C::size_type i,
+                                     const typename C::value_type& value, std::ostream& os) {
+    { cc.size() } -> std::convertible_to<typename C::size_type>;
+    { cc.empty() } -> std::convertible_to<bool>;
+    c.clear();
+    c.push_back(value);
+    c.insert(i, value);
+    c.erase(i);
+    { c[i] } -> std::same_as<typename C::value_type&>;
+    { cc[i] } -> std::same_as<const typename C::value_type&>;
+    cc.print(os);
+};
+#endif
+
+#endif // STATIC_CONTAINER_H
@@ -0,0 +1,350 @@
+#ifndef STREAM_LOADER_H
+#define STREAM_LOADER_H
+
+#include "checkPolicy.h"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <io.h>
+#endif
+
+// Потоковая загрузка контейнеров из файла или дескриптора — обратная
+// операция к print / text::print (textFormat.h):
+//
+//     SimpleVector<int> v;
+//     ingest::load_text(v, "numbers.txt");   // числа через пробелы, переводы строк, ',' или ';'
+//     ingest::load_records(v, fd);           // подряд записанные байты объектов T
+//
+// Файл читается блоками по 1 МБ прямо через read(2), числа разбираются
+// std::from_chars без локали и копирования в строки. Элементы добавляются
+// в конец контейнера; возвращается их число.
+//
+// Пре-аллокация по длине файла (у канала или сокета длины нет):
+// - load_records знает точное число записей, и SimpleVector читает их
+//   прямо в свой буфер без промежуточной копии;
+// - load_text оценивает число элементов по первому разобранному блоку и
+//   резервирует место под весь файл сразу;
+// - списки получают reserve_nodes: PoolAllocator выделяет узлы одним
+//   slab'ом, а не по одному.
+//
+// Ошибки: std::system_error — не удалось открыть или прочитать файл,
+// ingest::parse_error — не число, переполнение типа или обрезанная запись.
+// Элементы, прочитанные до ошибки, остаются в контейнере
+
+namespace ingest {
+
+// Текст не разбирается как последовательность чисел типа T
+class parse_error : public std::runtime_error {
+public:
+    parse_error(const std::string& what, std::uint64_t offset)
+        : std::runtime_error(what + " at byte " + std::to_string(offset)), offset_(offset) {}
+
+    // Смещение от начала чтения до места ошибки
+    std::uint64_t offset() const noexcept { return offset_; }
+
+private:
+    std::uint64_t offset_;
+};
+
+// Размер блока чтения
+constexpr std::size_t read_chunk = std::size_t(1) << 20;
+
+namespace ingest_detail {
+
+[[noreturn]] LAB3_COLD inline void throw_system(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+[[noreturn]] LAB3_COLD inline void throw_parse(const char* what, std::uint64_t offset) {
+    throw parse_error(what, offset);
+}
+
+} // namespace ingest_detail
+
+// Чтение из дескриптора; дескриптор не закрывается
+class FdReader {
+public:
+    explicit FdReader(int fd) noexcept : fd_(fd) {
+#if defined(POSIX_FADV_SEQUENTIAL)
+        // Для последовательного чтения ядро читает вперёд агрессивнее
+        ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    }
+
+    // Сколько байт осталось до конца обычного файла; 0 — неизвестно
+    std::uint64_t remaining_bytes() const noexcept {
+#if defined(__unix__) || defined(__APPLE__)
+        struct stat st;
+        if (::fstat(fd_, &st) != 0 || !S_ISREG(st.st_mode)) return 0;
+        const ::off_t pos = ::lseek(fd_, 0, SEEK_CUR);
+#elif defined(_WIN32)
+        struct _stati64 st;
+        if (::_fstati64(fd_, &st) != 0 || (st.st_mode & _S_IFREG) == 0) return 0;
+        const __int64 pos = ::_lseeki64(fd_, 0, SEEK_CUR);
+#else
+        return 0;
+#endif
+        if (pos < 0 || pos >= st.st_size) return 0;
+        return static_cast<std::uint64_t>(st.st_size - pos);
+    }
+
+    // Читает до size байт; 0 — конец файла
+    std::size_t read(char* dst, std::size_t size) {
+        for (;;) {
+#if defined(__unix__) || defined(__APPLE__)
+            const ::ssize_t got = ::read(fd_, dst, size);
+#elif defined(_WIN32)
+            const int got = ::_read(fd_, dst, static_cast<unsigned>(std::min<std::size_t>(size, 1u << 30)));
+#else
+            const int got = -1;
+#endif
+            if (LAB3_LIKELY(got >= 0)) return static_cast<std::size_t>(got);
+            if (errno != EINTR) ingest_detail::throw_system("read failed");
+        }
+    }
+
+    // Читает ровно size байт или до конца файла; возвращает прочитанное
+    std::size_t read_full(char* dst, std::size_t size) {
+        std::size_t total = 0;
+        while (total < size) {
+            const std::size_t got = read(dst + total, size - total);
+            if (got == 0) break;
+            total += got;
+        }
+        return total;
+    }
+
+private:
+    int fd_;
+};
+
+// Открытый на чтение файл; закрывается в деструкторе
+class InputFile {
+public:
+    explicit InputFile(const std::string& path) {
+#if defined(__unix__) || defined(__APPLE__)
+        fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+#elif defined(_WIN32)
+        fd_ = ::_open(path.c_str(), _O_RDONLY | _O_BINARY);
+#endif
+        if (fd_ < 0) ingest_detail::throw_system("Cannot open " + path);
+    }
+
+    InputFile(const InputFile&) = delete;
+    InputFile& operator=(const InputFile&) = delete;
+
+    ~InputFile() {
+#if defined(__unix__) || defined(__APPLE__)
+        ::close(fd_);
+#elif defined(_WIN32)
+        ::_close(fd_);
+#endif
+    }
+
+    int fd() const noexcept { return fd_; }
+
+private:
+    int fd_ = -1;
+};
+
+// Разделители чисел в тексте
+constexpr bool is_separator(char c) noexcept {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == ',' || c == ';' || c == '\v' || c == '\f';
+}
+
+// Разбирает числа из fd и передаёт каждое в push(T). После первого блока
+// вызывает hint(n) с оценкой числа элементов во всём файле (если длина
+// файла известна). Число, разрезанное границей блока, переносится в
+// начало следующего
+template<typename T, typename Push, typename Hint>
+std::uint64_t parse_text(int fd, Push push, Hint hint) {
+    static_assert((std::is_integral_v<T> || std::is_floating_point_v<T>) && !std::is_same_v<T, bool>,
+                  "parse_text reads numbers");
+    using ingest_detail::throw_parse;
+
+    FdReader in(fd);
+    const std::uint64_t total_bytes = in.remaining_bytes();
+    std::unique_ptr<char[]> buffer(new char[read_chunk]);
+    std::uint64_t buffer_offset = 0;  // смещение buffer[0] от начала чтения
+    std::uint64_t count = 0;
+    std::size_t kept = 0;
+    bool hinted = total_bytes == 0;
+
+    for (;;) {
+        const std::size_t got = in.read(buffer.get() + kept, read_chunk - kept);
+        const bool eof = got == 0;
+        char* const begin = buffer.get();
+        char* const end = begin + kept + got;
+
+        // Хвост после последнего разделителя может продолжиться в следующем блоке
+        char* parse_end = end;
+        if (!eof) {
+            while (parse_end != begin && !is_separator(parse_end[-1])) --parse_end;
+            if (parse_end == begin) {
+                if (kept + got == read_chunk) throw_parse("Number does not fit the read buffer", buffer_offset);
+                kept += got;
+                continue;
+            }
+        }
+
+        for (const char* p = begin;;) {
+            while (p != parse_end && is_separator(*p)) ++p;
+            if (p == parse_end) break;
+            T value;
+            const auto result = std::from_chars(p, static_cast<const char*>(parse_end), value);
+            if (LAB3_UNLIKELY(result.ec != std::errc() ||
+                              (result.ptr != parse_end && !is_separator(*result.ptr)))) {
+                throw_parse(result.ec == std::errc::result_out_of_range ? "Number out of range" : "Not a number",
+                            buffer_offset + static_cast<std::uint64_t>(p - begin));
+            }
+            push(value);
+            ++count;
+            p = result.ptr;
+        }
+
+        if (!hinted && count > 0) {
+            // Элементов на байт в первом блоке, с запасом в 1/16
+            const double per_byte = static_cast<double>(count) / static_cast<double>(parse_end - begin);
+            hint(static_cast<std::uint64_t>(per_byte * static_cast<double>(total_bytes) * 17 / 16));
+            hinted = true;
+        }
+        if (eof) break;
+
+        kept = static_cast<std::size_t>(end - parse_end);
+        std::memmove(begin, parse_end, kept);
+        buffer_offset += static_cast<std::uint64_t>(parse_end - begin);
+    }
+    return count;
+}
+
+// Записи по sizeof(T) байт подряд (без заголовка binaryIO.h). Каждая
+// передаётся в push(T); неполная последняя запись — parse_error. skipped —
+// сколько байт уже прочитано до вызова: смещение ошибки считается от начала
+template<typename T, typename Push>
+std::uint64_t read_records(int fd, Push push, std::uint64_t skipped = 0) {
+    static_assert(std::is_trivially_copyable_v<T>, "records must be trivially copyable");
+    FdReader in(fd);
+    constexpr std::size_t per_chunk = std::max<std::size_t>(1, read_chunk / sizeof(T));
+    std::unique_ptr<unsigned char[]> buffer(new unsigned char[per_chunk * sizeof(T)]);
+    std::uint64_t count = 0;
+    for (;;) {
+        const std::size_t got = in.read_full(reinterpret_cast<char*>(buffer.get()), per_chunk * sizeof(T));
+        const std::size_t records = got / sizeof(T);
+        for (std::size_t i = 0; i < records; ++i) {
+            T value;
+            std::memcpy(static_cast<void*>(&value), buffer.get() + i * sizeof(T), sizeof(T));
+            push(value);
+        }
+        count += records;
+        if (got % sizeof(T) != 0) ingest_detail::throw_parse("Truncated record", skipped + count * sizeof(T));
+        if (got < per_chunk * sizeof(T)) return count;
+    }
+}
+
+namespace ingest_detail {
+
+template<typename C, typename = void>
+struct has_reserve : std::false_type {};
+
+template<typename C>
+struct has_reserve<C, std::void_t<decltype(std::declval<C&>().reserve(std::size_t()))>> : std::true_type {};
+
+template<typename C, typename = void>
+struct has_reserve_nodes : std::false_type {};
+
+template<typename C>
+struct has_reserve_nodes<C, std::void_t<decltype(std::declval<C&>().reserve_nodes(std::size_t()))>>
+    : std::true_type {};
+
+// Непрерывный буфер, в который можно читать напрямую
+template<typename C, typename = void>
+struct has_overwrite_storage : std::false_type {};
+
+template<typename C>
+struct has_overwrite_storage<C, std::void_t<decltype(std::declval<C&>().resize_for_overwrite(std::size_t())),
+                                            decltype(std::declval<C&>().data())>>
+    : std::true_type {};
+
+// Место ещё под count элементов, если контейнер это умеет
+template<typename Container>
+void reserve_more(Container& c, std::uint64_t count) {
+    const auto n = static_cast<std::size_t>(std::min<std::uint64_t>(count, SIZE_MAX / 2));
+    if constexpr (has_reserve<Container>::value) {
+        c.reserve(c.size() + n);
+    } else if constexpr (has_reserve_nodes<Container>::value) {
+        c.reserve_nodes(n);
+    }
+}
+
+} // namespace ingest_detail
+
+template<typename Container>
+std::uint64_t load_text(Container& c, int fd) {
+    using T = typename Container::value_type;
+    return parse_text<T>(fd, [&c](T value) { c.push_back(value); },
+                         [&c](std::uint64_t estimate) { ingest_detail::reserve_more(c, estimate); });
+}
+
+template<typename Container>
+std::uint64_t load_text(Container& c, const std::string& path) {
+    InputFile file(path);
+    return load_text(c, file.fd());
+}
+
+template<typename Container>
+std::uint64_t load_records(Container& c, int fd) {
+    using T = typename Container::value_type;
+    const std::uint64_t expected = FdReader(fd).remaining_bytes() / sizeof(T);
+    std::uint64_t direct = 0;
+
+    if constexpr (ingest_detail::has_overwrite_storage<Container>::value) {
+        // Длина известна: записи читаются прямо в буфер вектора
+        if (expected > 0) {
+            const std::size_t old_size = c.size();
+            c.resize_for_overwrite(old_size + static_cast<std::size_t>(expected));
+            std::size_t got = 0;
+            try {
+                got = FdReader(fd).read_full(reinterpret_cast<char*>(c.data() + old_size), expected * sizeof(T));
+            } catch (...) {
+                c.resize(old_size);
+                throw;
+            }
+            direct = got / sizeof(T);
+            if (got < expected * sizeof(T)) {
+                // Файл укоротился во время чтения
+                c.resize(old_size + static_cast<std::size_t>(direct));
+                if (got % sizeof(T) != 0) ingest_detail::throw_parse("Truncated record", got - got % sizeof(T));
+                return direct;
+            }
+        }
+    } else {
+        ingest_detail::reserve_more(c, expected);
+    }
+    // Остаток: канал без длины или файл, выросший во время чтения
+    return direct + read_records<T>(fd, [&c](const T& value) { c.push_back(value); }, direct * sizeof(T));
+}
+
+template<typename Container>
+std::uint64_t load_records(Container& c, const std::string& path) {
+    InputFile file(path);
+    return load_records(c, file.fd());
+}
+
+} // namespace ingest
+
+#endif // STREAM_LOADER_H
@@ -0,0 +1,249 @@
+// Двоичный формат (binaryIO.h): save/load между разными контейнерами,
+// кодек строк, map_view/map_private и отказ загружать чужой, обрезанный или
+// испорченный файл без изменения контейнера
+
+#include "testing.h"
+
+#include "binaryIO.h"
+#include "doublyLinkedList.h"
+#include "nodePool.h"
+#include "simpleVector.h"
+#include "singlyLinkedList.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Временный файл; удаляется вместе с объектом
+class TempFile {
+public:
+    explicit TempFile(const std::string& name)
+        : path_((std::filesystem::temp_directory_path() / ("lab3_tests_" + name)).string()) {}
+    ~TempFile() { std::remove(path_.c_str()); }
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+
+    const std::string& path() const noexcept { return path_; }
+
+    void write(const std::string& bytes) const {
+        std::ofstream os(path_, std::ios::binary | std::ios::trunc);
+        os.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+private:
+    std::string path_;
+};
+
+struct Point {
+    int x;
+    double y;
+};
+
+template<typename Container>
+std::string saved(const Container& c) {
+    std::ostringstream os(std::ios::binary);
+    c.save(os);
+    return os.str();
+}
+
+template<typename Container>
+std::vector<typename Container::value_type> items(const Container& c) {
+    return std::vector<typename Container::value_type>(c.begin(), c.end());
+}
+
+// load из bytes должен бросить format_error и оставить контейнер как был
+template<typename Container>
+bool rejects(const std::string& bytes, Container& c) {
+    const auto before = items(c);
+    std::istringstream is(bytes, std::ios::binary);
+    try {
+        c.load(is);
+    } catch (const binary::format_error&) {
+        return items(c) == before && c.size() == before.size();
+    }
+    return false;
+}
+
+void roundTrips() {
+    SimpleVector<int> v;
+    for (int i = 0; i < 100000; ++i) v.push_back(i * 3 - 7);
+    const std::vector<int> expect = items(v);
+    const std::string bytes = saved(v);
+    CHECK(bytes.size() == binary::header_size + expect.size() * sizeof(int));
+
+    SinglyLinkedList<int> singly{1, 2};
+    std::istringstream a(bytes, std::ios::binary);
+    singly.load(a);
+    CHECK(items(singly) == expect && singly.size() == expect.size());
+
+    DoublyLinkedList<int, PoolAllocator<int>> pooled;
+    std::istringstream b(saved(singly), std::ios::binary);
+    pooled.load(b);
+    CHECK(items(pooled) == expect && pooled.size() == expect.size());
+
+    // Через файл: список пишет блоками, вектор читает прямо в буфер
+    TempFile file("round_trip.bin");
+    {
+        std::ofstream os(file.path(), std::ios::binary);
+        pooled.save(os);
+    }
+    SimpleVector<int> back{5};
+    std::ifstream is(file.path(), std::ios::binary);
+    back.load(is);
+    CHECK(items(back) == expect);
+
+    // Пустой контейнер и составной тривиально копируемый тип
+    const SimpleVector<int> empty;
+    std::istringstream c(saved(empty), std::ios::binary);
+    back.load(c);
+    CHECK(back.empty());
+
+    DoublyLinkedList<Point> points{{1, 0.5}, {-2, 1e300}, {3, -0.0}};
+    std::istringstream d(saved(points), std::ios::binary);
+    SimpleVector<Point> loaded;
+    loaded.load(d);
+    CHECK(loaded.size() == 3 && loaded[1].x == -2 && loaded[1].y == 1e300 && std::signbit(loaded[2].y));
+}
+
+void strings() {
+    SimpleVector<std::string> v;
+    v.push_back("");
+    v.push_back("short");
+    v.push_back(std::string("with\0zero", 9));
+    v.push_back(std::string(100000, 'x'));
+    for (int i = 0; i < 1000; ++i) v.push_back(std::to_string(i));
+
+    DoublyLinkedList<std::string> list;
+    std::istringstream a(saved(v), std::ios::binary);
+    list.load(a);
+    CHECK(items(list) == items(v));
+
+    TempFile file("strings.bin");
+    {
+        std::ofstream os(file.path(), std::ios::binary);
+        list.save(os);
+    }
+    SinglyLinkedList<std::string> singly;
+    std::ifstream is(file.path(), std::ios::binary);
+    singly.load(is);
+    CHECK(items(singly) == items(v) && singly.size() == v.size());
+
+    // Обрезанная строка посередине и длина больше остатка файла
+    std::string bytes = saved(v);
+    SimpleVector<std::string> kept{"a", "b"};
+    CHECK(rejects(bytes.substr(0, bytes.size() - 2), kept));
+    CHECK(rejects(bytes.substr(0, binary::header_size + 20), kept));
+}
+
+void mappedViews() {
+    SimpleVector<double> v;
+    for (int i = 0; i < 5000; ++i) v.push_back(i * 0.25);
+    TempFile file("mapped.bin");
+    {
+        std::ofstream os(file.path(), std::ios::binary);
+        v.save(os);
+    }
+
+    {
+        const auto view = SimpleVector<double>::map_view(file.path());
+        CHECK(view.size() == v.size());
+        CHECK(reinterpret_cast<std::uintptr_t>(view.data()) % binary::header_size == 0);
+        CHECK(std::vector<double>(view.begin(), view.end()) == items(v));
+        CHECK(view.at(4999) == 4999 * 0.25);
+        CHECK_THROWS(view.at(5000), std::out_of_range);
+    }
+
+    // Изменения map_private не попадают в файл
+    {
+        auto priv = SimpleVector<double>::map_private(file.path());
+        priv[0] = -1.0;
+        priv[4999] = -2.0;
+        CHECK(priv[0] == -1.0 && priv[1] == 0.25);
+    }
+    const auto again = SimpleVector<double>::map_view(file.path());
+    CHECK(again[0] == 0.0 && again[4999] == 4999 * 0.25);
+
+    CHECK_THROWS(SimpleVector<float>::map_view(file.path()), binary::format_error);
+    CHECK_THROWS(SimpleVector<std::int64_t>::map_view(file.path()), binary::format_error);
+    CHECK_THROWS(SimpleVector<double>::map_view(file.path() + ".missing"), std::runtime_error);
+
+    const SimpleVector<double> empty;
+    TempFile empty_file("mapped_empty.bin");
+    {
+        std::ofstream os(empty_file.path(), std::ios::binary);
+        empty.save(os);
+    }
+    CHECK(SimpleVector<double>::map_view(empty_file.path()).empty());
+
+    // Файл обрезан: заголовок обещает больше элементов, чем есть
+    std::string bytes = saved(v);
+    TempFile cut("mapped_cut.bin");
+    cut.write(bytes.substr(0, bytes.size() - 1));
+    CHECK_THROWS(SimpleVector<double>::map_view(cut.path()), binary::format_error);
+}
+
+void formatErrors() {
+    SimpleVector<int> v{1, 2, 3, 4, 5};
+    const std::string bytes = saved(v);
+
+    // Другой тип элементов: размер, код типа, кодек
+    SimpleVector<float> floats{0.5f};
+    SimpleVector<unsigned> unsigneds{7u};
+    SimpleVector<short> shorts{3};
+    SimpleVector<std::string> strings{"s"};
+    CHECK(rejects(bytes, floats));
+    CHECK(rejects(bytes, unsigneds));
+    CHECK(rejects(bytes, shorts));
+    CHECK(rejects(bytes, strings));
+    CHECK(rejects(saved(strings), v));
+
+    // Обрезан заголовок или данные
+    SimpleVector<int> target{7, 8, 9};
+    SinglyLinkedList<int> singly{7, 8, 9};
+    DoublyLinkedList<int> doubly{7, 8, 9};
+    for (std::size_t cut : {std::size_t(0), std::size_t(10), binary::header_size - 1, bytes.size() - 1}) {
+        CHECK(rejects(bytes.substr(0, cut), target));
+        CHECK(rejects(bytes.substr(0, cut), singly));
+        CHECK(rejects(bytes.substr(0, cut), doubly));
+    }
+
+    // Испорченные magic, версия, порядок байт и число элементов
+    auto patched = [&bytes](std::size_t offset, std::uint64_t value, std::size_t width) {
+        std::string b = bytes;
+        std::memcpy(&b[offset], &value, width);
+        return b;
+    };
+    CHECK(rejects(patched(0, 0x4e4942334241414cULL, 8), target));
+    CHECK(rejects(patched(8, 99, 4), target));
+    CHECK(rejects(patched(12, 0x04030201, 4), singly));
+    CHECK(rejects(patched(32, 6, 8), doubly));
+    CHECK(rejects(patched(32, std::uint64_t(1) << 62, 8), target));
+
+    // Строки: число элементов больше, чем может поместиться в остаток файла
+    std::string text = saved(strings);
+    std::uint64_t huge = std::uint64_t(1) << 60;
+    std::memcpy(&text[32], &huge, sizeof huge);
+    CHECK(rejects(text, strings));
+
+    CHECK(items(target) == (std::vector<int>{7, 8, 9}));
+}
+
+void registerAll() {
+    test::registerTest("BinaryIO/round_trips", roundTrips);
+    test::registerTest("BinaryIO/strings", strings);
+    test::registerTest("BinaryIO/mapped_views", mappedViews);
+    test::registerTest("BinaryIO/format_errors", formatErrors);
+}
+
+TEST_REGISTRATION(registerAll);
+
+} // namespace
@@ -0,0 +1,131 @@
+// Проверка номеров: at() и operator[] SimpleVector и SmallVector при
+// AlwaysCheck, DebugCheck и NeverCheck (без проверки operator[] только
+// даёт адрес в буфере, элемент за size() не читается), а также контейнеры
+// без политики — у них operator[] и at() проверяют номер всегда
+
+#include "testing.h"
+
+#include "checkPolicy.h"
+#include "concurrentVector.h"
+#include "doublyLinkedList.h"
+#include "persistentVector.h"
+#include "simpleVector.h"
+#include "singlyLinkedList.h"
+#include "smallVector.h"
+#include "soaVector.h"
+#include "unrolledList.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+namespace {
+
+static_assert(std::is_same_v<DefaultCheckPolicy, DebugCheck>);
+static_assert(AlwaysCheck::check_index && !NeverCheck::check_index);
+#ifdef NDEBUG
+static_assert(!DebugCheck::check_index);
+#else
+static_assert(DebugCheck::check_index);
+#endif
+
+constexpr std::size_t kTooFar = static_cast<std::size_t>(-1);
+
+// Четыре элемента при ёмкости не меньше восьми: номер 4 лежит в буфере
+template<typename Vector, typename Policy>
+void vectorAccess() {
+    constexpr bool checked = Policy::check_index;
+    Vector v;
+    v.reserve(8);
+    for (int i = 0; i < 4; ++i) v.push_back(i * 10);
+    const Vector& shared = v;
+
+    CHECK(v.at(3) == 30 && shared.at(0) == 0 && v[2] == 20 && shared[1] == 10);
+    v.at(1) = 11;
+    CHECK(v[1] == 11);
+
+    // at() проверяет при любой политике
+    CHECK_THROWS(v.at(4), std::out_of_range);
+    CHECK_THROWS(shared.at(4), std::out_of_range);
+    CHECK_THROWS(v.at(kTooFar), std::out_of_range);
+
+    if constexpr (checked) {
+        CHECK_THROWS(v[4], std::out_of_range);
+        CHECK_THROWS(shared[4], std::out_of_range);
+        CHECK_THROWS(v[kTooFar], std::out_of_range);
+    } else {
+        CHECK(&v[4] == v.data() + 4 && &shared[4] == shared.data() + 4);
+    }
+
+    v.clear();
+    CHECK_THROWS(v.at(0), std::out_of_range);
+    if constexpr (checked) CHECK_THROWS(v[0], std::out_of_range);
+    else CHECK(&v[0] == v.data());
+}
+
+// Списки и остальные контейнеры без политики: operator[] с проверкой
+template<typename Container>
+void alwaysCheckedIndex() {
+    Container c;
+    for (int i = 0; i < 4; ++i) c.push_back(i * 10);
+    const Container& shared = c;
+    CHECK(c[3] == 30 && shared[0] == 0);
+    CHECK_THROWS(c[4], std::out_of_range);
+    CHECK_THROWS(shared[4], std::out_of_range);
+    CHECK_THROWS(c[kTooFar], std::out_of_range);
+    c.clear();
+    CHECK_THROWS(c[0], std::out_of_range);
+    CHECK_THROWS(shared[0], std::out_of_range);
+}
+
+void persistentAt() {
+    PersistentVector<int> v;
+    for (int i = 0; i < 4; ++i) v.push_back(i * 10);
+    const PersistentVector<int>& shared = v;
+    CHECK(v.at(3) == 30 && shared.at(0) == 0);
+    CHECK_THROWS(v.at(4), std::out_of_range);
+    CHECK_THROWS(shared.at(kTooFar), std::out_of_range);
+}
+
+// У SoAVector и ConcurrentVector operator[] noexcept и без проверки, как у
+// std::vector; проверяет только at()
+void soaAt() {
+    SoAVector<int, std::string> v;
+    v.emplace_back(1, "one");
+    v.emplace_back(2, "two");
+    const auto& shared = v;
+    CHECK(std::get<0>(v.at(1)) == 2 && std::get<1>(shared.at(0)) == "one");
+    CHECK_THROWS(v.at(2), std::out_of_range);
+    CHECK_THROWS(shared.at(kTooFar), std::out_of_range);
+}
+
+void concurrentAt() {
+    ConcurrentVector<int> v;
+    for (int i = 0; i < 4; ++i) v.push_back(i * 10);
+    const ConcurrentVector<int>& shared = v;
+    CHECK(v.at(3) == 30 && shared.at(0) == 0);
+    CHECK_THROWS(v.at(4), std::out_of_range);
+    CHECK_THROWS(shared.at(kTooFar), std::out_of_range);
+}
+
+void registerAll() {
+    test::registerTest("CheckPolicy/SimpleVector/always", vectorAccess<SimpleVector<int, DefaultGrowthPolicy, AlwaysCheck>, AlwaysCheck>);
+    test::registerTest("CheckPolicy/SimpleVector/debug", vectorAccess<SimpleVector<int, DefaultGrowthPolicy, DebugCheck>, DebugCheck>);
+    test::registerTest("CheckPolicy/SimpleVector/never", vectorAccess<SimpleVector<int, DefaultGrowthPolicy, NeverCheck>, NeverCheck>);
+    test::registerTest("CheckPolicy/SmallVector/always", vectorAccess<SmallVector<int, 8, DefaultGrowthPolicy, AlwaysCheck>, AlwaysCheck>);
+    test::registerTest("CheckPolicy/SmallVector/debug", vectorAccess<SmallVector<int, 8, DefaultGrowthPolicy, DebugCheck>, DebugCheck>);
+    test::registerTest("CheckPolicy/SmallVector/never", vectorAccess<SmallVector<int, 8, DefaultGrowthPolicy, NeverCheck>, NeverCheck>);
+    test::registerTest("CheckPolicy/SinglyLinkedList/index", alwaysCheckedIndex<SinglyLinkedList<int>>);
+    test::registerTest("CheckPolicy/DoublyLinkedList/index", alwaysCheckedIndex<DoublyLinkedList<int>>);
+    test::registerTest("CheckPolicy/UnrolledList/index", alwaysCheckedIndex<UnrolledList<int, 8>>);
+    test::registerTest("CheckPolicy/PersistentVector/index", alwaysCheckedIndex<PersistentVector<int>>);
+    test::registerTest("CheckPolicy/PersistentVector/at", persistentAt);
+    test::registerTest("CheckPolicy/SoAVector/at", soaAt);
+    test::registerTest("CheckPolicy/ConcurrentVector/at", concurrentAt);
+}
+
+TEST_REGISTRATION(registerAll);
+
+} // namespace
@@ -0,0 +1,226 @@
+// ConcurrentQueue и HazardPointers: много производителей и потребителей
+// (порядок элементов каждого производителя, ничего не теряется и не
+// дублируется), отложенное освобождение узлов с проверкой слотов, передача
+// отложенного завершившимся потоком в общий список и очередь, разрушаемая
+// с элементами. Гонки ловит сборка с LAB3_SANITIZE=thread
+
+#include "testing.h"
+
+#include "concurrentQueue.h"
+#include "hazardPointers.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr int kProducers = 4;
+constexpr int kConsumers = 4;
+
+// Номер производителя в старших битах, порядковый номер — в младших
+constexpr std::uint64_t encode(int producer, int seq) {
+    return (static_cast<std::uint64_t>(producer) << 32) | static_cast<std::uint32_t>(seq);
+}
+
+void producersConsumers() {
+    constexpr int kPerProducer = 20000;
+    ConcurrentQueue<std::uint64_t> q;
+    std::atomic<int> consumed{0};
+
+    std::vector<std::vector<std::uint64_t>> taken(kConsumers);
+    std::vector<std::thread> threads;
+    for (int c = 0; c < kConsumers; ++c) {
+        threads.emplace_back([&q, &consumed, &taken, c] {
+            // Поток извлекает элементы одного производителя в порядке их добавления
+            std::vector<int> last(kProducers, -1);
+            bool ordered = true;
+            while (consumed.load(std::memory_order_relaxed) < kProducers * kPerProducer) {
+                auto value = q.try_pop_front();
+                if (!value) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                consumed.fetch_add(1, std::memory_order_relaxed);
+                const int producer = static_cast<int>(*value >> 32);
+                const int seq = static_cast<int>(*value & 0xffffffffu);
+                ordered = ordered && seq > last[producer];
+                last[producer] = seq;
+                taken[c].push_back(*value);
+            }
+            CHECK(ordered);
+        });
+    }
+    for (int p = 0; p < kProducers; ++p) {
+        threads.emplace_back([&q, p] {
+            for (int i = 0; i < kPerProducer; ++i) q.push_back(encode(p, i));
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    std::vector<std::uint64_t> all;
+    for (const auto& part : taken) all.insert(all.end(), part.begin(), part.end());
+    std::sort(all.begin(), all.end());
+    std::vector<std::uint64_t> expected;
+    for (int p = 0; p < kProducers; ++p) {
+        for (int i = 0; i < kPerProducer; ++i) expected.push_back(encode(p, i));
+    }
+    CHECK(all == expected);
+    CHECK(q.empty() && !q.try_pop_front());
+}
+
+// Один поток — обычная FIFO-очередь; узлы переживают короткоживущие потоки
+void sequentialAndShortThreads() {
+    ConcurrentQueue<std::string> q;
+    CHECK(q.empty() && !q.try_pop_front());
+    for (int i = 0; i < 100; ++i) q.emplace_back(std::to_string(i));
+    bool fifo = true;
+    for (int i = 0; i < 50; ++i) fifo = fifo && q.try_pop_front() == std::to_string(i);
+    CHECK(fifo && !q.empty());
+
+    // Каждый поток снимает узлы и завершается: отложенное уходит в общий список
+    for (int round = 0; round < 20; ++round) {
+        std::thread([&q, round] {
+            std::string marker = "r";
+            marker += std::to_string(round);
+            q.push_back(std::move(marker));
+            for (int i = 0; i < 200; ++i) {
+                q.push_back("x");
+                q.try_pop_front();
+            }
+        }).join();
+    }
+    int left = 0;
+    while (q.try_pop_front()) ++left;
+    CHECK(left == 50 + 20);
+}
+
+// Считает живые элементы: разрушение очереди уничтожает оставшиеся
+struct Counted {
+    static inline std::atomic<int> live{0};
+    std::string text;
+
+    explicit Counted(std::string t) : text(std::move(t)) { ++live; }
+    Counted(Counted&& other) noexcept : text(std::move(other.text)) { ++live; }
+    ~Counted() { --live; }
+};
+
+void destroyNonEmpty() {
+    {
+        ConcurrentQueue<Counted> q;
+        std::vector<std::thread> producers;
+        for (int p = 0; p < kProducers; ++p) {
+            producers.emplace_back([&q, p] {
+                for (int i = 0; i < 1000; ++i) q.emplace_back(std::to_string(p * 1000 + i));
+            });
+        }
+        for (auto& t : producers) t.join();
+        for (int i = 0; i < 1500; ++i) CHECK(q.try_pop_front().has_value());
+        CHECK(Counted::live == kProducers * 1000 - 1500);
+    }
+    CHECK(Counted::live == 0);
+
+    // Пустая очередь — только фиктивный узел
+    { ConcurrentQueue<Counted> q; }
+    CHECK(Counted::live == 0);
+}
+
+// Отложенный узел: deleter отмечает освобождение
+struct Tracked {
+    std::atomic<bool>* freed;
+};
+
+void deleteTracked(void* pointer) {
+    Tracked* tracked = static_cast<Tracked*>(pointer);
+    tracked->freed->store(true);
+    delete tracked;
+}
+
+void retire(HazardPointers::Guard& guard, Tracked* tracked) {
+    guard.retire(tracked, &deleteTracked);
+}
+
+void waitFor(const std::atomic<int>& stage, int value) {
+    while (stage.load() < value) std::this_thread::yield();
+}
+
+// Проверка освобождает всё, кроме защищённого слотом; завершение потока
+// освобождает и его, когда слот очищен
+void retireAndScan() {
+    constexpr int kCount = 2000;
+    std::vector<std::atomic<bool>> freed(kCount);
+    std::atomic<bool> kept_freed{false};
+
+    std::thread([&freed, &kept_freed] {
+        HazardPointers::Guard guard;
+        Tracked* kept = new Tracked{&kept_freed};
+        guard.set(0, kept);
+        retire(guard, kept);
+        // Ниже порога ничего не проверяется
+        CHECK(!kept_freed.load());
+
+        for (int i = 0; i < kCount; ++i) retire(guard, new Tracked{&freed[i]});
+        const auto released = std::count_if(freed.begin(), freed.end(),
+                                            [](const std::atomic<bool>& f) { return f.load(); });
+        CHECK(released > kCount / 2);
+        CHECK(!kept_freed.load());
+        guard.clear(0);
+    }).join();
+
+    CHECK(kept_freed.load());
+    CHECK(std::all_of(freed.begin(), freed.end(), [](const std::atomic<bool>& f) { return f.load(); }));
+}
+
+// Узел, защищённый другим потоком, переживает завершение отложившего его
+// потока в общем списке и освобождается при следующей проверке
+void orphanHandoff() {
+    std::atomic<bool> freed{false};
+    std::atomic<int> stage{0};
+    Tracked* node = new Tracked{&freed};
+
+    std::thread holder([&stage, node] {
+        HazardPointers::Guard guard;
+        guard.set(0, node);
+        stage = 1;
+        waitFor(stage, 2);
+        guard.clear(0);
+        stage = 3;
+        waitFor(stage, 4);
+    });
+    waitFor(stage, 1);
+
+    std::thread([node] {
+        HazardPointers::Guard guard;
+        retire(guard, node);
+    }).join();
+    CHECK(!freed.load());
+
+    stage = 2;
+    waitFor(stage, 3);
+    // Любой поток подбирает общий список при своей проверке
+    std::atomic<bool> own{false};
+    std::thread([&own] {
+        HazardPointers::Guard guard;
+        retire(guard, new Tracked{&own});
+    }).join();
+    CHECK(freed.load() && own.load());
+
+    stage = 4;
+    holder.join();
+}
+
+void registerAll() {
+    test::registerTest("ConcurrentQueue/producers_consumers", producersConsumers);
+    test::registerTest("ConcurrentQueue/sequential_and_short_threads", sequentialAndShortThreads);
+    test::registerTest("ConcurrentQueue/destroy_non_empty", destroyNonEmpty);
+    test::registerTest("HazardPointers/retire_and_scan", retireAndScan);
+    test::registerTest("HazardPointers/orphan_handoff", orphanHandoff);
+}
+
+TEST_REGISTRATION(registerAll);
+
+} // namespace
@@ -0,0 +1,147 @@
+// ConcurrentVector: добавление из нескольких потоков, снимки читателей во
+// время записи и бросающие копирования в push_back / grow_by. Гонки ловит
+// сборка с LAB3_SANITIZE=thread
+
+#include "testing.h"
+
+#include "concurrentVector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int kThreads = 4;
+
+// Копирование бросает исключение, когда budget доходит до нуля; -1 — без ограничений.
+// live считает существующие объекты
+struct Boom {
+    static int budget;
+    static int live;
+    std::string text;
+
+    Boom(int v) : text(std::to_string(v)) { ++live; }
+    Boom(const Boom& other) : text(other.text) {
+        if (budget == 0) throw std::runtime_error("Boom");
+        if (budget > 0) --budget;
+        ++live;
+    }
+    Boom(Boom&& other) noexcept : text(std::move(other.text)) { ++live; }
+    ~Boom() { --live; }
+};
+
+int Boom::budget = -1;
+int Boom::live = 0;
+
+void concurrentAppend() {
+    constexpr int kPerThread = 20000;
+    ConcurrentVector<int> v;
+    v.push_back(-1);
+    const int* first = &v[0];
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < kThreads; ++t) {
+        writers.emplace_back([&v, t] {
+            for (int i = 0; i < kPerThread; ++i) v.push_back(t * kPerThread + i);
+        });
+    }
+    for (auto& t : writers) t.join();
+
+    // Рост не переносит элементы
+    CHECK(&v[0] == first);
+    CHECK(v.size() == kThreads * kPerThread + 1);
+
+    const auto s = v.snapshot();
+    std::vector<int> values(s.begin(), s.end());
+    std::sort(values.begin(), values.end());
+    bool all = true;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        all = all && values[i] == static_cast<int>(i) - 1;
+    }
+    CHECK(all);
+}
+
+void mixedGrowBy() {
+    ConcurrentVector<std::string> v;
+    std::thread single([&v] {
+        for (int i = 0; i < 20000; ++i) v.push_back("x");
+    });
+    for (int i = 0; i < 20000; ++i) v.grow_by(2, "y");
+    single.join();
+    CHECK(v.size() == 60000);
+    const auto s = v.snapshot();
+    CHECK(std::count(s.begin(), s.end(), "y") == 40000);
+}
+
+// Один писатель кладёт в элемент его номер; снимок читателя всегда
+// содержит готовый префикс, и он только растёт
+void snapshotReaders() {
+    constexpr std::size_t kCount = 100000;
+    ConcurrentVector<std::size_t> v;
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < kThreads - 1; ++r) {
+        readers.emplace_back([&v, &done] {
+            std::size_t last = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                const auto s = v.snapshot();
+                CHECK(s.size() >= last);
+                last = s.size();
+                std::size_t seen = 0;
+                bool ordered = true;
+                s.for_each_segment([&](const std::size_t* data, std::size_t count) {
+                    for (std::size_t i = 0; i < count; ++i) ordered = ordered && data[i] == seen + i;
+                    seen += count;
+                });
+                CHECK(ordered && seen == s.size());
+            }
+        });
+    }
+    for (std::size_t i = 0; i < kCount; ++i) v.push_back(i);
+    done.store(true, std::memory_order_release);
+    for (auto& t : readers) t.join();
+    CHECK(v.size() == kCount);
+}
+
+// Бросившее копирование не резервирует номер: size() продолжает расти,
+// а уничтожаются только созданные элементы
+void exceptionSafety() {
+    {
+        ConcurrentVector<Boom> v;
+        const Boom b(1);
+        v.push_back(b);
+
+        Boom::budget = 1;
+        CHECK_THROWS(v.grow_by(3, b), std::runtime_error);
+        Boom::budget = -1;
+        v.push_back(b);
+        v.push_back(b);
+        CHECK(v.size() == 3);
+
+        Boom::budget = 0;
+        CHECK_THROWS(v.push_back(b), std::runtime_error);
+        Boom::budget = -1;
+        CHECK(v.size() == 3);
+        v.grow_by(200, b);
+        CHECK(v.size() == 203);
+        CHECK(v.at(202).text == "1");
+        CHECK_THROWS(v.at(203), std::out_of_range);
+    }
+    CHECK(Boom::live == 0);
+}
+
+void registerAll() {
+    test::registerTest("ConcurrentVector/concurrent_append", concurrentAppend);
+    test::registerTest("ConcurrentVector/mixed_grow_by", mixedGrowBy);
+    test::registerTest("ConcurrentVector/snapshot_readers", snapshotReaders);
+    test::registerTest("ConcurrentVector/exception_safety", exceptionSafety);
+}
+
+TEST_REGISTRATION(registerAll);
+
+} // namespace
@@ -0,0 +1,157 @@
+// ContainerAdaptor: SimpleVector и оба списка за BaseContainer<T>& —
+// виртуальные push_back/insert (копией и перемещением), erase, operator[],
+// size/empty/clear и print против std::vector, конструкторы адаптера и
+// доступ к обёрнутому контейнеру
+
+#include "testing.h"
+
+#include "baseContainer.h"
+#include "doublyLinkedList.h"
+#include "simpleVector.h"
+#include "singlyLinkedList.h"
+
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Содержимое через виртуальный константный operator[]
+template<typename T>
+std::vector<T> items(const BaseContainer<T>& c) {
+    std::vector<T> out;
+    for (std::size_t i = 0; i < c.size(); ++i) out.push_back(c[i]);
+    return out;
+}
+
+template<typename T>
+std::string printed(const BaseContainer<T>& c) {
+    std::ostringstream os;
+    c.print(os);
+    return os.str();
+}
+
+// Случайные операции через ссылку на интерфейс; тип за ней тесту неизвестен
+void randomOperations(BaseContainer<int>& c) {
+    std::mt19937 rng(11);
+    std::vector<int> model;
+    for (int step = 0; step < 2000; ++step) {
+        const int x = static_cast<int>(rng() % 1000);
+        switch (rng() % 5) {
+        case 0:
+            c.push_back(x);
+            model.push_back(x);
+            break;
+        case 1: {
+            const std::size_t pos = rng() % (model.size() + 1);
+            c.insert(pos, x);
+            model.insert(model.begin() + static_cast<std::ptrdiff_t>(pos), x);
+            break;
+        }
+        case 2:
+            if (model.empty()) break;
+            {
+                const std::size_t pos = rng() % model.size();
+                c[pos] = x;
+                model[pos] = x;
+            }
+            break;
+        default:
+            if (model.empty()) break;
+            {
+                const std::size_t pos = rng() % model.size();
+                c.erase(pos);
+                model.erase(model.begin() + static_cast<std::ptrdiff_t>(pos));
+            }
+            break;
+        }
+    }
+    CHECK(c.size() == model.size() && c.empty() == model.empty());
+    CHECK(items(c) == model);
+
+    CHECK_THROWS(c.erase(model.size()), std::out_of_range);
+    CHECK_THROWS(c.insert(model.size() + 1, 0), std::out_of_range);
+    CHECK(items(c) == model);
+
+    c.clear();
+    CHECK(c.empty() && c.size() == 0 && printed(c).empty());
+    CHECK_THROWS(c.erase(0), std::out_of_range);
+}
+
+// Перегрузки с rvalue забирают строку, с lvalue — копируют
+void stringOverloads(BaseContainer<std::string>& c) {
+    std::string kept = "kept";
+    c.push_back(kept);
+    std::string moved = "a long string that does not fit the small buffer";
+    c.push_back(std::move(moved));
+    CHECK(kept == "kept" && moved.empty());
+
+    std::string front = "front";
+    c.insert(0, front);
+    std::string middle = "another long string that does not fit the buffer";
+    c.insert(1, std::move(middle));
+    CHECK(front == "front" && middle.empty());
+
+    c[0] += "!";
+    const BaseContainer<std::string>& shared = c;
+    CHECK(items(shared) == (std::vector<std::string>{
+        "front!", "another long string that does not fit the buffer", "kept",
+        "a long string that does not fit the small buffer"}));
+
+    c.erase(1);
+    c.erase(2);
+    CHECK(printed(c) == "front! kept" && c.size() == 2);
+}
+
+template<template<typename...> class Container>
+void viaBase() {
+    std::unique_ptr<BaseContainer<int>> ints = std::make_unique<ContainerAdaptor<Container<int>>>();
+    CHECK(ints->empty() && printed(*ints).empty());
+    randomOperations(*ints);
+
+    ContainerAdaptor<Container<std::string>> strings;
+    stringOverloads(strings);
+    CHECK(strings.container().size() == 2 && strings.container()[1] == "kept");
+}
+
+template<template<typename...> class Template>
+void construction() {
+    using Container = Template<int>;
+    ContainerAdaptor<Container> listed{1, 2, 3};
+    const BaseContainer<int>& base = listed;
+    CHECK(items(base) == (std::vector<int>{1, 2, 3}) && printed(base) == "1 2 3");
+
+    // Копия контейнера не связана с исходным, перемещённый уходит в адаптер
+    Container source{4, 5};
+    ContainerAdaptor<Container> copied(source);
+    copied.push_back(6);
+    CHECK(source.size() == 2 && copied.size() == 3);
+
+    ContainerAdaptor<Container> moved(std::move(source));
+    CHECK(moved.size() == 2 && moved[1] == 5);
+
+    // Правки через container() видны через интерфейс и наоборот
+    listed.container().push_back(4);
+    BaseContainer<int>& mutableBase = listed;
+    mutableBase[0] = 10;
+    CHECK(listed.container()[0] == 10 && items(base) == (std::vector<int>{10, 2, 3, 4}));
+}
+
+void registerFor(const std::string& name, void (*via)(), void (*built)()) {
+    test::registerTest("ContainerAdaptor/" + name + "/via_base", via);
+    test::registerTest("ContainerAdaptor/" + name + "/construction", built);
+}
+
+void registerAll() {
+    registerFor("SimpleVector", viaBase<SimpleVector>, construction<SimpleVector>);
+    registerFor("SinglyLinkedList", viaBase<SinglyLinkedList>, construction<SinglyLinkedList>);
+    registerFor("DoublyLinkedList", viaBase<DoublyLinkedList>, construction<DoublyLinkedList>);
+}
+
+TEST_REGISTRATION(registerAll);
+
+} // namespace
@@ -0,0 +1,183 @@
+// Счётчики горячих путей (containerStats.h). Со сборкой LAB3_STATS проверяются
+// значения счётчиков, без неё — что stats() остаются нулевыми, а основа
+// контейнеров пуста. Формат отчётов и memory_usage() списков от LAB3_STATS
+// не зависят
+
+#include "testing.h"
+
+#include "containerStats.h"
+#include "doublyLinkedList.h"
+#include "simpleVector.h"
+#include "singlyLinkedList.h"
+#include "unrolledList.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+namespace {
+
+bool isZero(const ContainerStats& s) {
+    return s.reallocations == 0 && s.bytes_moved == 0 && s.elements_shifted == 0 &&
+           s.node_allocations == 0 && s.walks == 0 && s.walk_steps == 0 && s.peak_capacity == 0;
+}
+
+void vectorCounters() {
+    SimpleVector<std::string> v;
+    v.reserve(100);
+    for (int i = 0; i < 100; ++i) v.push_back("x");
+    v.reserve(200);
+    v.insert(0, "y");
+    v.erase(0);
+
+    if constexpr (stats_enabled) {
+        CHECK(v.stats().reallocations == 2);
+        CHECK(v.stats().bytes_moved == 100 * sizeof(std::string));
+        CHECK(v.stats().elements_shifted == 200);
+        CHECK(v.stats().peak_capacity >= 200);
+
+        // Копия считает с нуля
+        const SimpleVector<std::string> copy(v);
+        CHECK(copy.stats().reallocations == 0);
+        CHECK(copy.stats().peak_capacity == 100);
+
+        v.reset_stats();
+        CHECK(isZero(v.stats()));
+    } else {
+        CHECK(isZero(v.stats()));
+    }
+}
+
+void listCounters() {
+    SinglyLinkedList<int> singly;
+    DoublyLinkedList<int> doubly;
+    for (int i = 0; i < 100; ++i) {
+        singly.push_back(i);
+        doubly.push_back(i);
+    }
+    singly.reset_stats();
+    long sum = 0;
+    for (int i = 0; i < 100; ++i) sum += singly[i];
+    CHECK(sum == 4950);
+
+    if constexpr (stats_enabled) {
+        CHECK(doubly.stats().node_allocations == 100);
+        CHECK(singly.stats().node_allocations == 0);
+        CHECK(singly.stats().walks == 100);
+        // Последовательный проход идёт от пальца: не больше шага на обращение
+        CHECK(singly.stats().average_walk() <= 1.0);
+    } else {
+        CHECK(isZero(singly.stats()) && isZero(doubly.stats()));
+    }
+}
+
+// Сводка потока начинается с нуля и видит события всех его контейнеров
+void threadSummary() {
+    ContainerStats summary;
+    ContainerStats own;
+    std::thread worker([&] {
+        SimpleVector<int> v;
+        DoublyLinkedList<int> l;
+        for (int i = 0; i < 1000; ++i) {
+            v.push_back(i);
+            l.push_back(i);
+        }
+        own = v.stats();
+        own += l.stats();
+        summary = thread_stats();
+    });
+    worker.join();
+
+    if constexpr (stats_enabled) {
+        CHECK(summary.reallocations == own.reallocations && summary.reallocations > 0);
+        CHECK(summary.node_allocations == 1000);
+        CHECK(summary.peak_capacity == own.peak_capacity);
+    } else {
+        CHECK(isZero(summary));
+        CHECK(std::is_empty_v<StatsCounter<>>);
+    }
+}
+
+void reports() {
+    ContainerStats s;
+    s.reallocations = 3;
+    s.walks = 4;
+    s.walk_steps = 10;
+    s.peak_capacity = 64;
+
+    std::ostringstream text;
+    s.print_text(text);
+    CHECK(text.str().find("reallocations: 3\n") != std::string::npos);
+    CHECK(text.str().find("average_walk: 2.5\n") != std::string::npos);
+
+    std::ostringstream json;
+    s.print_json(json);
+    CHECK(json.str() ==
+          "{\"reallocations\":3,\"bytes_moved\":0,\"elements_shifted\":0,\"node_allocations\":0,"
+          "\"walks\":4,\"walk_steps\":10,\"average_walk\":2.5,\"peak_capacity\":64}");
+
+    ContainerStats total = s;
+    ContainerStats other;
+    other.reallocations = 1;
+    other.peak_capacity = 16;
+    total += other;
+    CHECK(total.reallocations == 4 && total.peak_capacity == 64);
+}
+
+// Узел — значение и ссылки на соседей; позиционный индекс добавляет своё
+template<typename List>
+void listMemory(std::size_t links) {
+    List list;
+    CHECK(list.memory_usage().used == 0 && list.memory_usage().reserved == 0);
+    for (int i = 0; i < 100; ++i) list.push_back(i);
+    const MemoryUsage plain = list.memory_usage();
+    CHECK(plain.used == 100 * sizeof(int));
+    CHECK(plain.reserved % 100 == 0 && plain.reserved >= 100 * (sizeof(int) + links * sizeof(void*)));
+
+    list.enable_index();
+    CHECK(list.memory_usage().used == plain.used && list.memory_usage().reserved > plain.reserved);
+    list.disable_index();
+    CHECK(list.memory_usage().reserved == plain.reserved);
+
+    list.erase(0);
+    CHECK(list.memory_usage().used == 99 * sizeof(int) && list.memory_usage().reserved == plain.reserved / 100 * 99);
+    list.clear();
+    CHECK(list.memory_usage().used == 0 && list.memory_usage().reserved == 0);
+}
+
+void singlyMemory() {
+    listMemory<SinglyLinkedList<int>>(1);
+}
+
+void doublyMemory() {
+    listMemory<DoublyLinkedList<int>>(2);
+}
+
+// Блоки считаются целиком, вместе со свободными ячейками
+void unrolledMemory() {
+    UnrolledList<int, 16> list;
+    list.push_back(0);
+    const std::size_t block = list.memory_usage().reserved;
+    CHECK(block >= 16 * sizeof(int));
+    for (int i = 1; i < 40; ++i) list.push_back(i);
+    CHECK(list.memory_usage().used == 40 * sizeof(int) && list.memory_usage().reserved == 3 * block);
+
+    MemoryUsage total = list.memory_usage();
+    total += SinglyLinkedList<int>{1, 2}.memory_usage();
+    CHECK(total.used == 42 * sizeof(int) && total.reserved > 3 * block);
+}
+
+void registerAll() {
+    test::registerTest("ContainerStats/vector_counters", vectorCounters);
+    test::registerTest("ContainerStats/list_counters", listCounters);
+    test::registerTest("ContainerStats/thread_summary", threadSummary);
+    test::registerTest("ContainerStats/reports", reports);
+    test::registerTest("ContainerStats/singly_memory", singlyMemory);
+    test::registerTest("ContainerStats/doubly_memory", doublyMemory);
+    test::registerTest("ContainerStats/unrolled_memory", unrolledMemory);
+}
+
+TEST_REGISTRATION(registerAll);
+
+} // namespace
@@ -0,0 +1,126 @@
+// Курсоры списков: случайные шаги, вставка и удаление против std::vector
+// с позиционным индексом и без, вставка на позиции end(), шаг назад от
+// end() и удаление элемента под курсором, в том числе последнего
+
+#include "testing.h"
+
+#include "doublyLinkedList.h"
+#include "nodePool.h"
+#include "singlyLinkedList.h"
+
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+template<typename List>
+std::vector<int> items(const List& list) {
+    return std::vector<int>(list.begin(), list.end());
+}
+
+// Случайный проход курсором против std::vector; двусвязный список ходит и назад.
+// С индексом заодно проверяется, что правки курсором его не портят
+template<typename List, bool Backward>
+void cursorWalk() {
+    for (bool indexed : {false, true}) {
+        std::mt19937 rng(indexed ? 3 : 4);
+        List list{0, 1, 2, 3, 4};
+        if (indexed) list.enable_index();
+        std::vector<int> model{0, 1, 2, 3, 4};
+        std::size_t at = 2;
+        auto cursor = list.cursor(at);
+        bool consistent = true;
+        for (int step = 0; step < 4000; ++step) {
+            const unsigned op = rng() % 8;
+            if (op < 2 && at < model.size()) {
+                ++cursor;
+                ++at;
+            } else if (op < 4 && Backward && at > 0) {
+                if constexpr (Backward) --cursor;
+                --at;
+            } else if (op < 6) {
+                const int x = static_cast<int>(rng() % 1000);
+                cursor.insert(x);
+                model.insert(model.begin() + static_cast<std::ptrdiff_t>(at), x);
+                ++at;
+            } else if (at < model.size()) {
+                cursor.erase();
+                model.erase(model.begin() + static_cast<std::ptrdiff_t>(at));
+            } else if (!Backward) {
+                // В начало, чтобы односвязный курсор не застревал в конце
+                cursor = list.cursor();
+                at = 0;
+            }
+            consistent = consistent && cursor.index() == at && cursor.valid() == (at < model.size()) &&
+                         (!cursor.valid() || *cursor == model[at]);
+        }
+        CHECK(consistent);
+        CHECK(items(list) == model && list.size() == model.size());
+        bool indexedAccess = true;
+        for (std::size_t i = 0; i < model.size(); ++i) indexedAccess = indexedAccess && list[i] == model[i];
+        CHECK(indexedAccess);
+    }
+}
+
+template<typename List, bool Backward>
+void cursorEdges() {
+    List list;
+    auto cursor = list.cursor();
+    CHECK(!cursor.valid() && cursor.index() == 0);
+
+    // На end() вставка добавляет в конец, курсор остаётся за последним
+    cursor.insert(1);
+    cursor.insert(2);
+    CHECK(!cursor.valid() && cursor.index() == 2 && items(list) == (std::vector<int>{1, 2}));
+    if constexpr (Backward) {
+        --cursor;
+        CHECK(cursor.valid() && *cursor == 2 && cursor.index() == 1);
+        ++cursor;
+    }
+    CHECK_THROWS(list.cursor(3), std::out_of_range);
+
+    // Удаление элемента под курсором переводит его на следующий, последнего — на end()
+    cursor = list.cursor(0);
+    cursor.insert(0);
+    CHECK(*cursor == 1 && cursor.index() == 1);
+    cursor.erase();
+    CHECK(cursor.valid() && *cursor == 2 && cursor.index() == 1);
+    cursor.erase();
+    CHECK(!cursor.valid() && cursor.index() == 1 && items(list) == (std::vector<int>{0}));
+    if constexpr (Backward) {
+        --cursor;
+        cursor.erase();
+        CHECK(!cursor.valid() && cursor.index() == 0 && list.empty());
+    } else {
+        cursor = list.cursor();
+        cursor.erase();
+        CHECK(!cursor.valid() && list.empty());
+    }
+
+    // После удаления курсор пригоден для вставки и записи
+    cursor.insert(7);
+    list.push_back(9);
+    cursor = list.cursor(1);
+    *cursor = 8;
+    CHECK(items(list) == (std::vector<int>{7, 8}) && list[1] == 8);
+}
+
+template<typename Allocator>
+void registerFor(const std::string& name) {
+    test::registerTest("DoublyLinkedList" + name + "/cursor_walk", cursorWalk<DoublyLinkedList<int, Allocator>, true>);
+    test::registerTest("DoublyLinkedList" + name + "/cursor_edges", cursorEdges<DoublyLinkedList<int, Allocator>, true>);
+    test::registerTest("SinglyLinkedList" + name + "/cursor_walk", cursorWalk<SinglyLinkedList<int, Allocator>, false>);
+    test::registerTest("SinglyLinkedList" + name + "/cursor_edges", cursorEdges<SinglyLinkedList<int, Allocator>, false>);
+}
+
+void registerAll() {
+    registerFor<std::allocator<int>>("");
+    registerFor<PoolAllocator<int>>("/pooled");
+}
+
+TEST_REGISTRATION(registerAll);
+
+} // namespace
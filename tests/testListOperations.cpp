@@ -0,0 +1,395 @@
+// Правки списков по итераторам: insert/erase, splice, merge и split против
+// std::list / std::forward_list, в том числе перенос внутри одного списка,
+// пустые диапазоны и списки с разными пулами узлов (перенос перемещением).
+// Шаг назад от end() двусвязного списка, before_begin() односвязного
+
+#include "testing.h"
+
+#include "doublyLinkedList.h"
+#include "nodePool.h"
+#include "singlyLinkedList.h"
+
+#include <forward_list>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Pooled = PoolAllocator<int>;
+
+// Элементы прямым проходом, не больше size() + 1: зациклившийся или
+// потерявший узлы список даёт лишний либо недостающий элемент, а не зависание
+template<typename List>
+std::vector<int> walk(const List& list) {
+    std::vector<int> forward;
+    for (auto it = list.begin(); it != list.end() && forward.size() <= list.size(); ++it) {
+        forward.push_back(*it);
+    }
+    return forward;
+}
+
+template<typename Allocator>
+std::vector<int> items(const SinglyLinkedList<int, Allocator>& list) {
+    return walk(list);
+}
+
+// Для двусвязного списка заодно сверяет обратные ссылки
+template<typename Allocator>
+std::vector<int> items(const DoublyLinkedList<int, Allocator>& list) {
+    std::vector<int> forward = walk(list);
+    if (forward.size() != list.size()) return forward;
+    std::vector<int> backward;
+    if (!list.empty()) {
+        auto it = std::next(list.begin(), static_cast<std::ptrdiff_t>(list.size() - 1));
+        for (;; --it) {
+            backward.insert(backward.begin(), *it);
+            if (it == list.begin()) break;
+        }
+    }
+    if (backward != forward) forward.push_back(-1);
+    return forward;
+}
+
+template<typename T>
+std::vector<int> items(const std::forward_list<T>& list) {
+    return std::vector<int>(list.begin(), list.end());
+}
+
+template<typename T>
+std::vector<int> items(const std::list<T>& list) {
+    return std::vector<int>(list.begin(), list.end());
+}
+
+template<typename It>
+It advanced(It it, std::size_t n) {
+    std::advance(it, static_cast<std::ptrdiff_t>(n));
+    return it;
+}
+
+template<typename Allocator>
+void doublySelfSplice() {
+    DoublyLinkedList<int, Allocator> d{1, 2, 3, 4};
+    std::list<int> model{1, 2, 3, 4};
+
+    // Элемент уже на месте: перед самим собой и перед следующим
+    auto it = std::next(d.begin());
+    d.splice(it, d, it);
+    d.splice(std::next(it), d, it);
+    CHECK(items(d) == items(model));
+
+    for (std::size_t step = 0; step < 200; ++step) {
+        const std::size_t from = step * 7 % 4;
+        const std::size_t to = step * 5 % 5;
+        d.splice(advanced(d.cbegin(), to), d, advanced(d.cbegin(), from));
+        model.splice(advanced(model.cbegin(), to), model, advanced(model.cbegin(), from));
+    }
+    CHECK(items(d) == items(model));
+
+    // Диапазон внутри того же списка
+    d.splice(d.end(), d, d.begin(), std::next(d.begin(), 2));
+    model.splice(model.end(), model, model.begin(), std::next(model.begin(), 2));
+    CHECK(items(d) == items(model));
+}
+
+template<typename Allocator>
+void doublySpliceOther() {
+    DoublyLinkedList<int, Allocator> a{1, 2, 3};
+    DoublyLinkedList<int, Allocator> b{10, 20, 30};
+    DoublyLinkedList<int, Allocator> empty;
+
+    // Пустые диапазоны ничего не меняют
+    a.splice(a.begin(), b, b.begin(), b.begin());
+    a.splice(a.end(), b, b.end(), b.end());
+    a.splice(std::next(a.begin()), empty);
+    CHECK(items(a) == (std::vector<int>{1, 2, 3}) && items(b) == (std::vector<int>{10, 20, 30}));
+
+    a.splice(std::next(a.begin()), b, std::next(b.begin()));
+    CHECK(items(a) == (std::vector<int>{1, 20, 2, 3}) && items(b) == (std::vector<int>{10, 30}));
+
+    a.splice(a.end(), b);
+    CHECK(items(a) == (std::vector<int>{1, 20, 2, 3, 10, 30}) && b.empty());
+
+    b.splice(b.begin(), a, std::next(a.begin()), std::next(a.begin(), 5));
+    CHECK(items(a) == (std::vector<int>{1, 30}) && items(b) == (std::vector<int>{20, 2, 3, 10}));
+
+    // Последний элемент другого списка в конец: end() обоих списков совпадают
+    DoublyLinkedList<int, Allocator> last{9};
+    a.splice(a.end(), last, last.begin());
+    CHECK(items(a) == (std::vector<int>{1, 30, 9}) && last.empty() && a.size() == 3);
+    a.splice(a.end(), b, std::next(b.begin(), 3));
+    CHECK(items(a) == (std::vector<int>{1, 30, 9, 10}) && items(b) == (std::vector<int>{20, 2, 3}));
+}
+
+template<typename Allocator>
+void doublyMergeSplit() {
+    DoublyLinkedList<int, Allocator> a{1, 3, 5, 7};
+    a.merge(a);
+    CHECK(items(a) == (std::vector<int>{1, 3, 5, 7}));
+
+    DoublyLinkedList<int, Allocator> b{0, 3, 4, 9, 10};
+    a.merge(b);
+    CHECK(items(a) == (std::vector<int>{0, 1, 3, 3, 4, 5, 7, 9, 10}) && b.empty());
+
+    DoublyLinkedList<int, Allocator> none;
+    a.merge(none);
+    none.merge(a);
+    CHECK(a.empty() && items(none) == (std::vector<int>{0, 1, 3, 3, 4, 5, 7, 9, 10}));
+
+    auto tail = none.split(none.end());
+    CHECK(tail.empty() && none.size() == 9);
+    auto middle = none.split(std::next(none.begin(), 4));
+    CHECK(items(none) == (std::vector<int>{0, 1, 3, 3}) && items(middle) == (std::vector<int>{4, 5, 7, 9, 10}));
+    auto all = none.split(none.begin());
+    CHECK(none.empty() && items(all) == (std::vector<int>{0, 1, 3, 3}));
+
+    // После split оба списка продолжают работать
+    none.push_back(42);
+    all.push_back(8);
+    CHECK(items(none) == (std::vector<int>{42}) && items(all) == (std::vector<int>{0, 1, 3, 3, 8}));
+}
+
+template<typename Allocator>
+void doublyInsertErase() {
+    std::mt19937 rng(7);
+    DoublyLinkedList<int, Allocator> d;
+    std::list<int> model;
+    for (int step = 0; step < 3000; ++step) {
+        const std::size_t pos = rng() % (model.size() + 1);
+        if (model.empty() || rng() % 3 != 0) {
+            const int x = static_cast<int>(rng() % 1000);
+            CHECK(*d.insert(advanced(d.cbegin(), pos), x) == x);
+            model.insert(advanced(model.cbegin(), pos), x);
+        } else if (rng() % 2 == 0) {
+            const std::size_t at = pos % model.size();
+            d.erase(advanced(d.cbegin(), at));
+            model.erase(advanced(model.cbegin(), at));
+        } else {
+            const std::size_t first = pos % model.size();
+            const std::size_t last = first + rng() % (model.size() - first + 1);
+            auto it = d.erase(advanced(d.cbegin(), first), advanced(d.cbegin(), last));
+            auto expect = model.erase(advanced(model.cbegin(), first), advanced(model.cbegin(), last));
+            CHECK((it == d.end()) == (expect == model.end()));
+        }
+    }
+    CHECK(items(d) == items(model));
+}
+
+// Шаг назад от end() ведёт на хвост: std::prev(end()), обратные итераторы
+// и удаление с конца
+template<typename Allocator>
+void doublyBackFromEnd() {
+    DoublyLinkedList<int, Allocator> d{1, 2, 3, 4, 5};
+    std::list<int> model{1, 2, 3, 4, 5};
+    CHECK(*std::prev(d.end()) == 5 && *std::prev(d.cend()) == 5);
+    CHECK(std::prev(d.end(), 5) == d.begin());
+
+    const auto& shared = d;
+    CHECK(std::vector<int>(d.rbegin(), d.rend()) == std::vector<int>(model.rbegin(), model.rend()));
+    CHECK(std::vector<int>(shared.crbegin(), shared.crend()) == std::vector<int>(model.rbegin(), model.rend()));
+
+    auto it = d.end();
+    auto before = it--;
+    CHECK(before == d.end() && *it == 5);
+    typename DoublyLinkedList<int, Allocator>::const_iterator converted = d.end();
+    CHECK(*--converted == 5);
+
+    // Хвост меняется — end() шагает на новый
+    while (!model.empty()) {
+        CHECK(d.erase(std::prev(d.end())) == d.end());
+        model.pop_back();
+        CHECK(items(d) == items(model));
+        if (!model.empty()) CHECK(*std::prev(d.end()) == model.back());
+    }
+    d.push_back(7);
+    CHECK(*std::prev(d.end()) == 7 && *d.rbegin() == 7);
+}
+
+template<typename Allocator>
+void singlySelfSplice() {
+    SinglyLinkedList<int, Allocator> s{1, 2, 3, 4};
+    std::forward_list<int> model{1, 2, 3, 4};
+
+    // Узел после it уже стоит после pos либо сам является pos
+    auto it = s.cbegin();
+    s.splice_after(it, s, it);
+    s.splice_after(std::next(it), s, it);
+    s.splice_after(s.cbefore_begin(), s, s.cbefore_begin());
+    CHECK(items(s) == items(model) && s.size() == 4);
+
+    for (std::size_t step = 0; step < 200; ++step) {
+        // from — номер переносимого узла, to — число узлов перед местом вставки
+        const std::size_t from = step * 7 % 4;
+        const std::size_t to = step * 5 % 5;
+        auto from_it = from == 0 ? s.cbefore_begin() : advanced(s.cbegin(), from - 1);
+        auto to_it = to == 0 ? s.cbefore_begin() : advanced(s.cbegin(), to - 1);
+        auto model_from = advanced(model.cbefore_begin(), from);
+        auto model_to = advanced(model.cbefore_begin(), to);
+        s.splice_after(to_it, s, from_it);
+        model.splice_after(model_to, model, model_from);
+    }
+    CHECK(items(s) == items(model) && s.size() == 4);
+}
+
+template<typename Allocator>
+void singlySpliceOther() {
+    SinglyLinkedList<int, Allocator> a{1, 2, 3};
+    SinglyLinkedList<int, Allocator> b{10, 20, 30};
+    SinglyLinkedList<int, Allocator> empty;
+
+    // Пустые интервалы (first, first + 1) и пустой список
+    a.splice_after(a.cbegin(), b, b.cbegin(), std::next(b.cbegin()));
+    a.splice_after(a.cbefore_begin(), empty);
+    a.splice_after(a.cbegin(), b, std::next(b.cbegin(), 2));
+    CHECK(items(a) == (std::vector<int>{1, 2, 3}) && items(b) == (std::vector<int>{10, 20, 30}));
+
+    // before_begin() каждого списка стоит перед его собственной головой
+    a.splice_after(a.cbefore_begin(), b, b.cbefore_begin());
+    CHECK(items(a) == (std::vector<int>{10, 1, 2, 3}) && items(b) == (std::vector<int>{20, 30}));
+
+    a.splice_after(std::next(a.cbegin(), 3), b);
+    CHECK(items(a) == (std::vector<int>{10, 1, 2, 3, 20, 30}) && b.empty() && a.size() == 6);
+    a.push_back(40);
+    CHECK(items(a) == (std::vector<int>{10, 1, 2, 3, 20, 30, 40}));
+
+    b.splice_after(b.cbefore_begin(), a, a.cbegin(), std::next(a.cbegin(), 3));
+    CHECK(items(a) == (std::vector<int>{10, 3, 20, 30, 40}) && items(b) == (std::vector<int>{1, 2}));
+}
+
+template<typename Allocator>
+void singlyMergeSplit() {
+    SinglyLinkedList<int, Allocator> a{2, 4, 6};
+    a.merge(a);
+    CHECK(items(a) == (std::vector<int>{2, 4, 6}));
+
+    SinglyLinkedList<int, Allocator> b{1, 4, 7, 8};
+    a.merge(b);
+    CHECK(items(a) == (std::vector<int>{1, 2, 4, 4, 6, 7, 8}) && b.empty() && a.size() == 7);
+    a.push_back(9);
+    CHECK(items(a) == (std::vector<int>{1, 2, 4, 4, 6, 7, 8, 9}));
+
+    auto tail = a.split_after(std::next(a.cbegin(), 7));
+    CHECK(tail.empty() && a.size() == 8);
+    auto back = a.split_after(std::next(a.cbegin(), 2));
+    CHECK(items(a) == (std::vector<int>{1, 2, 4}) && items(back) == (std::vector<int>{4, 6, 7, 8, 9}));
+    auto all = a.split_after(a.cbefore_begin());
+    CHECK(a.empty() && items(all) == (std::vector<int>{1, 2, 4}));
+
+    a.push_back(5);
+    all.push_back(3);
+    CHECK(items(a) == (std::vector<int>{5}) && items(all) == (std::vector<int>{1, 2, 4, 3}));
+}
+
+// before_begin() отличается от end(): шаг вперёд ведёт на begin(), а
+// позиция end() в операциях *_after отвергается, а не уходит в голову
+template<typename Allocator>
+void singlyBeforeBegin() {
+    SinglyLinkedList<int, Allocator> s{1, 2, 3, 4};
+    std::forward_list<int> model{1, 2, 3, 4};
+    CHECK(s.before_begin() != s.end() && s.cbefore_begin() != s.cend());
+    CHECK(std::next(s.before_begin()) == s.begin() && std::next(s.cbefore_begin(), 5) == s.cend());
+    auto post = s.before_begin();
+    CHECK(post++ == s.before_begin() && post == s.begin());
+
+    // Обход парой (prev, it): удаление чётных через erase_after
+    auto prev = s.cbefore_begin();
+    for (auto it = s.cbegin(); it != s.cend(); ++prev, ++it) {
+        if (*it % 2 == 0) it = s.erase_after(prev);
+        if (it == s.cend()) break;
+    }
+    model.remove_if([](int x) { return x % 2 == 0; });
+    CHECK(items(s) == items(model) && s.size() == 2);
+
+    SinglyLinkedList<int, Allocator> empty;
+    CHECK(std::next(empty.before_begin()) == empty.end());
+    auto inserted = empty.insert_after(empty.cbefore_begin(), 7);
+    CHECK(inserted == empty.begin() && items(empty) == (std::vector<int>{7}));
+
+    // end() и before_begin() чужого списка не позиции этого списка
+    CHECK_THROWS(s.insert_after(s.cend(), 9), std::out_of_range);
+    CHECK_THROWS(s.emplace_after(empty.cbefore_begin(), 9), std::out_of_range);
+    CHECK_THROWS(s.erase_after(s.cend()), std::out_of_range);
+    CHECK_THROWS(s.erase_after(s.cend(), s.cend()), std::out_of_range);
+    CHECK_THROWS(s.split_after(s.cend()), std::out_of_range);
+    CHECK_THROWS(s.splice_after(s.cend(), empty), std::out_of_range);
+    CHECK_THROWS(s.splice_after(s.cbefore_begin(), empty, empty.cend()), std::out_of_range);
+    CHECK(items(s) == (std::vector<int>{1, 3}) && items(empty) == (std::vector<int>{7}));
+
+    const auto& shared = s;
+    CHECK(*std::next(shared.before_begin()) == 1);
+}
+
+template<typename Allocator>
+void singlyInsertErase() {
+    std::mt19937 rng(11);
+    SinglyLinkedList<int, Allocator> s;
+    std::forward_list<int> model;
+    std::size_t size = 0;
+    for (int step = 0; step < 3000; ++step) {
+        const std::size_t pos = rng() % (size + 1);
+        auto it = advanced(s.cbefore_begin(), 0);
+        if (pos > 0) it = advanced(s.cbegin(), pos - 1);
+        auto model_it = advanced(model.cbefore_begin(), pos);
+        if (size == pos || rng() % 3 != 0) {
+            const int x = static_cast<int>(rng() % 1000);
+            CHECK(*s.insert_after(it, x) == x);
+            model.insert_after(model_it, x);
+            ++size;
+        } else if (rng() % 2 == 0) {
+            s.erase_after(it);
+            model.erase_after(model_it);
+            --size;
+        } else {
+            const std::size_t count = rng() % (size - pos + 1);
+            auto last = advanced(s.cbegin(), pos + count);
+            s.erase_after(it, last);
+            model.erase_after(model_it, advanced(model_it, count + 1));
+            size -= count;
+        }
+    }
+    CHECK(items(s) == items(model) && s.size() == size);
+}
+
+// Списки с разными пулами: узлы переносятся перемещением элементов
+void acrossPools() {
+    DoublyLinkedList<int, Pooled> a{1, 3, 5};
+    DoublyLinkedList<int, Pooled> b{2, 4};
+    a.splice(std::next(a.begin()), b, b.begin());
+    CHECK(items(a) == (std::vector<int>{1, 2, 3, 5}) && items(b) == (std::vector<int>{4}));
+    a.merge(b);
+    CHECK(items(a) == (std::vector<int>{1, 2, 3, 4, 5}) && b.empty());
+
+    SinglyLinkedList<int, Pooled> s{1, 3};
+    SinglyLinkedList<int, Pooled> t{0, 2, 4};
+    s.splice_after(s.cbefore_begin(), t, t.cbefore_begin());
+    CHECK(items(s) == (std::vector<int>{0, 1, 3}) && items(t) == (std::vector<int>{2, 4}));
+    s.merge(t);
+    CHECK(items(s) == (std::vector<int>{0, 1, 2, 3, 4}) && t.empty() && s.size() == 5);
+}
+
+template<typename Allocator>
+void registerFor(const std::string& name) {
+    test::registerTest("DoublyLinkedList" + name + "/self_splice", doublySelfSplice<Allocator>);
+    test::registerTest("DoublyLinkedList" + name + "/splice_other", doublySpliceOther<Allocator>);
+    test::registerTest("DoublyLinkedList" + name + "/merge_split", doublyMergeSplit<Allocator>);
+    test::registerTest("DoublyLinkedList" + name + "/insert_erase", doublyInsertErase<Allocator>);
+    test::registerTest("DoublyLinkedList" + name + "/back_from_end", doublyBackFromEnd<Allocator>);
+    test::registerTest("SinglyLinkedList" + name + "/self_splice", singlySelfSplice<Allocator>);
+    test::registerTest("SinglyLinkedList" + name + "/splice_other", singlySpliceOther<Allocator>);
+    test::registerTest("SinglyLinkedList" + name + "/merge_split", singlyMergeSplit<Allocator>);
+    test::registerTest("SinglyLinkedList" + name + "/insert_erase", singlyInsertErase<Allocator>);
+    test::registerTest("SinglyLinkedList" + name + "/before_begin", singlyBeforeBegin<Allocator>);
+}
+
+void registerAll() {
+    registerFor<std::allocator<int>>("");
+    registerFor<Pooled>("/pooled");
+    test::registerTest("LinkedList/across_pools", acrossPools);
+}
+
+TEST_REGISTRATION(registerAll);
+
+} // namespace
@@ -0,0 +1,104 @@
+#include "testing.h"
+
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace test {
+
+namespace {
+
+struct Test {
+    std::string name;
+    Function fn;
+};
+
+std::vector<Test>& registry() {
+    static std::vector<Test> tests;
+    return tests;
+}
+
+// Проверки могут проваливаться в потоках, запущенных тестом
+std::atomic<int> failures{0};
+std::mutex report_mutex;
+
+void printUsage(const char* prog) {
+    std::cout
+        << "Usage: " << prog << " [options]\n"
+        << "  --filter=STR     запускать только случаи, имя которых содержит STR\n"
+        << "                   (можно указать несколько раз)\n"
+        << "  --list           вывести список зарегистрированных случаев\n";
+}
+
+bool matches(const std::vector<std::string>& filters, const std::string& name) {
+    if (filters.empty()) return true;
+    for (const auto& f : filters) {
+        if (name.find(f) != std::string::npos) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+bool registerTest(std::string name, Function fn) {
+    registry().push_back(Test{std::move(name), std::move(fn)});
+    return true;
+}
+
+void fail(const char* file, int line, const char* expression) {
+    failures.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(report_mutex);
+    std::cerr << file << ":" << line << ": CHECK(" << expression << ") failed\n";
+}
+
+int runMain(int argc, char** argv) {
+    std::vector<std::string> filters;
+    bool list_only = false;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strncmp(arg, "--filter=", 9) == 0) {
+            filters.emplace_back(arg + 9);
+        } else if (std::strcmp(arg, "--list") == 0) {
+            list_only = true;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    int failed = 0;
+    int run = 0;
+    for (const auto& t : registry()) {
+        if (!matches(filters, t.name)) continue;
+        if (list_only) {
+            std::cout << t.name << "\n";
+            continue;
+        }
+        ++run;
+        const int before = failures.load();
+        try {
+            t.fn();
+        } catch (const std::exception& e) {
+            fail(t.name.c_str(), 0, (std::string("uncaught exception: ") + e.what()).c_str());
+        } catch (...) {
+            fail(t.name.c_str(), 0, "uncaught exception");
+        }
+        const bool ok = failures.load() == before;
+        if (!ok) ++failed;
+        std::cout << (ok ? "[ OK   ] " : "[ FAIL ] ") << t.name << std::endl;
+    }
+
+    if (list_only) return 0;
+    std::cout << run - failed << "/" << run << " tests passed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
+
+} // namespace test
+
+int main(int argc, char** argv) {
+    return test::runMain(argc, argv);
+}
@@ -0,0 +1,340 @@
+// ThreadPool, TaskGroup и параллельные алгоритмы над SimpleVector против
+// последовательных std::: пулы из одного и нескольких потоков, явные мелкие
+// куски, скан и transform на месте, сортировка с повторяющимися ключами и
+// с исчерпанным запасом глубины, исключения из задач. Для списков —
+// chunk_bounds по индексу и проходом, пустые списки, отрезков больше, чем
+// элементов, и parallel_find_if, находящий первое совпадение по порядку
+
+#include "testing.h"
+
+#include "doublyLinkedList.h"
+#include "parallelAlgorithms.h"
+#include "simpleVector.h"
+#include "singlyLinkedList.h"
+#include "threadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kConcurrencies[] = {1, 4};
+constexpr std::size_t kGrains[] = {0, 1, 7, 1000};
+constexpr std::size_t kSizes[] = {0, 1, 5, 2049, 30011};
+
+SimpleVector<std::int64_t> randomVector(std::size_t size, std::uint32_t seed, std::int64_t range) {
+    std::mt19937 rng(seed);
+    SimpleVector<std::int64_t> v;
+    for (std::size_t i = 0; i < size; ++i) v.push_back(static_cast<std::int64_t>(rng() % range) - range / 2);
+    return v;
+}
+
+template<typename Vector>
+std::vector<typename Vector::value_type> items(const Vector& v) {
+    return std::vector<typename Vector::value_type>(v.begin(), v.end());
+}
+
+void pool() {
+    CHECK(ThreadPool(0).concurrency() == 1);
+    CHECK(ThreadPool(1).concurrency() == 1);
+    CHECK(ThreadPool(4).concurrency() == 4);
+
+    // Без рабочих потоков задачи выполняет тот, кто их забирает
+    std::atomic<int> done{0};
+    {
+        ThreadPool single(1);
+        CHECK(!single.run_pending_task());
+        single.submit([&done] { ++done; });
+        CHECK(single.run_pending_task() && done == 1);
+        CHECK(!single.run_pending_task());
+        single.submit([&done] { ++done; });
+    }
+    CHECK(done == 2);
+
+    // Закрытие пула дожидается всех поставленных задач
+    for (std::size_t concurrency : kConcurrencies) {
+        done = 0;
+        {
+            ThreadPool pool(concurrency);
+            for (int i = 0; i < 1000; ++i) pool.submit([&done] { ++done; });
+        }
+        CHECK(done == 1000);
+    }
+}
+
+void taskGroupNested() {
+    for (std::size_t concurrency : kConcurrencies) {
+        ThreadPool pool(concurrency);
+        std::atomic<int> count{0};
+        TaskGroup outer(pool);
+        for (int i = 0; i < 16; ++i) {
+            // Ожидающая задача сама выполняет задачи пула и не блокирует его
+            outer.run([&pool, &count] {
+                TaskGroup inner(pool);
+                for (int j = 0; j < 100; ++j) inner.run([&count] { ++count; });
+                inner.wait();
+                CHECK(count >= 100);
+            });
+        }
+        outer.wait();
+        CHECK(count == 1600);
+    }
+}
+
+void taskGroupExceptions() {
+    for (std::size_t concurrency : kConcurrencies) {
+        ThreadPool pool(concurrency);
+        std::atomic<int> count{0};
+        TaskGroup group(pool);
+        for (int i = 0; i < 100; ++i) {
+            group.run([&count, i] {
+                if (i == 37) throw std::runtime_error("task");
+                ++count;
+            });
+        }
+        CHECK_THROWS(group.wait(), std::runtime_error);
+        CHECK(count < 100);
+
+        // После wait группа снова пуста и пригодна
+        count = 0;
+        group.run([&count] { ++count; });
+        group.wait();
+        CHECK(count == 1);
+
+        // Исключение вложенной группы доходит до внешней
+        TaskGroup outer(pool);
+        outer.run([&pool] {
+            TaskGroup inner(pool);
+            inner.run([] { throw std::logic_error("inner"); });
+            inner.wait();
+        });
+        CHECK_THROWS(outer.wait(), std::logic_error);
+
+        // И из алгоритма — из любого куска
+        SimpleVector<std::int64_t> v = randomVector(5000, 1, 100);
+        const std::int64_t* target = &v[4000];
+        CHECK_THROWS(parallel_for(pool, v.begin(), v.end(), [target](std::int64_t& x) {
+            if (&x == target) throw std::runtime_error("element");
+        }, 10), std::runtime_error);
+    }
+}
+
+void forAndTransform() {
+    for (std::size_t concurrency : kConcurrencies) {
+        ThreadPool pool(concurrency);
+        for (std::size_t grain : kGrains) {
+            for (std::size_t size : kSizes) {
+                SimpleVector<std::int64_t> v = randomVector(size, static_cast<std::uint32_t>(size), 1000);
+                std::vector<std::int64_t> expected = items(v);
+                for (auto& x : expected) x = x * 3 + 1;
+
+                parallel_for(pool, v.begin(), v.end(), [](std::int64_t& x) { x = x * 3 + 1; }, grain);
+                CHECK(items(v) == expected);
+
+                SimpleVector<std::int64_t> out;
+                out.resize(size);
+                auto end = parallel_transform(pool, v.begin(), v.end(), out.begin(),
+                                              [](std::int64_t x) { return x - 5; }, grain);
+                std::transform(expected.begin(), expected.end(), expected.begin(),
+                               [](std::int64_t x) { return x - 5; });
+                CHECK(end == out.end() && items(out) == expected);
+
+                // На месте
+                parallel_transform(pool, out.begin(), out.end(), out.begin(),
+                                   [](std::int64_t x) { return -x; }, grain);
+                std::transform(expected.begin(), expected.end(), expected.begin(), std::negate<>());
+                CHECK(items(out) == expected);
+            }
+        }
+    }
+}
+
+void reduceAndScan() {
+    for (std::size_t concurrency : kConcurrencies) {
+        ThreadPool pool(concurrency);
+        for (std::size_t grain : kGrains) {
+            for (std::size_t size : kSizes) {
+                SimpleVector<std::int64_t> v = randomVector(size, static_cast<std::uint32_t>(size + 1), 1000);
+                const std::vector<std::int64_t> model = items(v);
+
+                CHECK(parallel_reduce(pool, v.begin(), v.end(), std::int64_t(7), std::plus<>(), grain) ==
+                      std::accumulate(model.begin(), model.end(), std::int64_t(7)));
+
+                std::vector<std::int64_t> expected(size);
+                std::partial_sum(model.begin(), model.end(), expected.begin());
+                SimpleVector<std::int64_t> out;
+                out.resize(size);
+                auto end = parallel_scan(pool, v.begin(), v.end(), out.begin(), std::plus<>(), grain);
+                CHECK(end == out.end() && items(out) == expected);
+
+                // На месте
+                parallel_scan(pool, v.begin(), v.end(), v.begin(), std::plus<>(), grain);
+                CHECK(items(v) == expected);
+            }
+
+            // Конкатенация ассоциативна, но не коммутативна: порядок кусков сохраняется
+            SimpleVector<std::string> words;
+            for (int i = 0; i < 3000; ++i) words.push_back(std::to_string(i % 10));
+            const std::vector<std::string> model = items(words);
+            CHECK(parallel_reduce(pool, words.begin(), words.end(), std::string("<"), std::plus<>(), grain) ==
+                  std::accumulate(model.begin(), model.end(), std::string("<")));
+            std::vector<std::string> expected(model.size());
+            std::partial_sum(model.begin(), model.end(), expected.begin());
+            parallel_scan(pool, words.begin(), words.end(), words.begin(), std::plus<>(), grain);
+            CHECK(items(words) == expected);
+        }
+    }
+}
+
+void sort() {
+    for (std::size_t concurrency : kConcurrencies) {
+        ThreadPool pool(concurrency);
+        for (std::size_t grain : kGrains) {
+            for (std::size_t size : kSizes) {
+                // Много одинаковых ключей
+                for (std::int64_t range : {std::int64_t(4), std::int64_t(1000000)}) {
+                    SimpleVector<std::int64_t> v = randomVector(size, static_cast<std::uint32_t>(size + 2), range);
+                    std::vector<std::int64_t> expected = items(v);
+                    std::sort(expected.begin(), expected.end());
+                    parallel_sort(pool, v.begin(), v.end(), std::less<>(), grain);
+                    CHECK(items(v) == expected);
+
+                    // Уже отсортированный и по убыванию
+                    parallel_sort(pool, v.begin(), v.end(), std::greater<>(), grain);
+                    std::reverse(expected.begin(), expected.end());
+                    CHECK(items(v) == expected);
+                }
+            }
+        }
+
+        SimpleVector<std::string> words;
+        std::vector<std::string> expected;
+        for (int i = 0; i < 5000; ++i) {
+            expected.push_back(std::to_string(i * 7919 % 1000));
+            words.push_back(expected.back());
+        }
+        std::sort(expected.begin(), expected.end());
+        parallel_sort(pool, words.begin(), words.end(), std::less<>(), 16);
+        CHECK(items(words) == expected);
+    }
+}
+
+// Исчерпанный запас глубины досортировывает остаток std::sort
+void sortDepthLimit() {
+    for (std::size_t concurrency : kConcurrencies) {
+        ThreadPool pool(concurrency);
+        for (int depth : {0, 1, 3}) {
+            SimpleVector<std::int64_t> v = randomVector(20000, static_cast<std::uint32_t>(depth), 50);
+            std::vector<std::int64_t> expected = items(v);
+            std::sort(expected.begin(), expected.end());
+            parallel_detail::sort_range(pool, v.begin(), v.end(), std::less<>(), 16, depth);
+            CHECK(items(v) == expected);
+        }
+    }
+}
+
+template<typename List>
+List makeList(std::size_t size, bool indexed) {
+    List list;
+    if (indexed) list.enable_index();
+    for (std::size_t i = 0; i < size; ++i) list.push_back(static_cast<int>(i % 100));
+    return list;
+}
+
+// Номера начал отрезков в списке
+template<typename List, typename It>
+std::vector<std::size_t> positions(const List& list, const std::vector<It>& bounds) {
+    std::vector<std::size_t> out;
+    for (const auto& it : bounds) {
+        out.push_back(static_cast<std::size_t>(std::distance(list.begin(), typename List::const_iterator(it))));
+    }
+    return out;
+}
+
+// Границы i * size / k, не больше size отрезков и ни одного пустого;
+// с индексом и проходом по списку — одинаковые
+template<typename List>
+void chunkBounds() {
+    for (std::size_t size : {0, 1, 3, 100, 1001}) {
+        const List walked = makeList<List>(size, false);
+        List indexed = makeList<List>(size, true);
+        CHECK(indexed.index_enabled());
+        for (std::size_t k : {0, 1, 2, 7, 1000, 5000}) {
+            const auto bounds = walked.chunk_bounds(k);
+            const std::size_t chunks = size == 0 ? 0 : std::max<std::size_t>(1, std::min(k, size));
+            CHECK(bounds.size() == chunks + 1);
+            CHECK(bounds.front() == (size == 0 ? walked.end() : walked.begin()) && bounds.back() == walked.end());
+
+            std::vector<std::size_t> expected;
+            for (std::size_t i = 0; i < chunks; ++i) expected.push_back(i * size / chunks);
+            expected.push_back(size);
+            CHECK(positions(walked, bounds) == expected);
+            CHECK(positions(indexed, indexed.chunk_bounds(k)) == expected);
+        }
+    }
+}
+
+template<typename List>
+void listAlgorithms() {
+    for (std::size_t concurrency : kConcurrencies) {
+        ThreadPool pool(concurrency);
+        for (bool indexed : {false, true}) {
+            for (std::size_t size : {0, 1, 3, 5000}) {
+                List list = makeList<List>(size, indexed);
+                std::vector<int> model(list.begin(), list.end());
+
+                parallel_for_each(pool, list, [](int& x) { x = x * 3 + 1; });
+                for (auto& x : model) x = x * 3 + 1;
+                CHECK(std::vector<int>(list.begin(), list.end()) == model);
+
+                const List& shared = list;
+                CHECK(parallel_reduce(pool, shared, 5L, std::plus<>()) ==
+                      std::accumulate(model.begin(), model.end(), 5L));
+
+                // Совпадения есть в каждом отрезке; нужен первый по порядку
+                auto found = parallel_find_if(pool, shared, [](int x) { return x == 3 * 42 + 1; });
+                auto expected = std::find(model.begin(), model.end(), 3 * 42 + 1);
+                CHECK(std::distance(shared.begin(), found) == std::distance(model.begin(), expected));
+                CHECK(parallel_find_if(pool, shared, [](int x) { return x < 0; }) == shared.end());
+
+                // Отрезков больше, чем элементов, и по одному элементу в отрезке
+                for (std::size_t k : {size + 10, size}) {
+                    const auto bounds = list.chunk_bounds(k);
+                    parallel_for_each(pool, bounds, [](int& x) { x -= 1; });
+                    for (auto& x : model) x -= 1;
+                    CHECK(std::vector<int>(list.begin(), list.end()) == model);
+                    CHECK(parallel_reduce(pool, bounds, 0L, std::plus<>()) ==
+                          std::accumulate(model.begin(), model.end(), 0L));
+                    auto last = parallel_find_if(pool, bounds, [&model](int x) { return x == model.back(); });
+                    CHECK(size == 0 ? last == list.end() : *last == model.back());
+                }
+            }
+        }
+    }
+}
+
+void registerAll() {
+    test::registerTest("ThreadPool/pool", pool);
+    test::registerTest("ThreadPool/task_group_nested", taskGroupNested);
+    test::registerTest("ThreadPool/task_group_exceptions", taskGroupExceptions);
+    test::registerTest("ParallelAlgorithms/for_and_transform", forAndTransform);
+    test::registerTest("ParallelAlgorithms/reduce_and_scan", reduceAndScan);
+    test::registerTest("ParallelAlgorithms/sort", sort);
+    test::registerTest("ParallelAlgorithms/sort_depth_limit", sortDepthLimit);
+    test::registerTest("ParallelAlgorithms/singly_chunk_bounds", chunkBounds<SinglyLinkedList<int>>);
+    test::registerTest("ParallelAlgorithms/doubly_chunk_bounds", chunkBounds<DoublyLinkedList<int>>);
+    test::registerTest("ParallelAlgorithms/singly_list_algorithms", listAlgorithms<SinglyLinkedList<int>>);
+    test::registerTest("ParallelAlgorithms/doubly_list_algorithms", listAlgorithms<DoublyLinkedList<int>>);
+}
+
+TEST_REGISTRATION(registerAll);
+
+} // namespace
@@ -0,0 +1,202 @@
+// PersistentVector: случайные операции против std::vector со снимками,
+// разделение чанков, откат при исключениях и чтение снимков из других
+// потоков, пока писатель меняет вектор (имеет смысл под LAB3_SANITIZE=thread)
+
+#include "testing.h"
+
+#include "persistentVector.h"
+#include "simpleVector.h"
+
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Копирование бросает исключение, когда budget доходит до нуля; -1 — без ограничений
+struct Boom {
+    static int budget;
+    int value;
+
+    Boom(int v) : value(v) {}
+    Boom(const Boom& other) : value(other.value) {
+        if (budget-- == 0) throw std::runtime_error("Boom");
+    }
+    Boom& operator=(const Boom&) = default;
+};
+
+int Boom::budget = -1;
+
+template<typename Vector>
+bool equals(const Vector& v, const std::vector<int>& ref) {
+    if (v.size() != ref.size()) return false;
+    for (std::size_t i = 0; i < ref.size(); ++i) {
+        if (v[i] != ref[i]) return false;
+    }
+    std::size_t i = 0;
+    for (int x : v) {
+        if (x != ref[i++]) return false;
+    }
+    return i == ref.size();
+}
+
+void randomOperations() {
+    using Vector = PersistentVector<int, 4>;
+    std::mt19937 rng(1);
+    Vector p;
+    std::vector<int> ref;
+    std::vector<std::pair<Vector, std::vector<int>>> snapshots;
+
+    for (int step = 0; step < 40000; ++step) {
+        const int x = static_cast<int>(rng());
+        switch (rng() % 10) {
+        case 0: case 1: case 2: case 3: case 4:
+            p.push_back(x);
+            ref.push_back(x);
+            break;
+        case 5:
+            if (!ref.empty()) {
+                p.pop_back();
+                ref.pop_back();
+            }
+            break;
+        case 6:
+            if (!ref.empty()) {
+                const std::size_t i = rng() % ref.size();
+                p[i] = x;
+                ref[i] = x;
+            }
+            break;
+        case 7:
+            if (ref.size() < 3000) {
+                const std::size_t i = rng() % (ref.size() + 1);
+                p.insert(i, x);
+                ref.insert(ref.begin() + static_cast<std::ptrdiff_t>(i), x);
+            }
+            break;
+        case 8:
+            if (ref.size() > 2000) {
+                const std::size_t i = rng() % ref.size();
+                p.erase(i);
+                ref.erase(ref.begin() + static_cast<std::ptrdiff_t>(i));
+            }
+            break;
+        default:
+            if (rng() % 50 == 0) {
+                snapshots.emplace_back(p, ref);
+                if (snapshots.size() > 20) snapshots.erase(snapshots.begin());
+            }
+        }
+        if (step % 997 == 0) {
+            CHECK(equals(p, ref));
+            for (const auto& s : snapshots) CHECK(equals(s.first, s.second));
+        }
+    }
+
+    while (!ref.empty()) {
+        p.pop_back();
+        ref.pop_back();
+    }
+    CHECK(equals(p, ref));
+    for (const auto& s : snapshots) CHECK(equals(s.first, s.second));
+}
+
+void sharing() {
+    PersistentVector<int> p;
+    for (int i = 0; i < 100000; ++i) p.push_back(i);
+    const auto s = p.snapshot();
+    CHECK(s.shares_chunk(0));
+    p[0] = -1;
+    CHECK(!p.shares_chunk(0));
+    CHECK(p.shares_chunk(50000));
+    CHECK(s[0] == 0 && p[0] == -1);
+
+    SimpleVector<int> v;
+    for (int x : s) v.push_back(x);
+    std::ostringstream a, b;
+    s.print(a);
+    v.print(b);
+    CHECK(a.str() == b.str());
+
+    auto it = s.begin();
+    it += 70000;
+    CHECK(*it == 70000);
+    --it;
+    CHECK(*it == 69999);
+    CHECK(it[5] == 70004);
+    CHECK(s.end() - s.begin() == 100000);
+}
+
+void strings() {
+    const PersistentVector<std::string> p{"a", "b", "c"};
+    auto q = p;
+    q.push_back(std::string(100, 'z'));
+    q[0] = "x";
+    CHECK(p.size() == 3 && p[0] == "a" && q[0] == "x");
+    q.clear();
+    CHECK(q.empty());
+    CHECK_THROWS(q.pop_back(), std::out_of_range);
+    CHECK_THROWS(p.at(3), std::out_of_range);
+}
+
+void exceptionSafety() {
+    PersistentVector<Boom, 4> p;
+    for (int i = 0; i < 16; ++i) p.push_back(Boom(i));
+
+    const Boom b(99);
+    Boom::budget = 0;
+    CHECK_THROWS(p.push_back(b), std::runtime_error);
+    Boom::budget = -1;
+    CHECK(p.size() == 16);
+    p.pop_back();
+    p.push_back(b);
+    CHECK(p[15].value == 99);
+
+    // Копирование разделяемого чанка падает на середине: оба вектора не меняются
+    const auto s = p;
+    Boom::budget = 2;
+    CHECK_THROWS(p[0] = Boom(5), std::runtime_error);
+    Boom::budget = -1;
+    CHECK(p[0].value == 0 && s[0].value == 0);
+}
+
+void snapshotReaders() {
+    PersistentVector<long> p;
+    for (long i = 0; i < 20000; ++i) p.push_back(i);
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        auto s = p.snapshot();
+        long expect = 0;
+        for (long x : s) expect += x;
+        readers.emplace_back([s = std::move(s), expect] {
+            for (int k = 0; k < 20; ++k) {
+                long sum = 0;
+                for (long x : s) sum += x;
+                CHECK(sum == expect);
+            }
+        });
+        for (std::size_t k = 0; k < 5000; ++k) {
+            p[(k * 7919) % p.size()] += 1;
+            p.push_back(static_cast<long>(k));
+            if (k % 3 == 0) p.pop_back();
+        }
+    }
+    for (auto& t : readers) t.join();
+}
+
+void registerAll() {
+    test::registerTest("PersistentVector/random_operations", randomOperations);
+    test::registerTest("PersistentVector/sharing", sharing);
+    test::registerTest("PersistentVector/strings", strings);
+    test::registerTest("PersistentVector/exception_safety", exceptionSafety);
+    test::registerTest("PersistentVector/snapshot_readers", snapshotReaders);
+}
+
+TEST_REGISTRATION(registerAll);
+
+} // namespace
@@ -0,0 +1,216 @@
+// Позиционный индекс списков (positionalIndex.h): operator[], insert и erase
+// по номеру с включённым индексом против std::vector, в том числе после
+// правок по итераторам (splice, split, erase), после которых индекс
+// перестраивается при следующем обращении по номеру, и одновременное чтение
+// по номеру через const-ссылку из нескольких потоков
+
+#include "testing.h"
+
+#include "doublyLinkedList.h"
+#include "nodePool.h"
+#include "singlyLinkedList.h"
+
+#include <iterator>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+template<typename List>
+bool equals(const List& list, const std::vector<int>& model) {
+    if (list.size() != model.size()) return false;
+    for (std::size_t i = 0; i < model.size(); ++i) {
+        if (list[i] != model[i]) return false;
+    }
+    return std::vector<int>(list.begin(), list.end()) == model;
+}
+
+// Итератор, после которого (singly) или перед которым (doubly) стоит позиция pos
+template<typename T, typename A>
+typename SinglyLinkedList<T, A>::const_iterator position(const SinglyLinkedList<T, A>& list, std::size_t pos) {
+    return pos == 0 ? list.cbefore_begin() : std::next(list.cbegin(), static_cast<std::ptrdiff_t>(pos - 1));
+}
+
+template<typename T, typename A>
+typename DoublyLinkedList<T, A>::const_iterator position(const DoublyLinkedList<T, A>& list, std::size_t pos) {
+    return std::next(list.cbegin(), static_cast<std::ptrdiff_t>(pos));
+}
+
+template<typename T, typename A>
+void spliceAt(SinglyLinkedList<T, A>& list, std::size_t pos, SinglyLinkedList<T, A>& other) {
+    list.splice_after(position(list, pos), other);
+}
+
+template<typename T, typename A>
+void spliceAt(DoublyLinkedList<T, A>& list, std::size_t pos, DoublyLinkedList<T, A>& other) {
+    list.splice(position(list, pos), other);
+}
+
+template<typename T, typename A>
+SinglyLinkedList<T, A> splitAt(SinglyLinkedList<T, A>& list, std::size_t pos) {
+    return list.split_after(position(list, pos));
+}
+
+template<typename T, typename A>
+DoublyLinkedList<T, A> splitAt(DoublyLinkedList<T, A>& list, std::size_t pos) {
+    return list.split(position(list, pos));
+}
+
+template<typename List>
+void randomOperations() {
+    std::mt19937 rng(3);
+    List list;
+    list.enable_index();
+    std::vector<int> model;
+
+    for (int step = 0; step < 20000; ++step) {
+        const int x = static_cast<int>(rng() % 100000);
+        const std::size_t pos = rng() % (model.size() + 1);
+        switch (rng() % 8) {
+        case 0: case 1: case 2:
+            list.insert(pos, x);
+            model.insert(model.begin() + static_cast<std::ptrdiff_t>(pos), x);
+            break;
+        case 3:
+            list.push_back(x);
+            model.push_back(x);
+            break;
+        case 4:
+            if (!model.empty()) {
+                const std::size_t at = pos % model.size();
+                list.erase(at);
+                model.erase(model.begin() + static_cast<std::ptrdiff_t>(at));
+            }
+            break;
+        case 5:
+            if (!model.empty()) {
+                const std::size_t at = pos % model.size();
+                list[at] = x;
+                model[at] = x;
+            }
+            break;
+        default:
+            if (!model.empty()) {
+                const std::size_t at = pos % model.size();
+                CHECK(list[at] == model[at]);
+            }
+        }
+        if (step % 1000 == 0) CHECK(equals(list, model));
+    }
+    CHECK(list.index_enabled());
+    CHECK(equals(list, model));
+
+    // Копия сохраняет индекс
+    const List copy(list);
+    CHECK(copy.index_enabled() && equals(copy, model));
+}
+
+// Правки по итераторам делают индекс недействительным; следующее обращение
+// по номеру перестраивает его по новому списку
+template<typename List>
+void afterIteratorEdits() {
+    std::mt19937 rng(5);
+    List list;
+    list.enable_index();
+    std::vector<int> model;
+    for (int i = 0; i < 2000; ++i) {
+        list.push_back(i);
+        model.push_back(i);
+    }
+
+    for (int round = 0; round < 50; ++round) {
+        List other(list.get_allocator());
+        std::vector<int> extra;
+        const std::size_t count = rng() % 20;
+        for (std::size_t i = 0; i < count; ++i) {
+            other.push_back(10000 + round * 100 + static_cast<int>(i));
+            extra.push_back(10000 + round * 100 + static_cast<int>(i));
+        }
+        const std::size_t at = rng() % (model.size() + 1);
+        spliceAt(list, at, other);
+        model.insert(model.begin() + static_cast<std::ptrdiff_t>(at), extra.begin(), extra.end());
+        CHECK(other.empty());
+        CHECK(list.index_enabled() && equals(list, model));
+
+        // Отрезанный хвост возвращается обратно в начало
+        const std::size_t cut = rng() % (model.size() + 1);
+        List tail = splitAt(list, cut);
+        std::vector<int> model_tail(model.begin() + static_cast<std::ptrdiff_t>(cut), model.end());
+        model.resize(cut);
+        CHECK(equals(list, model) && equals(tail, model_tail));
+        spliceAt(list, 0, tail);
+        model.insert(model.begin(), model_tail.begin(), model_tail.end());
+
+        const std::size_t probe = rng() % model.size();
+        CHECK(list[probe] == model[probe]);
+        list.insert(probe, -round);
+        model.insert(model.begin() + static_cast<std::ptrdiff_t>(probe), -round);
+        list.erase(model.size() - 1);
+        model.pop_back();
+        CHECK(equals(list, model));
+    }
+
+    list.disable_index();
+    CHECK(!list.index_enabled() && equals(list, model));
+}
+
+// Константный operator[] ничего не меняет в списке: потоки читают один
+// список без синхронизации (гонки ловит сборка с LAB3_SANITIZE=thread)
+template<typename List>
+void concurrentConstReads() {
+    for (const bool indexed : {false, true}) {
+        List list;
+        if (indexed) list.enable_index();
+        std::vector<int> model;
+        for (int i = 0; i < 3000; ++i) {
+            list.push_back(i * 3);
+            model.push_back(i * 3);
+        }
+        if (indexed) {
+            // Индекс устарел: const-поиск идёт по списку, не перестраивая его
+            List other(list.get_allocator());
+            other.push_back(-1);
+            spliceAt(list, 0, other);
+            model.insert(model.begin(), -1);
+        }
+
+        const List& shared = list;
+        std::vector<int> mismatches(4, 0);
+        std::vector<std::thread> readers;
+        for (std::size_t t = 0; t < mismatches.size(); ++t) {
+            readers.emplace_back([&shared, &model, &mismatches, t] {
+                std::mt19937 rng(static_cast<unsigned>(t));
+                for (int i = 0; i < 500; ++i) {
+                    const std::size_t pos = rng() % model.size();
+                    if (shared[pos] != model[pos]) ++mismatches[t];
+                }
+            });
+        }
+        for (auto& reader : readers) reader.join();
+        CHECK(mismatches == std::vector<int>(mismatches.size(), 0));
+
+        // Изменяющий доступ перестраивает индекс как раньше
+        list.insert(1, 7);
+        model.insert(model.begin() + 1, 7);
+        CHECK(list.index_enabled() == indexed && equals(list, model));
+    }
+}
+
+template<typename List>
+void registerFor(const std::string& name) {
+    test::registerTest("PositionalIndex/" + name + "/random_operations", randomOperations<List>);
+    test::registerTest("PositionalIndex/" + name + "/after_iterator_edits", afterIteratorEdits<List>);
+    test::registerTest("PositionalIndex/" + name + "/concurrent_const_reads", concurrentConstReads<List>);
+}
+
+void registerAll() {
+    registerFor<SinglyLinkedList<int>>("SinglyLinkedList<int>");
+    registerFor<DoublyLinkedList<int>>("DoublyLinkedList<int>");
+    registerFor<DoublyLinkedList<int, PoolAllocator<int>>>("PooledDoublyLinkedList<int>");
+}
+
+TEST_REGISTRATION(registerAll);
+
+} // namespace
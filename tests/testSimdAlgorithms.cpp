@@ -0,0 +1,196 @@
+// Векторные ядра simdAlgorithms.h против обычных циклов *_scalar на каждом
+// уровне set_max_isa: все типы дорожек, длины вокруг ширины вектора,
+// невыровненное начало и выборка на месте. Уровни выше возможностей
+// процессора сводятся к доступному (active_isa)
+
+#include "testing.h"
+
+#include "simdAlgorithms.h"
+#include "simpleVector.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using simd::Compare;
+using simd::Isa;
+
+// Обычные циклы *_scalar — образец для векторных ядер
+namespace scalar = simd::simd_detail;
+
+constexpr Isa kLevels[] = {Isa::scalar, Isa::sse2, Isa::avx2, Isa::avx512};
+constexpr Compare kCompares[] = {Compare::equal, Compare::not_equal, Compare::less,
+                                 Compare::less_equal, Compare::greater, Compare::greater_equal};
+
+// Восстанавливает уровень по умолчанию, даже если проверка бросила исключение
+struct IsaScope {
+    explicit IsaScope(Isa isa) { simd::set_max_isa(isa); }
+    ~IsaScope() { simd::set_max_isa(Isa::avx512); }
+    IsaScope(const IsaScope&) = delete;
+    IsaScope& operator=(const IsaScope&) = delete;
+};
+
+// Малый диапазон значений, чтобы совпадения и сравнения были частыми; изредка
+// крайние значения типа. Дробные числа целые, поэтому сумма точна в любом порядке
+template<typename T>
+T randomValue(std::mt19937& rng) {
+    const unsigned r = rng() % 64;
+    if (r == 0) return std::numeric_limits<T>::max();
+    if (r == 1 && !std::is_floating_point_v<T>) return std::numeric_limits<T>::lowest();
+    if constexpr (std::is_signed_v<T>) return static_cast<T>(static_cast<int>(rng() % 17) - 8);
+    else return static_cast<T>(rng() % 17);
+}
+
+template<typename T>
+bool same(T a, T b) {
+    if constexpr (std::is_floating_point_v<T>) return a == b || (std::isnan(a) && std::isnan(b));
+    else return a == b;
+}
+
+template<typename T>
+bool copyIfMatches(const std::vector<T>& src, std::size_t offset, std::size_t n, Compare op, T value) {
+    std::vector<T> expect(n + 1);
+    std::size_t kept = 0;
+    const T* from = src.data() + offset;
+    switch (op) {
+    case Compare::equal: kept = scalar::copy_if_scalar<Compare::equal>(from, n, expect.data(), value); break;
+    case Compare::not_equal: kept = scalar::copy_if_scalar<Compare::not_equal>(from, n, expect.data(), value); break;
+    case Compare::less: kept = scalar::copy_if_scalar<Compare::less>(from, n, expect.data(), value); break;
+    case Compare::less_equal: kept = scalar::copy_if_scalar<Compare::less_equal>(from, n, expect.data(), value); break;
+    case Compare::greater: kept = scalar::copy_if_scalar<Compare::greater>(from, n, expect.data(), value); break;
+    default: kept = scalar::copy_if_scalar<Compare::greater_equal>(from, n, expect.data(), value); break;
+    }
+
+    // В отдельный буфер
+    std::vector<T> out(n + 1);
+    if (simd::copy_if(from, n, out.data(), op, value) != kept) return false;
+    for (std::size_t i = 0; i < kept; ++i) {
+        if (!same(out[i], expect[i])) return false;
+    }
+
+    // На месте
+    std::vector<T> inplace(src);
+    if (simd::copy_if(inplace.data() + offset, n, inplace.data() + offset, op, value) != kept) return false;
+    for (std::size_t i = 0; i < kept; ++i) {
+        if (!same(inplace[offset + i], expect[i])) return false;
+    }
+    return true;
+}
+
+template<typename T>
+void kernelsAgainstScalar() {
+    std::mt19937 rng(sizeof(T) * 131 + std::is_signed_v<T> * 7 + std::is_floating_point_v<T>);
+    std::vector<std::size_t> lengths;
+    for (std::size_t n = 0; n <= 260; ++n) lengths.push_back(n);
+    lengths.push_back(1000);
+    lengths.push_back(4099);
+
+    for (Isa isa : kLevels) {
+        IsaScope scope(isa);
+        CHECK(simd::active_isa() == std::min(isa, simd::detected_isa()));
+        bool ok = true;
+        for (std::size_t n : lengths) {
+            for (std::size_t offset = 0; offset < 4 && ok; ++offset) {
+                std::vector<T> a(n + offset + 1);
+                for (auto& x : a) x = randomValue<T>(rng);
+                std::vector<T> b(a);
+                if (n > 0 && rng() % 2) {
+                    T& x = b[offset + rng() % n];
+                    x = x == T(1) ? T(2) : T(1);
+                }
+                const T* p = a.data() + offset;
+                const T value = randomValue<T>(rng);
+
+                ok = ok && simd::find(p, n, value) == scalar::find_scalar(p, n, value);
+                ok = ok && simd::count(p, n, value) == scalar::count_scalar(p, n, value);
+                ok = ok && simd::mismatch(p, b.data() + offset, n) ==
+                               scalar::mismatch_scalar(p, b.data() + offset, n);
+                ok = ok && simd::sum(p, n) == scalar::sum_scalar(p, n);
+                if (n > 0) {
+                    ok = ok && simd::min(p, n) == scalar::minmax_scalar<false>(p, n, p[0]);
+                    ok = ok && simd::max(p, n) == scalar::minmax_scalar<true>(p, n, p[0]);
+                }
+                for (Compare op : kCompares) ok = ok && copyIfMatches(a, offset, n, op, value);
+            }
+        }
+        CHECK(ok);
+    }
+}
+
+// NaN не равен ничему, включая себя: find и count его не находят,
+// mismatch останавливается на нём, сравнения для него ложны
+template<typename T>
+void nanHandling() {
+    std::vector<T> a(300);
+    for (std::size_t i = 0; i < a.size(); ++i) a[i] = static_cast<T>(i % 5);
+    a[37] = std::numeric_limits<T>::quiet_NaN();
+    a[200] = std::numeric_limits<T>::quiet_NaN();
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+
+    for (Isa isa : kLevels) {
+        IsaScope scope(isa);
+        CHECK(simd::find(a.data(), a.size(), nan) == a.size());
+        CHECK(simd::count(a.data(), a.size(), nan) == 0);
+        CHECK(simd::find(a.data(), a.size(), T(4)) == 4);
+        CHECK(simd::mismatch(a.data(), a.data(), a.size()) == 37);
+        for (Compare op : kCompares) CHECK(copyIfMatches(a, 0, a.size(), op, T(2)));
+    }
+}
+
+// Обёртки над контейнерами и пустые массивы
+void containers() {
+    SimpleVector<int> v;
+    for (int i = 0; i < 1000; ++i) v.push_back(i % 10 - 3);
+    CHECK(simd::find(v, 6) == 9);
+    CHECK(simd::count(v, 0) == 100);
+    CHECK(simd::min(v) == -3 && simd::max(v) == 6);
+    CHECK(simd::sum(v) == 1500);
+
+    SimpleVector<int> w(v);
+    CHECK(simd::equal(v, w));
+    w[700] = 42;
+    CHECK(simd::mismatch(v, w) == 700 && !simd::equal(v, w));
+
+    const SimpleVector<int> positive = simd::filter(v, Compare::greater, 0);
+    CHECK(positive.size() == 600 && simd::min(positive) == 1);
+    CHECK(simd::compact(v, Compare::less, 0) == 300);
+    CHECK(v.size() == 300 && simd::max(v) == -1 && v[0] == -3 && v[299] == -1);
+
+    const SimpleVector<double> empty;
+    CHECK(simd::min(empty) == std::numeric_limits<double>::infinity());
+    CHECK(simd::max(empty) == -std::numeric_limits<double>::infinity());
+    CHECK(simd::sum(empty) == 0.0 && simd::find(empty, 1.0) == 0);
+}
+
+template<typename T>
+void registerFor(const std::string& name) {
+    test::registerTest("Simd/" + name + "/kernels_against_scalar", kernelsAgainstScalar<T>);
+}
+
+void registerAll() {
+    registerFor<std::int8_t>("int8");
+    registerFor<std::uint8_t>("uint8");
+    registerFor<char>("char");
+    registerFor<std::int16_t>("int16");
+    registerFor<std::uint16_t>("uint16");
+    registerFor<std::int32_t>("int32");
+    registerFor<std::uint32_t>("uint32");
+    registerFor<std::int64_t>("int64");
+    registerFor<std::uint64_t>("uint64");
+    registerFor<long>("long");
+    registerFor<float>("float");
+    registerFor<double>("double");
+    registerFor<long double>("long_double");
+    test::registerTest("Simd/float/nan", nanHandling<float>);
+    test::registerTest("Simd/double/nan", nanHandling<double>);
+    test::registerTest("Simd/containers", containers);
+}
+
+TEST_REGISTRATION(registerAll);
+
+} // namespace
@@ -0,0 +1,385 @@
+// SimpleVector: ёмкость, при которой размер буфера в байтах не помещается
+// в size_t, отвергается до выделения памяти, и вектор не меняется.
+// Групповые операции (insert диапазона и n копий, erase диапазона, resize,
+// append_range, emplace) против std::vector для тривиально перемещаемых и
+// обычных элементов и откат вставки при исключении из конструктора.
+// shrink_to_fit, уменьшение буфера с ShrinkingGrowthPolicy и memory_usage
+
+#include "testing.h"
+
+#include "growthPolicy.h"
+#include "platformMemory.h"
+#include "simpleVector.h"
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+template<typename T>
+void hugeCapacity(const T& value) {
+    SimpleVector<T> v;
+    for (int i = 0; i < 10; ++i) v.push_back(value);
+    const std::size_t capacity = v.capacity();
+
+    // 2^60 элементов по 4 и больше байт — переполнение cap * sizeof(T)
+    const std::size_t huge = std::size_t(1) << 60;
+    CHECK_THROWS(v.reserve(huge), std::bad_alloc);
+    CHECK_THROWS(v.reserve(std::numeric_limits<std::size_t>::max()), std::bad_alloc);
+    CHECK_THROWS(v.resize(huge), std::bad_alloc);
+    CHECK(v.size() == 10 && v.capacity() == capacity && v[9] == value);
+
+    v.push_back(value);
+    CHECK(v.size() == 11);
+}
+
+void hugeCapacityRaw() {
+    hugeCapacity<std::int32_t>(42);
+}
+
+void hugeCapacityObjects() {
+    hugeCapacity<std::string>("value");
+}
+
+// Нетривиальный элемент: копирование бросает, когда budget доходит до нуля
+// (-1 — без ограничений); alive считает живые объекты
+struct Item {
+    static inline int budget = -1;
+    static inline int alive = 0;
+
+    std::string text;
+
+    Item() : text("?") { ++alive; }
+    Item(int v) : text(std::to_string(v)) { ++alive; }
+    Item(int a, int b) : text(std::to_string(a + b)) { ++alive; }
+    Item(const Item& other) : text(other.text) {
+        if (budget == 0) throw std::runtime_error("Item");
+        if (budget > 0) --budget;
+        ++alive;
+    }
+    Item(Item&& other) noexcept : text(std::move(other.text)) { ++alive; }
+    Item& operator=(const Item&) = default;
+    Item& operator=(Item&&) = default;
+    ~Item() { --alive; }
+};
+
+static_assert(is_trivially_relocatable_v<int> && !is_trivially_relocatable_v<Item>);
+
+int key(int x) { return x; }
+int key(const Item& x) { return x.text == "?" ? -1 : std::stoi(x.text); }
+
+template<typename T, typename... Policies>
+std::vector<int> items(const SimpleVector<T, Policies...>& v) {
+    std::vector<int> out;
+    for (const auto& x : v) out.push_back(key(x));
+    return out;
+}
+
+template<typename T>
+SimpleVector<T> iota(int count) {
+    SimpleVector<T> v;
+    for (int i = 0; i < count; ++i) v.push_back(T(i));
+    return v;
+}
+
+std::vector<int> iotaModel(int count) {
+    std::vector<int> out;
+    for (int i = 0; i < count; ++i) out.push_back(i);
+    return out;
+}
+
+template<typename T>
+void insertCopies() {
+    for (int size : {0, 1, 5, 40}) {
+        for (std::size_t count : {0, 1, 3, 100}) {
+            for (std::size_t pos : {std::size_t(0), std::size_t(size) / 2, std::size_t(size)}) {
+                SimpleVector<T> v = iota<T>(size);
+                std::vector<int> model = iotaModel(size);
+                v.insert(pos, count, T(77));
+                model.insert(model.begin() + static_cast<std::ptrdiff_t>(pos), count, 77);
+                CHECK(items(v) == model);
+            }
+        }
+    }
+
+    // Значение — элемент самого вектора, буфер при вставке переезжает
+    SimpleVector<T> v = iota<T>(4);
+    v.shrink_to_fit();
+    v.insert(1, 50, v[3]);
+    std::vector<int> model = iotaModel(4);
+    model.insert(model.begin() + 1, 50, 3);
+    CHECK(items(v) == model);
+    CHECK_THROWS(v.insert(v.size() + 1, 1, T(0)), std::out_of_range);
+}
+
+template<typename T>
+void insertRanges() {
+    // Однопроходный диапазон: длина заранее неизвестна
+    for (std::size_t pos : {0, 2, 5}) {
+        SimpleVector<T> v = iota<T>(5);
+        std::vector<int> model = iotaModel(5);
+        std::istringstream in("10 11 12 13 14 15 16");
+        v.insert(pos, std::istream_iterator<int>(in), std::istream_iterator<int>());
+        model.insert(model.begin() + static_cast<std::ptrdiff_t>(pos), {10, 11, 12, 13, 14, 15, 16});
+        CHECK(items(v) == model);
+
+        std::istringstream empty("");
+        v.insert(pos, std::istream_iterator<int>(empty), std::istream_iterator<int>());
+        CHECK(items(v) == model);
+    }
+
+    // Двунаправленный диапазон и initializer_list
+    SimpleVector<T> v;
+    const std::list<int> source{7, 8, 9};
+    v.insert(0, source.begin(), source.end());
+    v.insert(1, {T(1), T(2)});
+    v.insert(v.size(), source.begin(), source.begin());
+    CHECK(items(v) == (std::vector<int>{7, 1, 2, 8, 9}));
+}
+
+template<typename T>
+void eraseRanges() {
+    for (std::size_t first : {0, 3, 10}) {
+        for (std::size_t last : {first, first + 1, std::size_t(10)}) {
+            if (last < first || last > 10) continue;
+            SimpleVector<T> v = iota<T>(10);
+            std::vector<int> model = iotaModel(10);
+            v.erase(first, last);
+            model.erase(model.begin() + static_cast<std::ptrdiff_t>(first),
+                        model.begin() + static_cast<std::ptrdiff_t>(last));
+            CHECK(items(v) == model);
+        }
+    }
+    SimpleVector<T> v = iota<T>(10);
+    CHECK_THROWS(v.erase(5, 11), std::out_of_range);
+    CHECK_THROWS(v.erase(6, 5), std::out_of_range);
+    CHECK(items(v) == iotaModel(10));
+}
+
+template<typename T>
+void resizes() {
+    SimpleVector<T> v = iota<T>(5);
+    v.resize(8);
+    const int blank = key(T());
+    CHECK(items(v) == (std::vector<int>{0, 1, 2, 3, 4, blank, blank, blank}));
+    v.resize(3);
+    CHECK(items(v) == (std::vector<int>{0, 1, 2}));
+    v.resize(6, T(9));
+    CHECK(items(v) == (std::vector<int>{0, 1, 2, 9, 9, 9}));
+    v.resize(2, T(9));
+    v.resize(0);
+    CHECK(v.empty());
+
+    // Новые элементы перезаписываются, старые остаются
+    v = iota<T>(3);
+    v.resize_for_overwrite(100);
+    CHECK(v.size() == 100 && v.capacity() >= 100);
+    for (int i = 3; i < 100; ++i) v[static_cast<std::size_t>(i)] = T(i);
+    CHECK(items(v) == iotaModel(100));
+    v.resize_for_overwrite(4);
+    CHECK(items(v) == iotaModel(4));
+}
+
+template<typename T>
+void appendAndEmplace() {
+    SimpleVector<T> v = iota<T>(3);
+    const std::vector<T> vector{T(3), T(4)};
+    const T array[] = {T(5), T(6)};
+    v.append_range(vector);
+    v.append_range(array);
+    v.append_range(std::array<T, 0>{});
+    CHECK(items(v) == iotaModel(7));
+
+    // Сам себе: элементы копируются до переаллокации
+    for (int round = 0; round < 3; ++round) {
+        v.shrink_to_fit();
+        v.append_range(v);
+    }
+    std::vector<int> model = iotaModel(7);
+    for (int round = 0; round < 3; ++round) model.insert(model.end(), model.begin(), model.end());
+    CHECK(items(v) == model);
+
+    SimpleVector<T> e;
+    e.emplace(0, 5);
+    e.emplace(0, 1);
+    if constexpr (std::is_constructible_v<T, int, int>) {
+        // Несколько аргументов конструктора
+        e.emplace(1, 1, 2);
+        e.emplace(e.size(), 2, 5);
+    } else {
+        e.emplace(1, 3);
+        e.emplace(e.size(), 7);
+    }
+    CHECK(key(e.emplace(2, 4)) == 4);
+    e.emplace(1, e[3]);
+    CHECK(items(e) == (std::vector<int>{1, 5, 3, 4, 5, 7}));
+    CHECK_THROWS(e.emplace(7, 0), std::out_of_range);
+}
+
+template<typename T>
+void bulkOperations() {
+    insertCopies<T>();
+    insertRanges<T>();
+    eraseRanges<T>();
+    resizes<T>();
+    appendAndEmplace<T>();
+}
+
+void bulkRaw() {
+    bulkOperations<int>();
+}
+
+void bulkObjects() {
+    bulkOperations<Item>();
+    CHECK(Item::alive == 0);
+}
+
+// Бросивший конструктор: созданные элементы уничтожаются, промежуток
+// смыкается, вектор остаётся прежним — с переаллокацией и без неё
+void insertRollback() {
+    {
+        for (bool reserved : {false, true}) {
+            for (std::size_t pos : {0, 3, 6}) {
+                SimpleVector<Item> v = iota<Item>(6);
+                if (reserved) v.reserve(100);
+                const int before = Item::alive;
+                const Item value(42);
+                const std::vector<Item> range(5, Item(43));
+
+                Item::budget = 3;
+                CHECK_THROWS(v.insert(pos, 5, value), std::runtime_error);
+                Item::budget = 2;
+                CHECK_THROWS(v.insert(pos, range.begin(), range.end()), std::runtime_error);
+                Item::budget = 4;
+                CHECK_THROWS(v.append_range(range), std::runtime_error);
+                Item::budget = 2;
+                CHECK_THROWS(v.resize(10, value), std::runtime_error);
+                Item::budget = -1;
+
+                CHECK(items(v) == iotaModel(6) && Item::alive == before + 6);
+                v.insert(pos, 2, value);
+                CHECK(v.size() == 8 && key(v[pos]) == 42);
+            }
+        }
+    }
+    CHECK(Item::alive == 0);
+}
+
+template<typename T>
+void shrinkToFit() {
+    SimpleVector<T> v;
+    CHECK(v.memory_usage().used == 0 && v.memory_usage().reserved == 0);
+    for (int i = 0; i < 1000; ++i) v.push_back(T(i));
+    const std::size_t grown = v.capacity();
+    CHECK(v.memory_usage().used == 1000 * sizeof(T));
+    CHECK(v.memory_usage().reserved == grown * sizeof(T));
+    CHECK(v.memory_usage().overhead() == (grown - 1000) * sizeof(T));
+
+    // Без политики уменьшения erase и clear буфер не трогают
+    v.erase(10, v.size());
+    CHECK(v.capacity() == grown);
+    v.shrink_to_fit();
+    CHECK(v.capacity() == 10 && items(v) == iotaModel(10));
+    CHECK(v.memory_usage().reserved == v.memory_usage().used);
+    v.clear();
+    CHECK(v.capacity() == 10);
+    v.shrink_to_fit();
+    CHECK(v.capacity() == 0 && v.data() == nullptr && v.memory_usage().reserved == 0);
+    v.push_back(T(1));
+    CHECK(items(v) == (std::vector<int>{1}));
+}
+
+template<typename T>
+void shrinkingPolicy() {
+    SimpleVector<T, ShrinkingGrowthPolicy> v;
+    for (int i = 0; i < 1000; ++i) v.push_back(T(i));
+    CHECK(v.capacity() >= 1000);
+
+    // Меньше четверти буфера — уменьшение до size * 1.5
+    v.erase(100, v.size());
+    CHECK(v.capacity() == 150 && v.size() == 100);
+    v.erase(38, v.size());
+    CHECK(v.capacity() == 150);
+    v.erase(37);
+    CHECK(v.capacity() == 55 && items(v) == iotaModel(37));
+
+    // Колебание размера около порога не переаллоцирует буфер: после
+    // уменьшения до size * 1.5 до роста и до нового уменьшения далеко
+    for (int round = 0; round < 100; ++round) {
+        v.push_back(T(37));
+        CHECK(v.capacity() == 55);
+        v.erase(v.size() - 1);
+        CHECK(v.capacity() == 55);
+    }
+    for (int round = 0; round < 100; ++round) {
+        v.erase(v.size() - 1, v.size());
+        v.insert(v.size(), 1, T(36));
+        CHECK(v.capacity() == 55);
+    }
+    CHECK(items(v) == iotaModel(37));
+
+    v.clear();
+    CHECK(v.capacity() == 0 && v.memory_usage().reserved == 0);
+    v.push_back(T(5));
+    CHECK(items(v) == (std::vector<int>{5}));
+}
+
+// Небольшой порог mmap, чтобы проверить отображённый буфер без сотен мегабайт
+struct SmallMapPolicy : ShrinkingGrowthPolicy {
+    static constexpr std::size_t mmap_threshold = std::size_t(256) << 10;
+};
+
+void mappedMemoryUsage() {
+    SimpleVector<std::int32_t, SmallMapPolicy> v;
+    v.resize(200000);
+    const std::size_t capacity = v.capacity();
+    const MemoryUsage usage = v.memory_usage();
+    CHECK(usage.used == 200000 * sizeof(std::int32_t));
+    CHECK(usage.reserved >= capacity * sizeof(std::int32_t));
+    if (platform::has_mmap) {
+        // Отображение считается целыми страницами; пустой буфер отдаёт
+        // страницы ядру, но остаётся за вектором
+        CHECK(usage.reserved % platform::page_size() == 0);
+        v.clear();
+        CHECK(v.capacity() == capacity && v.memory_usage().reserved == usage.reserved);
+        v.resize(10);
+        CHECK(v.capacity() == capacity);
+    }
+    v.shrink_to_fit();
+    CHECK(v.capacity() == 10 && v.memory_usage().reserved == 10 * sizeof(std::int32_t));
+}
+
+void shrinkRaw() {
+    shrinkToFit<int>();
+    shrinkingPolicy<int>();
+}
+
+void shrinkObjects() {
+    shrinkToFit<Item>();
+    shrinkingPolicy<Item>();
+    CHECK(Item::alive == 0);
+}
+
+void registerAll() {
+    test::registerTest("SimpleVector/huge_capacity_raw", hugeCapacityRaw);
+    test::registerTest("SimpleVector/huge_capacity_objects", hugeCapacityObjects);
+    test::registerTest("SimpleVector/bulk_raw", bulkRaw);
+    test::registerTest("SimpleVector/bulk_objects", bulkObjects);
+    test::registerTest("SimpleVector/insert_rollback", insertRollback);
+    test::registerTest("SimpleVector/shrink_raw", shrinkRaw);
+    test::registerTest("SimpleVector/shrink_objects", shrinkObjects);
+    test::registerTest("SimpleVector/mapped_memory_usage", mappedMemoryUsage);
+}
+
+TEST_REGISTRATION(registerAll);
+
+} // namespace
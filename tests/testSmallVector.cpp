@@ -0,0 +1,289 @@
+// SmallVector: размер SimpleVector без встроенного буфера, переходы между
+// встроенным буфером и кучей, перемещения между SmallVector разных N и
+// SimpleVector (noexcept только там, где память не выделяется), в том числе
+// через SimpleVector& и с бросающим копированием элементов, и swap
+
+#include "testing.h"
+
+#include "simpleVector.h"
+#include "smallVector.h"
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Считает живые объекты: после каждой проверки их должно быть столько,
+// сколько элементов в векторах
+struct Counted {
+    static inline int alive = 0;
+
+    std::string value;
+
+    Counted(std::string v) : value(std::move(v)) { ++alive; }
+    Counted(const Counted& other) : value(other.value) { ++alive; }
+    Counted(Counted&& other) noexcept : value(std::move(other.value)) { ++alive; }
+    Counted& operator=(const Counted&) = default;
+    Counted& operator=(Counted&&) = default;
+    ~Counted() { --alive; }
+
+    bool operator==(const Counted& other) const { return value == other.value; }
+};
+
+template<typename Vector>
+std::vector<std::string> items(const Vector& v) {
+    std::vector<std::string> out;
+    for (const auto& x : v) out.push_back(x.value);
+    return out;
+}
+
+template<typename Vector>
+void fill(Vector& v, int from, int count) {
+    for (int i = from; i < from + count; ++i) v.push_back(typename Vector::value_type(std::to_string(i)));
+}
+
+std::vector<std::string> range(int from, int count) {
+    std::vector<std::string> out;
+    for (int i = from; i < from + count; ++i) out.push_back(std::to_string(i));
+    return out;
+}
+
+void layout() {
+    // Встроенный буфер не увеличивает обычный SimpleVector (счётчики
+    // LAB3_STATS добавляют свои поля)
+    static_assert(stats_enabled || sizeof(SimpleVector<int>) == 3 * sizeof(void*));
+    static_assert(stats_enabled || sizeof(SimpleVector<std::string>) == 3 * sizeof(void*));
+    static_assert(sizeof(SmallVector<int, 4>) <= sizeof(SimpleVector<int>) + 2 * sizeof(void*) + 4 * sizeof(int));
+
+    // Перемещение, которое может выделить память, не объявлено noexcept. За
+    // SimpleVector&& может стоять SmallVector во встроенном буфере; обмен
+    // обычных векторов меняет указатели
+    static_assert(!std::is_nothrow_move_constructible_v<SimpleVector<Counted>>);
+    static_assert(!std::is_nothrow_move_assignable_v<SimpleVector<Counted>>);
+    static_assert(std::is_nothrow_swappable_v<SimpleVector<Counted>>);
+    static_assert(!std::is_nothrow_constructible_v<SmallVector<Counted, 4>, SimpleVector<Counted>&&>);
+    static_assert(std::is_nothrow_move_constructible_v<SmallVector<Counted, 4>>);
+    static_assert(std::is_nothrow_move_assignable_v<SmallVector<Counted, 4>>);
+    static_assert(!std::is_nothrow_constructible_v<SimpleVector<Counted>, SmallVector<Counted, 4>&&>);
+    static_assert(!std::is_nothrow_assignable_v<SimpleVector<Counted>&, SmallVector<Counted, 4>&&>);
+    static_assert(!std::is_nothrow_constructible_v<SmallVector<Counted, 2>, SmallVector<Counted, 8>&&>);
+    CHECK(true);
+}
+
+void inlineAndHeap() {
+    {
+        SmallVector<Counted, 4> v;
+        CHECK(v.is_small() && v.capacity() == 4 && v.empty());
+        fill(v, 0, 4);
+        CHECK(v.is_small() && v.capacity() == 4 && Counted::alive == 4);
+        fill(v, 4, 20);
+        CHECK(!v.is_small() && v.capacity() >= 24 && items(v) == range(0, 24));
+
+        // Обратно во встроенный буфер, когда элементы в нём помещаются
+        v.erase(3, v.size());
+        v.shrink_to_fit();
+        CHECK(v.is_small() && v.capacity() == 4 && items(v) == range(0, 3));
+        fill(v, 3, 10);
+        CHECK(!v.is_small() && items(v) == range(0, 13));
+        v.clear();
+        v.shrink_to_fit();
+        CHECK(v.is_small() && v.capacity() == 4 && Counted::alive == 0);
+
+        // Копия и присваивание копированием
+        fill(v, 0, 6);
+        SmallVector<Counted, 4> copy(v);
+        CHECK(items(copy) == range(0, 6) && Counted::alive == 12);
+        SmallVector<Counted, 4> small;
+        fill(small, 100, 2);
+        copy = small;
+        CHECK(items(copy) == range(100, 2));
+    }
+    CHECK(Counted::alive == 0);
+}
+
+void moves() {
+    {
+        // Встроенный буфер: элементы переносятся поштучно
+        SmallVector<Counted, 4> a;
+        fill(a, 0, 3);
+        SmallVector<Counted, 4> b(std::move(a));
+        CHECK(a.empty() && a.is_small() && b.is_small() && items(b) == range(0, 3));
+
+        // Куча: буфер забирается целиком, источник возвращается во встроенный
+        fill(b, 3, 10);
+        const Counted* heap = b.data();
+        SmallVector<Counted, 4> c(std::move(b));
+        CHECK(c.data() == heap && b.empty() && b.is_small() && b.capacity() == 4);
+        CHECK(items(c) == range(0, 13));
+
+        // В SimpleVector и обратно
+        SimpleVector<Counted> plain(std::move(c));
+        CHECK(plain.data() == heap && c.is_small() && c.empty());
+        SmallVector<Counted, 2> back(std::move(plain));
+        CHECK(back.data() == heap && plain.empty() && plain.capacity() == 0);
+
+        SmallVector<Counted, 8> wide;
+        fill(wide, 0, 6);
+        SimpleVector<Counted> fresh(std::move(wide));
+        CHECK(items(fresh) == range(0, 6) && wide.empty() && wide.is_small());
+
+        // Из большего встроенного буфера в меньший: нужен буфер в куче
+        fill(wide, 10, 7);
+        SmallVector<Counted, 2> narrow(std::move(wide));
+        CHECK(!narrow.is_small() && items(narrow) == range(10, 7) && wide.empty());
+        SmallVector<Counted, 8> wider(std::move(narrow));
+        CHECK(items(wider) == range(10, 7) && narrow.is_small());
+
+        // Присваивания перемещением
+        SmallVector<Counted, 4> target;
+        fill(target, 50, 9);
+        SmallVector<Counted, 4> source;
+        fill(source, 0, 2);
+        target = std::move(source);
+        CHECK(target.is_small() && items(target) == range(0, 2) && source.empty());
+        fresh = std::move(target);
+        CHECK(items(fresh) == range(0, 2) && target.empty() && target.is_small());
+        fill(target, 7, 1);
+        CHECK(Counted::alive == static_cast<int>(fresh.size() + back.size() + wider.size() + target.size()));
+    }
+    CHECK(Counted::alive == 0);
+}
+
+// Копия бросает, когда бюджет копий исчерпан; перемещение не noexcept,
+// поэтому из встроенного буфера элементы уходят копией
+struct Fragile {
+    static inline int alive = 0;
+    static inline int budget = -1;
+
+    std::string value;
+
+    Fragile(std::string v) : value(std::move(v)) { ++alive; }
+    Fragile(const Fragile& other) : value((spend(), other.value)) { ++alive; }
+    Fragile(Fragile&& other) : value(std::move(other.value)) { ++alive; }
+    Fragile& operator=(const Fragile&) = default;
+    Fragile& operator=(Fragile&&) = default;
+    ~Fragile() { --alive; }
+
+    static void spend() {
+        if (budget == 0) throw std::runtime_error("copy budget exhausted");
+        if (budget > 0) --budget;
+    }
+};
+
+// SmallVector, побывавший в куче и вернувшийся во встроенный буфер, через
+// SimpleVector&: элементы переезжают в новый буфер, источник остаётся
+// пустым во встроенном
+void movesThroughBase() {
+    {
+        SmallVector<Counted, 4> v;
+        fill(v, 0, 10);
+        v.erase(3, v.size());
+        v.shrink_to_fit();
+        CHECK(v.is_small());
+        SimpleVector<Counted>& base = v;
+
+        SimpleVector<Counted> moved(std::move(base));
+        CHECK(items(moved) == range(0, 3) && v.empty() && v.is_small());
+
+        fill(v, 5, 2);
+        SimpleVector<Counted> target;
+        fill(target, 100, 7);
+        target = std::move(base);
+        CHECK(items(target) == range(5, 2) && v.empty() && v.is_small());
+
+        // В SmallVector другого N: в меньший — через кучу, в больший — во встроенный
+        fill(v, 0, 4);
+        SmallVector<Counted, 2> narrow(std::move(base));
+        CHECK(!narrow.is_small() && items(narrow) == range(0, 4) && v.empty());
+        fill(v, 0, 2);
+        SmallVector<Counted, 8> wide(std::move(base));
+        CHECK(wide.is_small() && items(wide) == range(0, 2) && v.empty());
+        CHECK(Counted::alive == 11);
+    }
+    CHECK(Counted::alive == 0);
+
+    // Исключение при переносе выходит наружу, источник не меняется
+    {
+        SmallVector<Fragile, 4> v;
+        fill(v, 0, 6);
+        v.erase(3, v.size());
+        v.shrink_to_fit();
+        SimpleVector<Fragile>& base = v;
+
+        Fragile::budget = 1;
+        CHECK_THROWS(SimpleVector<Fragile>(std::move(base)), std::runtime_error);
+        CHECK(v.is_small() && items(v) == range(0, 3) && Fragile::alive == 3);
+        SimpleVector<Fragile> target;
+        Fragile::budget = 2;
+        CHECK_THROWS(target = std::move(base), std::runtime_error);
+        CHECK(items(v) == range(0, 3) && target.empty() && Fragile::alive == 3);
+
+        Fragile::budget = -1;
+        SimpleVector<Fragile> moved(std::move(base));
+        CHECK(items(moved) == range(0, 3) && v.empty() && Fragile::alive == 3);
+    }
+    CHECK(Fragile::alive == 0);
+}
+
+void swaps() {
+    {
+        SmallVector<Counted, 4> a;
+        SmallVector<Counted, 4> b;
+        SimpleVector<Counted> c;
+        fill(a, 0, 2);
+        fill(b, 10, 9);
+        fill(c, 20, 3);
+
+        // Встроенный и куча: элементы обмениваются поштучно
+        a.swap(b);
+        CHECK(items(a) == range(10, 9) && items(b) == range(0, 2));
+
+        // Две кучи: меняются указатели, признак встроенного буфера остаётся у
+        // своего вектора, и a по-прежнему может вернуться во встроенный буфер
+        b.push_back(Counted("2"));
+        b.push_back(Counted("3"));
+        b.push_back(Counted("4"));
+        CHECK(!a.is_small() && !b.is_small());
+        c.swap(a);
+        CHECK(items(c) == range(10, 9) && items(a) == range(20, 3));
+        a.swap(b);
+        CHECK(items(a) == range(0, 5) && items(b) == range(20, 3));
+        b.erase(1, b.size());
+        b.shrink_to_fit();
+        CHECK(b.is_small() && b.capacity() == 4 && items(b) == range(20, 1));
+        c.shrink_to_fit();
+        CHECK(c.capacity() == 9);
+
+        // Через SimpleVector&
+        c.swap(b);
+        CHECK(items(c) == range(20, 1) && items(b) == range(10, 9));
+        c.swap(c);
+        CHECK(items(c) == range(20, 1));
+
+        // swap через ADL: у SmallVector поштучный, у SimpleVector — указателями
+        using std::swap;
+        swap(a, b);
+        CHECK(items(a) == range(10, 9) && items(b) == range(0, 5));
+        SimpleVector<Counted> d;
+        fill(d, 30, 2);
+        const Counted* heap = d.data();
+        swap(c, d);
+        CHECK(c.data() == heap && items(c) == range(30, 2) && items(d) == range(20, 1));
+    }
+    CHECK(Counted::alive == 0);
+}
+
+void registerAll() {
+    test::registerTest("SmallVector/layout", layout);
+    test::registerTest("SmallVector/inline_and_heap", inlineAndHeap);
+    test::registerTest("SmallVector/moves", moves);
+    test::registerTest("SmallVector/moves_through_base", movesThroughBase);
+    test::registerTest("SmallVector/swaps", swaps);
+}
+
+TEST_REGISTRATION(registerAll);
+
+} // namespace
@@ -0,0 +1,247 @@
+// SoAVector: emplace_back с аргументами из самого вектора во время
+// переаллокации, insert/erase и исключения без рассинхронизации столбцов,
+// приведение iterator → const_iterator и структурные привязки к v[i]
+
+#include "testing.h"
+
+#include "soaVector.h"
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+using Rows = SoAVector<int, std::string, double>;
+using Model = std::vector<std::tuple<int, std::string, double>>;
+
+bool equals(const Rows& v, const Model& model) {
+    if (v.size() != model.size()) return false;
+    if (v.column<0>().size() != v.size() || v.column<1>().size() != v.size() || v.column<2>().size() != v.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < model.size(); ++i) {
+        if (Model::value_type(v[i]) != model[i]) return false;
+    }
+    return std::equal(v.begin(), v.end(), model.begin(), model.end(),
+                      [](Rows::const_reference a, const Model::value_type& b) { return Model::value_type(a) == b; });
+}
+
+// Аргументы — ссылки на поля самого вектора; на заполненном векторе
+// emplace_back переаллоцирует столбцы, пока аргументы ещё нужны
+void emplaceAliasing() {
+    Rows v;
+    Model model;
+    v.emplace_back(1, std::string(40, 'a'), 0.5);
+    model.emplace_back(1, std::string(40, 'a'), 0.5);
+
+    std::mt19937 rng(7);
+    int reallocations = 0;
+    for (int step = 0; step < 2000; ++step) {
+        const std::size_t a = rng() % v.size();
+        const std::size_t b = rng() % v.size();
+        const std::size_t c = rng() % v.size();
+        const bool full = v.size() == v.capacity();
+        reallocations += full;
+
+        const Model::value_type expect(std::get<0>(model[a]), std::get<1>(model[b]), std::get<2>(model[c]));
+        auto [id, name, price] = v.emplace_back(std::get<0>(v[a]), std::get<1>(v[b]), std::get<2>(v[c]));
+        model.push_back(expect);
+        CHECK(id == std::get<0>(expect) && name == std::get<1>(expect) && price == std::get<2>(expect));
+
+        std::get<0>(model.back()) += step;
+        id += step;
+        std::get<1>(model.back()) += char('a' + step % 26);
+        name += char('a' + step % 26);
+    }
+    CHECK(reallocations > 5);
+    CHECK(equals(v, model));
+
+    // Кортеж-строка из самого вектора целиком
+    Rows w{{1, "x", 1.0}};
+    for (int i = 0; i < 100; ++i) w.push_back(Model::value_type(w[w.size() - 1]));
+    CHECK(w.size() == 101 && std::get<1>(w[100]) == "x");
+    for (int i = 0; i < 100; ++i) w.push_back(w[0]);
+    CHECK(w.size() == 201 && std::get<1>(w[0]) == "x" && std::get<1>(w[200]) == "x");
+}
+
+void insertErase() {
+    std::mt19937 rng(11);
+    Rows v;
+    Model model;
+    for (int step = 0; step < 5000; ++step) {
+        const std::size_t pos = rng() % (model.size() + 1);
+        const int x = static_cast<int>(rng() % 1000);
+        switch (rng() % 6) {
+        case 0: case 1: {
+            Model::value_type row(x, std::to_string(x) + std::string(x % 30, 'z'), x * 0.5);
+            v.insert(pos, row);
+            model.insert(model.begin() + static_cast<std::ptrdiff_t>(pos), row);
+            break;
+        }
+        case 2:
+            v.emplace_back(x, std::to_string(x), -x * 0.25);
+            model.emplace_back(x, std::to_string(x), -x * 0.25);
+            break;
+        case 3:
+            if (pos < model.size()) {
+                v.erase(pos);
+                model.erase(model.begin() + static_cast<std::ptrdiff_t>(pos));
+            }
+            break;
+        case 4: {
+            const std::size_t last = std::min(model.size(), pos + rng() % 5);
+            v.erase(pos, last);
+            model.erase(model.begin() + static_cast<std::ptrdiff_t>(pos),
+                        model.begin() + static_cast<std::ptrdiff_t>(last));
+            break;
+        }
+        default:
+            if (pos < model.size()) {
+                std::get<2>(v[pos]) = x;
+                std::get<2>(model[pos]) = x;
+            }
+        }
+        if (step % 250 == 0) CHECK(equals(v, model));
+    }
+    CHECK(equals(v, model));
+
+    CHECK_THROWS(v.insert(v.size() + 1, Model::value_type()), std::out_of_range);
+    CHECK_THROWS(v.erase(v.size()), std::out_of_range);
+    CHECK_THROWS(v.erase(1, 0), std::out_of_range);
+    CHECK_THROWS(v.erase(0, v.size() + 1), std::out_of_range);
+    CHECK_THROWS(v.at(v.size()), std::out_of_range);
+    CHECK(equals(v, model));
+
+    v.erase(0, v.size());
+    CHECK(v.empty() && v.column<1>().empty() && v.begin() == v.end());
+}
+
+// Поле, копирование и перемещение которого бросает по команде
+struct Fragile {
+    static inline int countdown = -1;
+
+    int value = 0;
+
+    Fragile(int v) : value(v) {}
+    Fragile(const Fragile& other) : value(other.value) { tick(); }
+    Fragile(Fragile&& other) : value(other.value) { tick(); }
+    Fragile& operator=(const Fragile&) = default;
+    Fragile& operator=(Fragile&&) = default;
+
+    static void tick() {
+        if (countdown >= 0 && countdown-- == 0) throw std::runtime_error("Fragile");
+    }
+};
+
+// Конструктор поля после первого бросил — уже добавленные поля строки
+// убираются, столбцы остаются одной длины
+void exceptionsKeepColumnsInSync() {
+    SoAVector<int, Fragile, std::string> v;
+    v.reserve(8);
+    for (int i = 0; i < 4; ++i) v.emplace_back(i, Fragile(i), std::to_string(i));
+
+    auto same = [&v]() {
+        if (v.size() != 4 || v.column<1>().size() != 4 || v.column<2>().size() != 4) return false;
+        for (int i = 0; i < 4; ++i) {
+            if (std::get<0>(v[i]) != i || std::get<1>(v[i]).value != i || std::get<2>(v[i]) != std::to_string(i)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    const Fragile bad(99);
+    Fragile::countdown = 0;
+    CHECK_THROWS(v.emplace_back(9, bad, "nine"), std::runtime_error);
+    CHECK(same());
+
+    const std::tuple<int, Fragile, std::string> row(9, Fragile(99), "nine");
+    Fragile::countdown = 1;
+    CHECK_THROWS(v.insert(2, row), std::runtime_error);
+    Fragile::countdown = 1;
+    CHECK_THROWS(v.insert(0, std::tuple<int, Fragile, std::string>(9, Fragile(99), "nine")), std::runtime_error);
+    Fragile::countdown = -1;
+    CHECK(same());
+
+    v.emplace_back(4, bad, "4");
+    CHECK(v.size() == 5 && std::get<1>(v[4]).value == 99);
+}
+
+void iterators() {
+    Rows v{{1, "one", 1.5}, {2, "two", 2.5}, {3, "three", 3.5}};
+
+    static_assert(std::is_convertible_v<Rows::iterator, Rows::const_iterator>);
+    static_assert(!std::is_convertible_v<Rows::const_iterator, Rows::iterator>);
+    static_assert(std::is_same_v<std::iterator_traits<Rows::iterator>::iterator_category,
+                                 std::random_access_iterator_tag>);
+
+    Rows::const_iterator it = v.begin();
+    CHECK(it == v.cbegin() && v.begin() == it);
+    Rows::const_iterator last = v.end() - 1;
+    CHECK(last != v.end() && v.end() != last && std::get<1>(*last) == "three");
+    CHECK(v.end() - it == 3 && it - v.end() == -3 && last - v.begin() == 2);
+    CHECK(it < v.end() && v.begin() < last && v.end() > it && v.end() >= last && it <= v.begin());
+
+    const Rows& cv = v;
+    Rows::const_iterator found = std::find_if(cv.begin(), cv.end(), [](Rows::const_reference row) {
+        return std::get<1>(row) == "two";
+    });
+    CHECK(found - cv.begin() == 1 && std::get<2>(found[1]) == 3.5);
+
+    // Изменение через итератор видно в столбцах
+    for (Rows::iterator row = v.begin(); row != v.end(); ++row) std::get<0>(*row) *= 10;
+    CHECK(v.column<0>()[0] == 10 && v.column<0>()[2] == 30);
+
+    int sum = 0;
+    for (auto row = v.cend(); row != v.cbegin();) sum += std::get<0>(*--row);
+    CHECK(sum == 60 && std::distance(v.cbegin(), v.cend()) == 3);
+
+    Rows::const_iterator empty;
+    CHECK(empty == Rows::const_iterator());
+}
+
+void structuredBindings() {
+    Rows v{{1, "one", 1.5}, {2, "two", 2.5}};
+
+    // Привязки — ссылки на элементы столбцов
+    auto [id, name, price] = v[1];
+    id = 20;
+    name += "!";
+    price *= 2;
+    CHECK(v.column<0>()[1] == 20 && std::get<1>(v[1]) == "two!" && v.data<2>()[1] == 5.0);
+
+    for (auto [i, n, p] : v) {
+        i += 100;
+        p = static_cast<double>(n.size());
+    }
+    CHECK(std::get<0>(v[0]) == 101 && std::get<0>(v[1]) == 120 && std::get<2>(v[0]) == 3.0);
+
+    const Rows& cv = v;
+    auto [cid, cname, cprice] = cv[0];
+    static_assert(std::is_same_v<decltype(cid), const int&>);
+    static_assert(std::is_same_v<decltype(cname), const std::string&>);
+    CHECK(cid == 101 && cname == "one" && cprice == 3.0);
+
+    // Копия строки не связана с вектором
+    std::tuple<int, std::string, double> copy = v[0];
+    std::get<1>(copy) = "changed";
+    CHECK(std::get<1>(v[0]) == "one");
+}
+
+void registerAll() {
+    test::registerTest("SoAVector/emplace_aliasing", emplaceAliasing);
+    test::registerTest("SoAVector/insert_erase", insertErase);
+    test::registerTest("SoAVector/exceptions_keep_columns_in_sync", exceptionsKeepColumnsInSync);
+    test::registerTest("SoAVector/iterators", iterators);
+    test::registerTest("SoAVector/structured_bindings", structuredBindings);
+}
+
+TEST_REGISTRATION(registerAll);
+
+} // namespace
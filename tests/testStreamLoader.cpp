@@ -0,0 +1,272 @@
+// Потоковая загрузка (streamLoader.h): text::print → ingest::load_text для
+// разных контейнеров и разделителей, load_records прямо в буфер вектора и в
+// списки, и смещение parse_error для плохого текста, переполнения и
+// обрезанной записи
+
+#include "testing.h"
+
+#include "doublyLinkedList.h"
+#include "nodePool.h"
+#include "simpleVector.h"
+#include "singlyLinkedList.h"
+#include "streamLoader.h"
+#include "textFormat.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Временный файл; удаляется вместе с объектом
+class TempFile {
+public:
+    explicit TempFile(const std::string& name)
+        : path_((std::filesystem::temp_directory_path() / ("lab3_tests_" + name)).string()) {}
+    ~TempFile() { std::remove(path_.c_str()); }
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+
+    const std::string& path() const noexcept { return path_; }
+
+    void write(const std::string& bytes) const {
+        std::ofstream os(path_, std::ios::binary | std::ios::trunc);
+        os.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    template<typename Container>
+    void print(const Container& c, const text::Format& format = {}) const {
+        std::ofstream os(path_, std::ios::binary | std::ios::trunc);
+        text::print(c, os, format);
+    }
+
+private:
+    std::string path_;
+};
+
+template<typename Container>
+std::vector<typename Container::value_type> items(const Container& c) {
+    return std::vector<typename Container::value_type>(c.begin(), c.end());
+}
+
+template<typename T>
+std::string bytesOf(const std::vector<T>& values) {
+    return std::string(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+// Смещение parse_error при загрузке текста; -1 — ошибки не было
+template<typename T>
+std::int64_t failsAt(const std::string& content, std::vector<T>* loaded = nullptr) {
+    TempFile file("parse_error.txt");
+    file.write(content);
+    SimpleVector<T> v;
+    try {
+        ingest::load_text(v, file.path());
+    } catch (const ingest::parse_error& e) {
+        if (loaded) *loaded = items(v);
+        return static_cast<std::int64_t>(e.offset());
+    }
+    return -1;
+}
+
+// Числа уходят через text::print и возвращаются load_text тем же значением,
+// в том числе через границы блоков чтения по 1 МБ
+template<typename List>
+bool roundTrip(const std::vector<typename List::value_type>& values, const text::Format& format) {
+    TempFile file("round_trip.txt");
+    file.print(values, format);
+    List loaded;
+    loaded.push_back(typename List::value_type(7));
+    const std::uint64_t count = ingest::load_text(loaded, file.path());
+    std::vector<typename List::value_type> expect{typename List::value_type(7)};
+    expect.insert(expect.end(), values.begin(), values.end());
+    return count == values.size() && items(loaded) == expect && loaded.size() == expect.size();
+}
+
+template<typename T>
+std::vector<T> randomValues(std::size_t n, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<T> values;
+    for (std::size_t i = 0; i < n; ++i) {
+        if constexpr (std::is_floating_point_v<T>) {
+            // Случайные мантиссы и порядки, без бесконечностей и NaN
+            const double m = static_cast<double>(rng() % 100000000) / 7919.0;
+            const int e = static_cast<int>(rng() % 60) - 30;
+            values.push_back(static_cast<T>((rng() % 2 ? -m : m) * std::pow(10.0, e)));
+        } else {
+            values.push_back(static_cast<T>(rng()));
+        }
+    }
+    values.push_back(std::numeric_limits<T>::max());
+    values.push_back(std::numeric_limits<T>::lowest());
+    return values;
+}
+
+void textRoundTrip() {
+    const text::Format formats[] = {{" ", ""}, {", ", "\n"}, {";", ";"}, {"\n", "\n"}, {"\t\r\n", ""}};
+    const auto ints = randomValues<int>(300000, 1);
+    const auto longs = randomValues<std::int64_t>(20000, 2);
+    const auto doubles = randomValues<double>(150000, 3);
+    const auto floats = randomValues<float>(20000, 4);
+    for (const auto& format : formats) {
+        CHECK(roundTrip<SimpleVector<int>>(ints, format));
+        CHECK(roundTrip<SinglyLinkedList<std::int64_t>>(longs, format));
+        CHECK(roundTrip<SimpleVector<double>>(doubles, format));
+        CHECK((roundTrip<DoublyLinkedList<double, PoolAllocator<double>>>(doubles, format)));
+        CHECK(roundTrip<DoublyLinkedList<float>>(floats, format));
+    }
+
+    // Пустой файл и файл из одних разделителей
+    CHECK(roundTrip<SimpleVector<int>>({}, {" ", "\n"}));
+    TempFile blank("blank.txt");
+    blank.write(" \n,;\t  \n");
+    SimpleVector<int> v{1};
+    CHECK(ingest::load_text(v, blank.path()) == 0 && items(v) == (std::vector<int>{1}));
+
+    // Число без завершающего разделителя в конце файла
+    blank.write("1,2,-3");
+    CHECK(ingest::load_text(v, blank.path()) == 3 && items(v) == (std::vector<int>{1, 1, 2, -3}));
+}
+
+void records() {
+    std::vector<std::int32_t> values;
+    for (std::int32_t i = 0; i < 700000; ++i) values.push_back(i * 31 - 1000);
+    TempFile file("records.bin");
+    file.write(bytesOf(values));
+
+    // Вектор читает записи прямо в свой буфер: одно выделение точно под файл
+    SimpleVector<std::int32_t> v;
+    CHECK(ingest::load_records(v, file.path()) == values.size());
+    CHECK(items(v) == values && v.capacity() == values.size());
+
+    // Дописываются после уже имеющихся элементов
+    SimpleVector<std::int32_t> prefixed{-1, -2};
+    CHECK(ingest::load_records(prefixed, file.path()) == values.size());
+    std::vector<std::int32_t> expect{-1, -2};
+    expect.insert(expect.end(), values.begin(), values.end());
+    CHECK(items(prefixed) == expect);
+
+    SinglyLinkedList<std::int32_t> singly;
+    CHECK(ingest::load_records(singly, file.path()) == values.size());
+    CHECK(items(singly) == values && singly.size() == values.size());
+    DoublyLinkedList<std::int32_t, PoolAllocator<std::int32_t>> pooled{-1, -2};
+    CHECK(ingest::load_records(pooled, file.path()) == values.size());
+    CHECK(items(pooled) == expect);
+
+    // Составной тривиально копируемый тип
+    struct Point {
+        std::int32_t x;
+        float y;
+        bool operator==(const Point& o) const { return x == o.x && y == o.y; }
+    };
+    const std::vector<Point> points{{1, 0.5f}, {-2, 1e30f}, {3, -4.25f}};
+    file.write(bytesOf(points));
+    SimpleVector<Point> loaded;
+    CHECK(ingest::load_records(loaded, file.path()) == 3 && items(loaded) == points);
+
+    // Пустой файл
+    file.write("");
+    CHECK(ingest::load_records(v, file.path()) == 0 && v.size() == values.size());
+
+#if defined(__unix__) || defined(__APPLE__)
+    // У канала нет длины: вектор заполняется без пре-аллокации
+    int fds[2];
+    CHECK(::pipe(fds) == 0);
+    const std::vector<std::int32_t> few{5, 6, 7, 8};
+    const std::string bytes = bytesOf(few);
+    CHECK(::write(fds[1], bytes.data(), bytes.size()) == static_cast<::ssize_t>(bytes.size()));
+    ::close(fds[1]);
+    SimpleVector<std::int32_t> piped{4};
+    CHECK(ingest::load_records(piped, fds[0]) == 4);
+    ::close(fds[0]);
+    CHECK(items(piped) == (std::vector<std::int32_t>{4, 5, 6, 7, 8}));
+#endif
+}
+
+void parseErrors() {
+    std::vector<int> loaded;
+    CHECK(failsAt<int>("1 2 abc 4", &loaded) == 4);
+    CHECK(loaded == (std::vector<int>{1, 2}));
+    CHECK(failsAt<int>("10, 20,30x", &loaded) == 7);
+    CHECK(loaded == (std::vector<int>{10, 20}));
+    CHECK(failsAt<int>("1 +2") == 2);
+    CHECK(failsAt<int>("1 2.5") == 2);
+    CHECK(failsAt<int>("  -") == 2);
+    CHECK(failsAt<unsigned>("5\n-1") == 2);
+    CHECK(failsAt<double>("0.5 1e-3 nan? 2") == 9);
+    CHECK(failsAt<int>("1 2 3 \n") == -1);
+
+    // Переполнение типа
+    CHECK(failsAt<std::int8_t>("100 -128 127 128") == 13);
+    CHECK(failsAt<std::uint16_t>("65535 65536") == 6);
+    CHECK(failsAt<int>("1 99999999999") == 2);
+    CHECK(failsAt<double>("1e308 1e309") == 6);
+
+    TempFile range("range.txt");
+    range.write("5 300");
+    SimpleVector<std::int8_t> small;
+    try {
+        ingest::load_text(small, range.path());
+        CHECK(false);
+    } catch (const ingest::parse_error& e) {
+        CHECK(e.offset() == 2 && std::string(e.what()).find("out of range") != std::string::npos);
+    }
+
+    // Ошибка далеко за первым блоком чтения: смещение от начала файла
+    std::string big;
+    std::size_t count = 0;
+    while (big.size() < 3 * ingest::read_chunk + 12345) {
+        big += std::to_string(count++ * 7);
+        big += count % 10 ? ' ' : '\n';
+    }
+    const std::size_t bad = big.size();
+    CHECK(failsAt<int>(big + "12;oops 3", &loaded) == static_cast<std::int64_t>(bad + 3));
+    CHECK(loaded.size() == count + 1);
+
+    // Обрезанная последняя запись: прочитанные записи остаются
+    std::vector<std::int32_t> values{1, 2, 3, 4, 5};
+    TempFile file("truncated.bin");
+    file.write(bytesOf(values) + "\x01\x02");
+    SimpleVector<std::int32_t> v{0};
+    try {
+        ingest::load_records(v, file.path());
+        CHECK(false);
+    } catch (const ingest::parse_error& e) {
+        CHECK(e.offset() == 5 * sizeof(std::int32_t));
+    }
+    CHECK(items(v) == (std::vector<std::int32_t>{0, 1, 2, 3, 4, 5}));
+
+    SinglyLinkedList<std::int32_t> singly;
+    try {
+        ingest::load_records(singly, file.path());
+        CHECK(false);
+    } catch (const ingest::parse_error& e) {
+        CHECK(e.offset() == 5 * sizeof(std::int32_t));
+    }
+    CHECK(items(singly) == values);
+
+    // Файла нет
+    CHECK_THROWS(ingest::load_text(v, file.path() + ".missing"), std::system_error);
+    CHECK_THROWS(ingest::load_records(v, file.path() + ".missing"), std::system_error);
+}
+
+void registerAll() {
+    test::registerTest("StreamLoader/text_round_trip", textRoundTrip);
+    test::registerTest("StreamLoader/records", records);
+    test::registerTest("StreamLoader/parse_errors", parseErrors);
+}
+
+TEST_REGISTRATION(registerAll);
+
+} // namespace
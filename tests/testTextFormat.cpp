@@ -0,0 +1,246 @@
+// Текстовый вывод (textFormat.h): целые как operator<<, дробные кратчайшим
+// точным представлением или с заданной точностью, свои разделители, все
+// приёмники и строки длиннее буфера
+
+#include "testing.h"
+
+#include "doublyLinkedList.h"
+#include "simpleVector.h"
+#include "singlyLinkedList.h"
+#include "textFormat.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace {
+
+template<typename Container>
+std::string printed(const Container& c, const text::Format& format = {}) {
+    std::ostringstream os;
+    text::print(c, os, format);
+    return os.str();
+}
+
+// Вывод operator<< без флагов потока через разделитель
+template<typename Container>
+std::string streamed(const Container& c) {
+    std::ostringstream os;
+    bool first = true;
+    for (const auto& x : c) {
+        if (!first) os << ' ';
+        os << x;
+        first = false;
+    }
+    return os.str();
+}
+
+std::vector<std::string> tokens(const std::string& s) {
+    std::vector<std::string> out;
+    std::istringstream is(s);
+    for (std::string t; is >> t;) out.push_back(t);
+    return out;
+}
+
+// Каждое число читается обратно в то же значение и записано так же, как
+// кратчайшее представление std::to_chars
+template<typename T>
+bool shortestExact(const std::vector<T>& values) {
+    const std::vector<std::string> words = tokens(printed(values));
+    if (words.size() != values.size()) return false;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        const std::string& w = words[i];
+        T back{};
+        const auto result = std::from_chars(w.data(), w.data() + w.size(), back);
+        if (result.ec != std::errc() || result.ptr != w.data() + w.size()) return false;
+        if (back != values[i] || std::signbit(back) != std::signbit(values[i])) return false;
+
+        char expect[128];
+        const auto shortest = std::to_chars(expect, expect + sizeof expect, values[i]);
+        if (w != std::string(expect, shortest.ptr)) return false;
+    }
+    return true;
+}
+
+struct Point {
+    int x;
+    int y;
+};
+
+std::ostream& operator<<(std::ostream& os, const Point& p) {
+    return os << '(' << p.x << ';' << p.y << ')';
+}
+
+void integers() {
+    SimpleVector<int> v{0, -1, 42, std::numeric_limits<int>::min(), std::numeric_limits<int>::max()};
+    CHECK(printed(v) == streamed(v));
+    CHECK(printed(v) == "0 -1 42 -2147483648 2147483647");
+
+    SimpleVector<std::uint64_t> big{0, std::numeric_limits<std::uint64_t>::max()};
+    CHECK(printed(big) == streamed(big));
+    SimpleVector<std::int64_t> small{std::numeric_limits<std::int64_t>::min(), -7};
+    CHECK(printed(small) == streamed(small));
+    SimpleVector<unsigned short> shorts{65535, 1};
+    CHECK(printed(shorts) == "65535 1");
+
+    // char — символом, bool — 0/1, строки как есть
+    SimpleVector<char> chars{'a', 'b', 'c'};
+    CHECK(printed(chars, {"", "!"}) == "abc!");
+    SimpleVector<bool> flags{true, false, true};
+    CHECK(printed(flags, {","}) == "1,0,1");
+    DoublyLinkedList<std::string> words{"one", "", "three"};
+    CHECK(printed(words, {"|", "\n"}) == "one||three\n");
+
+    // Прочие типы — через operator<<
+    SinglyLinkedList<Point> points{{1, 2}, {-3, 4}};
+    CHECK(printed(points) == "(1;2) (-3;4)");
+
+    // Пустой контейнер — только завершающая строка
+    const SimpleVector<int> empty;
+    CHECK(printed(empty).empty());
+    CHECK(printed(empty, {", ", "\n"}) == "\n");
+}
+
+void floating() {
+    SimpleVector<double> v{0.1, 1.0 / 3, 1e300, -0.0, 5e-324, 123456789.0, 2.5};
+    CHECK(printed(v) == "0.1 0.3333333333333333 1e+300 -0 5e-324 123456789 2.5");
+    SimpleVector<float> f{0.1f, 1.0f / 3, 16777216.0f};
+    CHECK(printed(f) == "0.1 0.33333334 16777216");
+
+    std::mt19937_64 rng(11);
+    std::vector<double> doubles;
+    std::vector<float> floats;
+    for (int i = 0; i < 20000; ++i) {
+        std::uint64_t bits = rng();
+        double d;
+        std::memcpy(&d, &bits, sizeof d);
+        if (std::isfinite(d)) doubles.push_back(d);
+        doubles.push_back(static_cast<double>(static_cast<std::int64_t>(rng() % 2000001) - 1000000) / 1000);
+        const auto fbits = static_cast<std::uint32_t>(rng());
+        float x;
+        std::memcpy(&x, &fbits, sizeof x);
+        if (std::isfinite(x)) floats.push_back(x);
+    }
+    CHECK(shortestExact(doubles));
+    CHECK(shortestExact(floats));
+    CHECK(shortestExact(std::vector<long double>{0.1L, 1.0L / 3, 1e4000L, -2.5L}));
+
+    // Бесконечности и NaN
+    SimpleVector<double> special{std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+                                 std::numeric_limits<double>::quiet_NaN()};
+    CHECK(printed(special) == "inf -inf nan");
+
+    // Явная точность — как operator<< с setprecision
+    SimpleVector<double> pi{3.14159265358979, 1234567.0, 0.000012345};
+    CHECK(printed(pi, {" ", "", 3}) == "3.14 1.23e+06 1.23e-05");
+    std::ostringstream os;
+    os.precision(17);
+    os << pi[0];
+    CHECK(printed(SimpleVector<double>{pi[0]}, {" ", "", 17}) == os.str());
+    CHECK(printed(SimpleVector<double>{1.0}, {" ", "", 1000}) == "1");
+}
+
+// Разделители любой длины и несколько диапазонов в одном буфере
+void separators() {
+    SimpleVector<int> v;
+    for (int i = 0; i < 5; ++i) v.push_back(i);
+    CHECK(printed(v, {", ", "\n"}) == "0, 1, 2, 3, 4\n");
+    CHECK(printed(v, {"", ""}) == "01234");
+    CHECK(printed(v, {" -> ", " <end>"}) == "0 -> 1 -> 2 -> 3 -> 4 <end>");
+
+    std::ostringstream os;
+    {
+        text::BufferedWriter<text::StreamSink> out{text::StreamSink(os)};
+        text::write_range(out, v.begin(), v.end(), {",", ";"});
+        text::write_range(out, v.begin() + 3, v.end());
+        // Деструктор сбрасывает остаток
+    }
+    CHECK(os.str() == "0,1,2,3,4;3 4");
+}
+
+// Вывод больше буфера: блоки по capacity и строки, которые не помещаются
+// в буфер целиком
+void largeOutput() {
+    SimpleVector<int> v;
+    std::string expect;
+    for (int i = 0; i < 200000; ++i) {
+        v.push_back(i * 7919 - 500000);
+        if (i > 0) expect += ' ';
+        expect += std::to_string(i * 7919 - 500000);
+    }
+    CHECK(printed(v) == expect);
+
+    std::ostringstream os;
+    {
+        text::BufferedWriter<text::StreamSink> out(text::StreamSink(os), 0);
+        text::write_range(out, v.begin(), v.end());
+        CHECK(out.flush() && out.ok());
+    }
+    CHECK(os.str() == expect);
+
+    SimpleVector<std::string> words{"x", std::string(300, 'a'), "y", std::string(1 << 17, 'b'), "z"};
+    std::ostringstream small;
+    {
+        text::BufferedWriter<text::StreamSink> out(text::StreamSink(small), 256);
+        text::write_range(out, words.begin(), words.end(), {"/"});
+    }
+    CHECK(small.str() == "x/" + words[1] + "/y/" + words[3] + "/z");
+}
+
+// FILE* и дескриптор; ошибка записи видна в результате
+void sinks() {
+    SimpleVector<double> v{1.5, -2.25, 1e-7};
+
+    std::FILE* file = std::tmpfile();
+    CHECK(file != nullptr);
+    if (file) {
+        CHECK(text::print(v, file, {", ", "\n"}));
+        std::rewind(file);
+        char line[64] = {};
+        CHECK(std::fgets(line, sizeof line, file) != nullptr);
+        CHECK(std::string(line) == "1.5, -2.25, 1e-07\n");
+        std::fclose(file);
+    }
+
+    std::ostringstream bad;
+    bad.setstate(std::ios::badbit);
+    CHECK(!text::print(v, bad));
+
+#if defined(__unix__) || defined(__APPLE__)
+    int fds[2];
+    CHECK(::pipe(fds) == 0);
+    CHECK(text::print_fd(v, fds[1], {" ", "\n"}));
+    ::close(fds[1]);
+    char buffer[64] = {};
+    const ::ssize_t got = ::read(fds[0], buffer, sizeof buffer - 1);
+    ::close(fds[0]);
+    CHECK(got > 0 && std::string(buffer) == "1.5 -2.25 1e-07\n");
+
+    // Закрытый дескриптор
+    CHECK(!text::print_fd(v, fds[1]));
+#endif
+}
+
+void registerAll() {
+    test::registerTest("TextFormat/integers", integers);
+    test::registerTest("TextFormat/floating", floating);
+    test::registerTest("TextFormat/separators", separators);
+    test::registerTest("TextFormat/large_output", largeOutput);
+    test::registerTest("TextFormat/sinks", sinks);
+}
+
+TEST_REGISTRATION(registerAll);
+
+} // namespace
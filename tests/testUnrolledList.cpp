@@ -0,0 +1,260 @@
+// UnrolledList: случайные push_front/push_back/insert/erase против std::deque
+// на мелких блоках, деление полного блока и слияние соседей ровно на
+// MERGE_LIMIT, обход итераторами через границы блоков в обе стороны,
+// копирование, перемещение и clear() с пулом узлов
+
+#include "testing.h"
+
+#include "nodePool.h"
+#include "unrolledList.h"
+
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Считает живые объекты: после clear() и разрушения списков их не остаётся
+struct Counted {
+    static inline int alive = 0;
+
+    int value;
+
+    Counted(int v) : value(v) { ++alive; }
+    Counted(const Counted& other) : value(other.value) { ++alive; }
+    Counted(Counted&& other) noexcept : value(other.value) { ++alive; }
+    Counted& operator=(const Counted&) = default;
+    Counted& operator=(Counted&&) = default;
+    ~Counted() { --alive; }
+
+    bool operator==(const Counted& other) const { return value == other.value; }
+};
+
+template<typename List>
+std::vector<int> items(const List& list) {
+    std::vector<int> out;
+    for (const auto& x : list) out.push_back(static_cast<int>(x));
+    return out;
+}
+
+template<typename Allocator>
+std::vector<int> items(const UnrolledList<Counted, 8, Allocator>& list) {
+    std::vector<int> out;
+    for (const auto& x : list) out.push_back(x.value);
+    return out;
+}
+
+std::vector<int> items(const std::deque<int>& model) {
+    return std::vector<int>(model.begin(), model.end());
+}
+
+// Число блоков: memory_usage учитывает блоки целиком, размер одного
+// узнаём по списку из одного элемента
+template<typename List>
+std::size_t blocks(const List& list) {
+    List single;
+    single.push_back(0);
+    return list.memory_usage().reserved / single.memory_usage().reserved;
+}
+
+template<typename List>
+void randomOperations() {
+    std::mt19937 rng(5);
+    List list;
+    std::deque<int> model;
+    for (int step = 0; step < 5000; ++step) {
+        const int x = static_cast<int>(rng() % 1000);
+        switch (rng() % 6) {
+        case 0:
+            list.push_front(x);
+            model.push_front(x);
+            break;
+        case 1:
+            list.push_back(x);
+            model.push_back(x);
+            break;
+        case 2:
+        case 3: {
+            const std::size_t pos = rng() % (model.size() + 1);
+            list.insert(pos, x);
+            model.insert(model.begin() + static_cast<std::ptrdiff_t>(pos), x);
+            break;
+        }
+        default:
+            if (model.empty()) break;
+            const std::size_t pos = rng() % model.size();
+            list.erase(pos);
+            model.erase(model.begin() + static_cast<std::ptrdiff_t>(pos));
+            break;
+        }
+        if (step % 500 == 0) CHECK(items(list) == items(model));
+    }
+    CHECK(items(list) == items(model) && list.size() == model.size());
+
+    bool indexed = true;
+    for (std::size_t i = 0; i < model.size(); ++i) indexed = indexed && list[i] == model[i];
+    CHECK(indexed);
+
+    // Опустошение в случайном порядке
+    while (!model.empty()) {
+        const std::size_t pos = rng() % model.size();
+        list.erase(pos);
+        model.erase(model.begin() + static_cast<std::ptrdiff_t>(pos));
+    }
+    CHECK(list.empty() && list.begin() == list.end() && list.memory_usage().reserved == 0);
+    CHECK_THROWS(list.erase(0), std::out_of_range);
+}
+
+void randomInts() {
+    randomOperations<UnrolledList<int, 8>>();
+}
+
+void randomCounted() {
+    randomOperations<UnrolledList<Counted, 8>>();
+    CHECK(Counted::alive == 0);
+}
+
+void randomPooled() {
+    randomOperations<UnrolledList<int, 8, PoolAllocator<int>>>();
+}
+
+// BlockSize 8: MERGE_LIMIT = 6
+void splitAndMerge() {
+    UnrolledList<int, 8> list;
+    std::deque<int> model;
+    for (int i = 0; i < 8; ++i) {
+        list.push_back(i);
+        model.push_back(i);
+    }
+    CHECK(blocks(list) == 1);
+
+    // Вставка в полный блок делит его пополам
+    list.insert(3, 100);
+    model.insert(model.begin() + 3, 100);
+    CHECK(blocks(list) == 2 && items(list) == items(model));
+
+    // Два блока на 7 элементов не сливаются, на 6 — сливаются
+    list.erase(0);
+    model.pop_front();
+    list.erase(7);
+    model.pop_back();
+    CHECK(list.size() == 7 && blocks(list) == 2 && items(list) == items(model));
+    list.erase(3);
+    model.erase(model.begin() + 3);
+    CHECK(list.size() == 6 && blocks(list) == 1 && items(list) == items(model));
+
+    // Слияние с предыдущим блоком, когда следующего нет: 8 + 4 элемента,
+    // первый блок худеет до 3, затем удаление из второго даёт 3 + 3
+    UnrolledList<int, 8> tail;
+    for (int i = 0; i < 12; ++i) tail.push_back(i);
+    for (int i = 0; i < 5; ++i) tail.erase(0);
+    CHECK(blocks(tail) == 2 && tail.size() == 7);
+    tail.erase(tail.size() - 1);
+    CHECK(blocks(tail) == 1 && items(tail) == (std::vector<int>{5, 6, 7, 8, 9, 10}));
+
+    // Пустой блок удаляется сразу
+    UnrolledList<int, 8> edges;
+    edges.push_back(1);
+    edges.push_front(0);
+    CHECK(blocks(edges) == 2);
+    edges.erase(0);
+    CHECK(blocks(edges) == 1 && items(edges) == (std::vector<int>{1}));
+}
+
+void iteratorsAcrossBlocks() {
+    UnrolledList<int, 8> list;
+    std::deque<int> model;
+    for (int i = 0; i < 30; ++i) {
+        list.push_back(i);
+        model.push_back(i);
+        list.push_front(-i);
+        model.push_front(-i);
+    }
+    for (int i = 0; i < 10; ++i) {
+        list.insert(static_cast<std::size_t>(i * 5), 1000 + i);
+        model.insert(model.begin() + i * 5, 1000 + i);
+    }
+    CHECK(blocks(list) > 5);
+
+    std::vector<int> forward;
+    for (auto it = list.begin(); it != list.end(); it++) forward.push_back(*it);
+    CHECK(forward == items(model));
+
+    std::vector<int> backward;
+    for (auto it = list.end(); it != list.begin();) backward.push_back(*--it);
+    CHECK(backward == std::vector<int>(model.rbegin(), model.rend()));
+
+    const auto& shared = list;
+    CHECK(std::vector<int>(shared.rbegin(), shared.rend()) == std::vector<int>(model.rbegin(), model.rend()));
+    CHECK(*std::prev(shared.end()) == model.back() && *std::next(shared.begin(), 40) == model[40]);
+
+    // Запись через итератор и постфиксный шаг назад
+    auto it = std::next(list.begin(), 20);
+    *it = -500;
+    model[20] = -500;
+    auto before = it--;
+    CHECK(*before == -500 && *it == model[19] && items(list) == items(model));
+
+    UnrolledList<int, 8> empty;
+    CHECK(empty.begin() == empty.end() && empty.cbegin() == empty.cend());
+}
+
+template<typename Allocator>
+void copyMoveClear() {
+    using List = UnrolledList<Counted, 8, Allocator>;
+    {
+        List list;
+        std::vector<int> model;
+        for (int i = 0; i < 40; ++i) {
+            list.push_back(i);
+            list.insert(list.size() / 2, 100 + i);
+            model.push_back(i);
+            model.insert(model.begin() + static_cast<std::ptrdiff_t>(model.size() / 2), 100 + i);
+        }
+
+        List copy(list);
+        CHECK(items(copy) == model && items(list) == model);
+        CHECK(Counted::alive == 160);
+
+        List moved(std::move(copy));
+        CHECK(items(moved) == model && copy.empty() && copy.begin() == copy.end());
+
+        List assigned;
+        assigned.push_back(-1);
+        assigned = list;
+        CHECK(items(assigned) == model);
+        assigned = std::move(moved);
+        CHECK(items(assigned) == model && moved.empty() && Counted::alive == 160);
+
+        // clear() освобождает блоки (с пулом — целиком) и уничтожает элементы
+        list.clear();
+        CHECK(list.empty() && list.memory_usage().reserved == 0 && Counted::alive == 80);
+        for (int i = 0; i < 20; ++i) list.push_front(i);
+        CHECK(list.size() == 20 && list[0].value == 19 && list[19].value == 0);
+        list.clear();
+        list.clear();
+        CHECK(list.empty() && Counted::alive == 80);
+
+        list.swap(assigned);
+        CHECK(items(list) == model && assigned.empty());
+    }
+    CHECK(Counted::alive == 0);
+}
+
+void registerAll() {
+    test::registerTest("UnrolledList/random_ints", randomInts);
+    test::registerTest("UnrolledList/random_counted", randomCounted);
+    test::registerTest("UnrolledList/random_pooled", randomPooled);
+    test::registerTest("UnrolledList/split_and_merge", splitAndMerge);
+    test::registerTest("UnrolledList/iterators_across_blocks", iteratorsAcrossBlocks);
+    test::registerTest("UnrolledList/copy_move_clear", copyMoveClear<std::allocator<Counted>>);
+    test::registerTest("UnrolledList/copy_move_clear_pooled", copyMoveClear<PoolAllocator<Counted>>);
+}
+
+TEST_REGISTRATION(registerAll);
+
+} // namespace
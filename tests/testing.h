@@ -0,0 +1,45 @@
+#ifndef TESTING_H
+#define TESTING_H
+
+// Минимальный каркас тестов: регистрация случаев при статической
+// инициализации, как в bench/benchmark.h, и проверки CHECK / CHECK_THROWS.
+// Проверки не зависят от NDEBUG и могут вызываться из нескольких потоков
+
+#include <functional>
+#include <string>
+
+namespace test {
+
+using Function = std::function<void()>;
+
+bool registerTest(std::string name, Function fn);
+
+// Отмечает проваленную проверку текущего случая
+void fail(const char* file, int line, const char* expression);
+
+int runMain(int argc, char** argv);
+
+} // namespace test
+
+#define TEST_CONCAT_IMPL(a, b) a##b
+#define TEST_CONCAT(a, b) TEST_CONCAT_IMPL(a, b)
+
+// Выполняет блок регистрации при статической инициализации единицы трансляции
+#define TEST_REGISTRATION(fn) \
+    [[maybe_unused]] static const bool TEST_CONCAT(test_registered_, __LINE__) = (fn(), true)
+
+#define CHECK(expr) ((expr) ? (void)0 : ::test::fail(__FILE__, __LINE__, #expr))
+
+// Выражение должно выбросить исключение типа exception
+#define CHECK_THROWS(expr, exception)                                              \
+    do {                                                                           \
+        bool test_thrown_ = false;                                                 \
+        try {                                                                      \
+            (void)(expr);                                                          \
+        } catch (const exception&) {                                               \
+            test_thrown_ = true;                                                   \
+        }                                                                          \
+        if (!test_thrown_) ::test::fail(__FILE__, __LINE__, #expr " throws " #exception); \
+    } while (false)
+
+#endif // TESTING_H
@@ -0,0 +1,278 @@
+#ifndef TEXT_FORMAT_H
+#define TEXT_FORMAT_H
+
+#include "checkPolicy.h"
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <io.h>
+#endif
+
+// Быстрый вывод элементов контейнера текстом. print() контейнеров пишет
+// каждый элемент через operator<< и отдельно разделитель — на каждом
+// элементе работают локаль, sentry потока и виртуальные вызовы streambuf.
+// Здесь числа форматируются std::to_chars прямо в буфер BufferedWriter,
+// а в приёмник (дескриптор, FILE* или ostream) уходят блоки по 64 КБ:
+//
+//     text::print(v, stdout);                          // как v.print(), через FILE*
+//     text::print_fd(v, 1, {", ", "\n"});              // write(2), свои разделители
+//
+//     text::BufferedWriter<text::FdSink> out(text::FdSink(fd));
+//     text::write_range(out, a.begin(), a.end());      // один буфер на несколько
+//     text::write_range(out, b.begin(), b.end());      // контейнеров
+//
+// Целые выводятся так же, как operator<< без флагов потока. Числа с
+// плавающей точкой по умолчанию — кратчайшим представлением, которое
+// читается обратно в то же значение (operator<< даёт 6 значащих цифр);
+// Format::precision задаёт число значащих цифр явно. char выводится
+// символом, bool — 0/1, строки — как есть; остальные типы — через
+// operator<< во вспомогательный поток (медленно, но работает)
+
+namespace text {
+
+// Разделитель между элементами и строка после последнего
+struct Format {
+    std::string_view separator = " ";
+    std::string_view terminator = "";
+    int precision = -1;  // значащих цифр для плавающей точки; -1 — кратчайшее точное
+};
+
+// Приёмники блоков. write возвращает false, если записать не удалось
+
+// Файловый дескриптор: write(2) без буфера libc, с дозаписью после
+// частичной записи и EINTR
+class FdSink {
+public:
+    explicit FdSink(int fd) noexcept : fd_(fd) {}
+
+    bool write(const char* data, std::size_t size) noexcept {
+        while (size > 0) {
+#if defined(__unix__) || defined(__APPLE__)
+            const ::ssize_t written = ::write(fd_, data, size);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+#elif defined(_WIN32)
+            const int chunk = static_cast<int>(std::min<std::size_t>(size, 1u << 30));
+            const int written = ::_write(fd_, data, static_cast<unsigned>(chunk));
+            if (written < 0) return false;
+#else
+            return false;
+#endif
+            data += written;
+            size -= static_cast<std::size_t>(written);
+        }
+        return true;
+    }
+
+private:
+    int fd_;
+};
+
+// Поток stdio. Блоки больше буфера FILE* libc пишет мимо него
+class FileSink {
+public:
+    explicit FileSink(std::FILE* file) noexcept : file_(file) {}
+
+    bool write(const char* data, std::size_t size) noexcept {
+        return std::fwrite(data, 1, size, file_) == size;
+    }
+
+private:
+    std::FILE* file_;
+};
+
+// std::ostream: ошибка остаётся в состоянии потока, как у print
+class StreamSink {
+public:
+    explicit StreamSink(std::ostream& os) noexcept : os_(&os) {}
+
+    bool write(const char* data, std::size_t size) {
+        os_->write(data, static_cast<std::streamsize>(size));
+        return static_cast<bool>(*os_);
+    }
+
+private:
+    std::ostream* os_;
+};
+
+// Буфер форматирования перед приёмником. Буфер выделяется один раз и
+// переиспользуется между сбросами; деструктор сбрасывает остаток. После
+// первой неудачной записи в приёмник ok() возвращает false, и дальнейший
+// вывод отбрасывается
+template<typename Sink>
+class BufferedWriter {
+public:
+    static constexpr std::size_t default_capacity = std::size_t(64) << 10;
+
+    // Самое длинное число с кратчайшим представлением (long double) — меньше
+    // 64 символов; буфер меньше минимального не бывает
+    static constexpr std::size_t min_capacity = 256;
+
+    explicit BufferedWriter(Sink sink, std::size_t capacity = default_capacity)
+        : sink_(std::move(sink)), capacity_(std::max(capacity, min_capacity)),
+          buffer_(new char[capacity_]) {}
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    ~BufferedWriter() { flush(); }
+
+    template<typename V>
+    void put(const V& value, int precision = -1) {
+        if constexpr (std::is_same_v<V, bool>) {
+            put_char(value ? '1' : '0');
+        } else if constexpr (std::is_same_v<V, char> || std::is_same_v<V, signed char> ||
+                             std::is_same_v<V, unsigned char>) {
+            put_char(static_cast<char>(value));
+        } else if constexpr (std::is_integral_v<V>) {
+            // Для целого буфера на 256 символов хватает всегда
+            reserve(min_capacity / 2);
+            used_ = static_cast<std::size_t>(std::to_chars(position(), limit(), value).ptr - buffer_.get());
+        } else if constexpr (std::is_floating_point_v<V>) {
+            put_floating(value, precision);
+        } else if constexpr (std::is_convertible_v<const V&, std::string_view>) {
+            put_text(std::string_view(value));
+        } else {
+            put_streamed(value);
+        }
+    }
+
+    void put_char(char c) {
+        reserve(1);
+        buffer_[used_++] = c;
+    }
+
+    void put_text(std::string_view text) {
+        if (LAB3_LIKELY(text.size() <= capacity_ - used_)) {
+            std::copy(text.begin(), text.end(), position());
+            used_ += text.size();
+            return;
+        }
+        // Длинная строка уходит в приёмник напрямую, минуя буфер
+        flush();
+        if (text.size() < capacity_) {
+            std::copy(text.begin(), text.end(), position());
+            used_ = text.size();
+        } else if (ok_) {
+            ok_ = sink_.write(text.data(), text.size());
+        }
+    }
+
+    // Отдаёт накопленное в приёмник; false, если какая-то запись не удалась
+    bool flush() {
+        if (used_ > 0 && ok_) ok_ = sink_.write(buffer_.get(), used_);
+        used_ = 0;
+        return ok_;
+    }
+
+    bool ok() const noexcept { return ok_; }
+
+private:
+    Sink sink_;
+    std::size_t capacity_;
+    std::unique_ptr<char[]> buffer_;
+    std::size_t used_ = 0;
+    bool ok_ = true;
+
+    char* position() noexcept { return buffer_.get() + used_; }
+    char* limit() noexcept { return buffer_.get() + capacity_; }
+
+    void reserve(std::size_t bytes) {
+        if (LAB3_UNLIKELY(capacity_ - used_ < bytes)) flush();
+    }
+
+    template<typename V>
+    void put_floating(V value, int precision) {
+        reserve(min_capacity / 2);
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            const auto result = precision < 0
+                                    ? std::to_chars(position(), limit(), value)
+                                    : std::to_chars(position(), limit(), value, std::chars_format::general, precision);
+            if (LAB3_LIKELY(result.ec == std::errc())) {
+                used_ = static_cast<std::size_t>(result.ptr - buffer_.get());
+                return;
+            }
+            flush();
+        }
+        put_long_floating(value, precision);
+    }
+
+    // Число длиннее всего буфера (огромная precision): растущая строка
+    template<typename V>
+    LAB3_COLD void put_long_floating(V value, int precision) {
+        std::string digits(capacity_ * 2, '\0');
+        for (;;) {
+            const auto result = std::to_chars(digits.data(), digits.data() + digits.size(), value,
+                                              std::chars_format::general, precision);
+            if (result.ec == std::errc()) {
+                put_text(std::string_view(digits.data(), static_cast<std::size_t>(result.ptr - digits.data())));
+                return;
+            }
+            digits.resize(digits.size() * 2);
+        }
+    }
+
+    template<typename V>
+    LAB3_COLD void put_streamed(const V& value) {
+        std::ostringstream os;
+        os << value;
+        put_text(os.str());
+    }
+};
+
+// Элементы [first, last) с разделителями из format
+template<typename Sink, typename It>
+void write_range(BufferedWriter<Sink>& out, It first, It last, const Format& format = {}) {
+    if (first != last) {
+        out.put(*first, format.precision);
+        for (++first; first != last; ++first) {
+            out.put_text(format.separator);
+            out.put(*first, format.precision);
+        }
+    }
+    out.put_text(format.terminator);
+}
+
+// Весь контейнер в приёмник; true, если всё записано
+
+template<typename Container>
+bool print_fd(const Container& c, int fd, const Format& format = {}) {
+    BufferedWriter<FdSink> out{FdSink(fd)};
+    write_range(out, std::begin(c), std::end(c), format);
+    return out.flush();
+}
+
+template<typename Container>
+bool print(const Container& c, std::FILE* file, const Format& format = {}) {
+    BufferedWriter<FileSink> out{FileSink(file)};
+    write_range(out, std::begin(c), std::end(c), format);
+    return out.flush();
+}
+
+template<typename Container>
+bool print(const Container& c, std::ostream& os, const Format& format = {}) {
+    BufferedWriter<StreamSink> out{StreamSink(os)};
+    write_range(out, std::begin(c), std::end(c), format);
+    return out.flush();
+}
+
+} // namespace text
+
+#endif // TEXT_FORMAT_H
@@ -0,0 +1,248 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Пул потоков с перехватом работы (work stealing).
+// У каждого рабочего потока своя очередь: свои задачи он берёт с конца (LIFO,
+// горячие в кэше), простаивающие потоки крадут с начала чужих очередей (FIFO,
+// самые крупные куски работы). Задачи из посторонних потоков попадают в общую
+// очередь.
+//
+// Степень параллелизма concurrency включает вызывающий поток: пул создаёт
+// concurrency - 1 рабочих потоков, а поток, ждущий TaskGroup, сам выполняет
+// задачи. При concurrency == 1 потоков нет и всё выполняется последовательно.
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    static std::size_t default_concurrency() noexcept {
+        return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    explicit ThreadPool(std::size_t concurrency = default_concurrency()) {
+        const std::size_t workers = std::max<std::size_t>(1, concurrency) - 1;
+        // Очереди рабочих потоков и последней — общая
+        for (std::size_t i = 0; i <= workers; ++i) {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+        workers_.reserve(workers);
+        try {
+            for (std::size_t i = 0; i < workers; ++i) {
+                workers_.emplace_back([this, i] { worker_loop(i); });
+            }
+        } catch (...) {
+            shutdown();
+            throw;
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Дожидается выполнения всех поставленных задач
+    ~ThreadPool() {
+        shutdown();
+    }
+
+    std::size_t concurrency() const noexcept { return workers_.size() + 1; }
+
+    // Пул по умолчанию на все ядра машины
+    static ThreadPool& global() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    // Задача, поставленная напрямую, не должна бросать исключений;
+    // задачи с исключениями запускаются через TaskGroup
+    void submit(Task task) {
+        Queue& queue = current_pool_ == this ? *queues_[current_index_] : shared_queue();
+        // Счётчик растёт раньше, чем задача становится видна: иначе её успели бы
+        // забрать и уменьшить счётчик ниже нуля
+        pending_.fetch_add(1, std::memory_order_release);
+        try {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        } catch (...) {
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            if (sleeping_ == 0) return;
+        }
+        wake_.notify_one();
+    }
+
+    // Выполняет одну задачу: свою, из общей очереди или украденную у другого
+    // потока. Возвращает false, если задач нет
+    bool run_pending_task() {
+        if (pending_.load(std::memory_order_acquire) == 0) return false;
+        Task task;
+        if (!take_task(task)) return false;
+        task();
+        return true;
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<std::size_t> pending_{0};
+
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::size_t sleeping_ = 0;
+    bool stop_ = false;
+
+    // Пул и номер очереди рабочего потока, в котором идёт выполнение
+    inline static thread_local ThreadPool* current_pool_ = nullptr;
+    inline static thread_local std::size_t current_index_ = 0;
+
+    Queue& shared_queue() noexcept { return *queues_.back(); }
+
+    bool pop_back(Queue& queue, Task& task) {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool pop_front(Queue& queue, Task& task) {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool take_task(Task& task) {
+        const bool worker = current_pool_ == this;
+        const std::size_t self = worker ? current_index_ : queues_.size() - 1;
+        if (worker && pop_back(*queues_[self], task)) return true;
+        if (pop_front(shared_queue(), task)) return true;
+        // Обход чужих очередей начинается с соседа, чтобы воры не толпились у первой
+        for (std::size_t i = 1; i < queues_.size(); ++i) {
+            std::size_t victim = (self + i) % queues_.size();
+            if (victim != queues_.size() - 1 && pop_front(*queues_[victim], task)) return true;
+        }
+        return false;
+    }
+
+    void worker_loop(std::size_t index) {
+        current_pool_ = this;
+        current_index_ = index;
+        for (;;) {
+            if (run_pending_task()) continue;
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            if (pending_.load(std::memory_order_acquire) != 0) continue;
+            if (stop_) return;
+            ++sleeping_;
+            wake_.wait(lock, [this] {
+                return stop_ || pending_.load(std::memory_order_acquire) != 0;
+            });
+            --sleeping_;
+        }
+    }
+
+    void shutdown() noexcept {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+        workers_.clear();
+        // Без рабочих потоков оставшиеся задачи выполняет тот, кто закрывает пул
+        while (run_pending_task()) {}
+    }
+};
+
+// Группа задач, которых можно дождаться. Ожидающий поток не простаивает,
+// а выполняет задачи пула, поэтому группы можно вкладывать друг в друга
+// (задача группы сама запускает группу и ждёт её) без взаимной блокировки.
+// Первое исключение из задач группы пробрасывается из wait(), остальные
+// ещё не начатые задачи группы пропускаются.
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool) noexcept : pool_(pool) {}
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    // Задачи ссылаются на стек создателя группы — дожидаемся их в любом случае
+    ~TaskGroup() {
+        drain();
+    }
+
+    template<typename F>
+    void run(F&& f) {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        try {
+            pool_.submit([this, f = std::forward<F>(f)]() mutable {
+                if (!failed_.load(std::memory_order_relaxed)) {
+                    try {
+                        f();
+                    } catch (...) {
+                        record_error();
+                    }
+                }
+                pending_.fetch_sub(1, std::memory_order_acq_rel);
+            });
+        } catch (...) {
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+    }
+
+    void wait() {
+        drain();
+        if (error_) {
+            std::exception_ptr error = std::move(error_);
+            error_ = nullptr;
+            failed_.store(false, std::memory_order_relaxed);
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    ThreadPool& pool_;
+    std::atomic<std::size_t> pending_{0};
+    std::atomic<bool> failed_{false};
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+
+    void drain() noexcept {
+        while (pending_.load(std::memory_order_acquire) != 0) {
+            if (!pool_.run_pending_task()) std::this_thread::yield();
+        }
+    }
+
+    void record_error() noexcept {
+        std::lock_guard<std::mutex> lock(error_mutex_);
+        if (!error_) error_ = std::current_exception();
+        failed_.store(true, std::memory_order_relaxed);
+    }
+};
+
+#endif // THREAD_POOL_H
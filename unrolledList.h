@@ -0,0 +1,641 @@
+#ifndef UNROLLED_LIST_H
+#define UNROLLED_LIST_H
+
+#include "staticContainer.h"
+#include "containerTraits.h"
+#include "nodePool.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <stdexcept>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <type_traits>
+
+// Развёрнутый двусвязный список: узел (блок) хранит до BlockSize элементов подряд.
+// Обход идёт по непрерывным участкам памяти, а поиск позиции перескакивает
+// сразу через блоки. Полный блок при вставке делится пополам, разреженные
+// соседние блоки при удалении сливаются.
+template<typename T, std::size_t BlockSize = 64, typename Allocator = std::allocator<T>>
+class UnrolledList : public StaticContainer<UnrolledList<T, BlockSize, Allocator>, T> {
+    using Interface = StaticContainer<UnrolledList<T, BlockSize, Allocator>, T>;
+
+    static_assert(BlockSize >= 4, "UnrolledList block must hold at least 4 elements");
+
+private:
+    // Занятые слоты блока — непрерывный отрезок [first, first + count)
+    struct Block {
+        Block* prev = nullptr;
+        Block* next = nullptr;
+        std::size_t first = 0;
+        std::size_t count = 0;
+        alignas(T) unsigned char storage[BlockSize * sizeof(T)];
+
+        T* slots() noexcept { return reinterpret_cast<T*>(storage); }
+        const T* slots() const noexcept { return reinterpret_cast<const T*>(storage); }
+        std::size_t end() const noexcept { return first + count; }
+    };
+
+    using BlockAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Block>;
+    using BlockTraits = std::allocator_traits<BlockAllocator>;
+
+    // Соседние блоки сливаются, если вместе занимают не больше 3/4 блока:
+    // после деления полного блока половинки сразу обратно не сливаются
+    static constexpr std::size_t MERGE_LIMIT = BlockSize * 3 / 4;
+
+public:
+    using value_type = typename Interface::value_type;
+    using size_type = typename Interface::size_type;
+    using reference = typename Interface::reference;
+    using const_reference = typename Interface::const_reference;
+    using allocator_type = Allocator;
+
+    static constexpr size_type block_size = BlockSize;
+
+    // Bidirectional Iterator: блок и номер слота в нём.
+    // end() указывает за последний слот хвостового блока
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        Iterator() noexcept : block_(nullptr), slot_(0) {}
+        Iterator(Block* block, size_type slot) noexcept : block_(block), slot_(slot) {}
+
+        reference operator*() const { return block_->slots()[slot_]; }
+        pointer operator->() const { return &block_->slots()[slot_]; }
+
+        Iterator& operator++() {
+            if (++slot_ == block_->end() && block_->next) {
+                block_ = block_->next;
+                slot_ = block_->first;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator temp = *this;
+            ++*this;
+            return temp;
+        }
+
+        Iterator& operator--() {
+            if (slot_ == block_->first) {
+                block_ = block_->prev;
+                slot_ = block_->end();
+            }
+            --slot_;
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator temp = *this;
+            --*this;
+            return temp;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return block_ == other.block_ && slot_ == other.slot_;
+        }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+    private:
+        Block* block_;
+        size_type slot_;
+
+        friend class UnrolledList;
+    };
+
+    class ConstIterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = const T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        ConstIterator() noexcept : block_(nullptr), slot_(0) {}
+        ConstIterator(const Block* block, size_type slot) noexcept : block_(block), slot_(slot) {}
+        ConstIterator(const Iterator& it) noexcept : block_(it.block_), slot_(it.slot_) {}
+
+        reference operator*() const { return block_->slots()[slot_]; }
+        pointer operator->() const { return &block_->slots()[slot_]; }
+
+        ConstIterator& operator++() {
+            if (++slot_ == block_->end() && block_->next) {
+                block_ = block_->next;
+                slot_ = block_->first;
+            }
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator temp = *this;
+            ++*this;
+            return temp;
+        }
+
+        ConstIterator& operator--() {
+            if (slot_ == block_->first) {
+                block_ = block_->prev;
+                slot_ = block_->end();
+            }
+            --slot_;
+            return *this;
+        }
+
+        ConstIterator operator--(int) {
+            ConstIterator temp = *this;
+            --*this;
+            return temp;
+        }
+
+        bool operator==(const ConstIterator& other) const {
+            return block_ == other.block_ && slot_ == other.slot_;
+        }
+        bool operator!=(const ConstIterator& other) const { return !(*this == other); }
+
+    private:
+        const Block* block_;
+        size_type slot_;
+    };
+
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    UnrolledList() = default;
+
+    explicit UnrolledList(const Allocator& alloc) : alloc_(alloc) {}
+
+    UnrolledList(std::initializer_list<T> init, const Allocator& alloc = Allocator())
+        : alloc_(alloc) {
+        for (const auto& item : init) {
+            push_back(item);
+        }
+    }
+
+    // Конструктор копирования: блоки копии заполнены плотно
+    UnrolledList(const UnrolledList& other)
+        : alloc_(BlockTraits::select_on_container_copy_construction(other.alloc_)) {
+        for (const auto& item : other) {
+            push_back(item);
+        }
+    }
+
+    // Конструктор перемещения
+    UnrolledList(UnrolledList&& other) noexcept
+        : alloc_(other.alloc_), head_(other.head_), tail_(other.tail_), size_(other.size_) {
+        other.head_ = nullptr;
+        other.tail_ = nullptr;
+        other.size_ = 0;
+    }
+
+    // Оператор присваивания копированием
+    UnrolledList& operator=(const UnrolledList& other) {
+        if (this != &other) {
+            UnrolledList temp(other);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    // Оператор присваивания перемещением
+    UnrolledList& operator=(UnrolledList&& other)
+        noexcept(BlockTraits::propagate_on_container_move_assignment::value ||
+                 BlockTraits::is_always_equal::value) {
+        if (this != &other) {
+            clear();
+            if (BlockTraits::propagate_on_container_move_assignment::value) {
+                alloc_ = other.alloc_;
+            } else if (alloc_ != other.alloc_) {
+                // Блоки чужого пула забрать нельзя — переносим элементы
+                for (auto& item : other) {
+                    push_back(std::move(item));
+                }
+                other.clear();
+                return *this;
+            }
+            head_ = other.head_;
+            tail_ = other.tail_;
+            size_ = other.size_;
+
+            other.head_ = nullptr;
+            other.tail_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    ~UnrolledList() {
+        clear();
+    }
+
+    // Интерфейс последовательного контейнера (is_sequence_container)
+    size_type size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    // Блоки целиком, включая свободные ячейки; считается обходом блоков
+    MemoryUsage memory_usage() const noexcept {
+        MemoryUsage usage;
+        usage.used = size_ * sizeof(T);
+        for (const Block* block = head_; block; block = block->next) {
+            usage.reserved += sizeof(Block);
+        }
+        return usage;
+    }
+
+    void clear() {
+        // Пул, которым владеет только этот список, освобождается slab'ами целиком:
+        // блоки не возвращаются в free list по одному, а при тривиально
+        // разрушаемых элементах цепочка не обходится вовсе
+        if constexpr (supports_bulk_release<BlockAllocator>::value) {
+            if (alloc_.sole_owner()) {
+                if constexpr (!std::is_trivially_destructible_v<T>) {
+                    for (Block* block = head_; block; block = block->next) {
+                        destroy_range(block->slots() + block->first, block->count);
+                    }
+                }
+                alloc_.try_release_all();
+                head_ = nullptr;
+                tail_ = nullptr;
+                size_ = 0;
+                return;
+            }
+        }
+
+        Block* current = head_;
+        while (current) {
+            Block* next = current->next;
+            destroy_range(current->slots() + current->first, current->count);
+            destroy_block(current);
+            current = next;
+        }
+        head_ = nullptr;
+        tail_ = nullptr;
+        size_ = 0;
+    }
+
+    void push_back(const T& value) {
+        append(value);
+    }
+
+    void push_back(T&& value) {
+        append(std::move(value));
+    }
+
+    void insert(size_type pos, const T& value) {
+        this->check_position(pos, size_);
+
+        if (pos == 0) {
+            push_front(value);
+        } else if (pos == size_) {
+            push_back(value);
+        } else {
+            // Сдвиг внутри блока может затронуть элемент, на который ссылается value
+            insert_middle(pos, T(value));
+        }
+    }
+
+    void insert(size_type pos, T&& value) {
+        this->check_position(pos, size_);
+
+        if (pos == 0) {
+            push_front(std::move(value));
+        } else if (pos == size_) {
+            push_back(std::move(value));
+        } else {
+            insert_middle(pos, T(std::move(value)));
+        }
+    }
+
+    void erase(size_type pos) {
+        this->check_index(pos, size_);
+
+        size_type local = pos;
+        Block* block = locate(local);
+        erase_in_block(block, local);
+    }
+
+    reference operator[](size_type idx) {
+        this->check_index(idx, size_);
+        Block* block = locate(idx);
+        return block->slots()[block->first + idx];
+    }
+
+    const_reference operator[](size_type idx) const {
+        this->check_index(idx, size_);
+        const Block* block = locate(idx);
+        return block->slots()[block->first + idx];
+    }
+
+    void print(std::ostream& os = std::cout) const {
+        bool first = true;
+        for (const Block* block = head_; block; block = block->next) {
+            const T* items = block->slots() + block->first;
+            for (size_type i = 0; i < block->count; ++i) {
+                if (!first) os << " ";
+                os << items[i];
+                first = false;
+            }
+        }
+    }
+
+    // Дополнительные методы
+    void push_front(const T& value) {
+        prepend(value);
+    }
+
+    void push_front(T&& value) {
+        prepend(std::move(value));
+    }
+
+    allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+    // Итераторы
+    iterator begin() noexcept { return head_ ? iterator(head_, head_->first) : iterator(); }
+    iterator end() noexcept { return tail_ ? iterator(tail_, tail_->end()) : iterator(); }
+
+    const_iterator begin() const noexcept {
+        return head_ ? const_iterator(head_, head_->first) : const_iterator();
+    }
+    const_iterator end() const noexcept {
+        return tail_ ? const_iterator(tail_, tail_->end()) : const_iterator();
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+    void swap(UnrolledList& other) noexcept {
+        using std::swap;
+        if (BlockTraits::propagate_on_container_swap::value) {
+            swap(alloc_, other.alloc_);
+        }
+        swap(head_, other.head_);
+        swap(tail_, other.tail_);
+        swap(size_, other.size_);
+    }
+
+private:
+    BlockAllocator alloc_;
+    Block* head_ = nullptr;
+    Block* tail_ = nullptr;
+    size_type size_ = 0;
+
+    Block* create_block(size_type first) {
+        Block* block = BlockTraits::allocate(alloc_, 1);
+        ::new (static_cast<void*>(block)) Block;
+        block->first = first;
+        this->stats_node_allocation();
+        return block;
+    }
+
+    // Элементы блока к этому моменту уже уничтожены или перенесены
+    void destroy_block(Block* block) noexcept {
+        block->~Block();
+        BlockTraits::deallocate(alloc_, block, 1);
+    }
+
+    // Вставляет block после after (nullptr — в начало списка)
+    void link_block_after(Block* after, Block* block) noexcept {
+        block->prev = after;
+        block->next = after ? after->next : head_;
+        if (block->next) {
+            block->next->prev = block;
+        } else {
+            tail_ = block;
+        }
+        if (after) {
+            after->next = block;
+        } else {
+            head_ = block;
+        }
+    }
+
+    void unlink_block(Block* block) noexcept {
+        if (block->prev) {
+            block->prev->next = block->next;
+        } else {
+            head_ = block->next;
+        }
+        if (block->next) {
+            block->next->prev = block->prev;
+        } else {
+            tail_ = block->prev;
+        }
+    }
+
+    static void destroy_range(T* first, size_type count) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_type i = 0; i < count; ++i) {
+                first[i].~T();
+            }
+        }
+    }
+
+    // Перенос count элементов; области могут перекрываться.
+    // Исходные ячейки после переноса считаются неинициализированными
+    static void relocate(T* dst, T* src, size_type count) {
+        if (count == 0 || dst == src) return;
+        if constexpr (is_trivially_relocatable_v<T>) {
+            std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(T));
+        } else if (dst < src) {
+            for (size_type i = 0; i < count; ++i) {
+                ::new (static_cast<void*>(dst + i)) T(std::move(src[i]));
+                src[i].~T();
+            }
+        } else {
+            for (size_type i = count; i-- > 0;) {
+                ::new (static_cast<void*>(dst + i)) T(std::move(src[i]));
+                src[i].~T();
+            }
+        }
+    }
+
+    // Блок, содержащий элемент idx; idx превращается в номер внутри блока.
+    // Идём с ближнего к позиции конца списка
+    Block* locate(size_type& idx) const {
+        size_type steps = 0;
+        if (idx < size_ / 2) {
+            Block* block = head_;
+            while (idx >= block->count) {
+                idx -= block->count;
+                block = block->next;
+                ++steps;
+            }
+            this->stats_walk(steps);
+            return block;
+        }
+        size_type from_back = size_ - 1 - idx;
+        Block* block = tail_;
+        while (from_back >= block->count) {
+            from_back -= block->count;
+            block = block->prev;
+            ++steps;
+        }
+        idx = block->count - 1 - from_back;
+        this->stats_walk(steps);
+        return block;
+    }
+
+    // В конец и в начало элементы не сдвигаются: при нехватке места у края
+    // заводится новый блок. Элемент создаётся до перецепления, поэтому value
+    // может ссылаться на элемент этого же списка
+    template<typename U>
+    void append(U&& value) {
+        if (tail_ && tail_->end() < BlockSize) {
+            ::new (static_cast<void*>(tail_->slots() + tail_->end())) T(std::forward<U>(value));
+            ++tail_->count;
+        } else {
+            Block* block = create_block(0);
+            try {
+                ::new (static_cast<void*>(block->slots())) T(std::forward<U>(value));
+            } catch (...) {
+                destroy_block(block);
+                throw;
+            }
+            block->count = 1;
+            link_block_after(tail_, block);
+        }
+        ++size_;
+    }
+
+    template<typename U>
+    void prepend(U&& value) {
+        if (head_ && head_->first > 0) {
+            ::new (static_cast<void*>(head_->slots() + head_->first - 1)) T(std::forward<U>(value));
+            --head_->first;
+            ++head_->count;
+        } else {
+            // Новый головной блок заполняется с конца, чтобы следующие
+            // push_front тоже обходились без сдвигов
+            Block* block = create_block(BlockSize - 1);
+            try {
+                ::new (static_cast<void*>(block->slots() + BlockSize - 1)) T(std::forward<U>(value));
+            } catch (...) {
+                destroy_block(block);
+                throw;
+            }
+            block->count = 1;
+            link_block_after(nullptr, block);
+        }
+        ++size_;
+    }
+
+    // Полный блок делится пополам; возвращает блок и номер внутри него,
+    // куда теперь приходится позиция local
+    Block* split(Block* block, size_type& local) {
+        Block* upper = create_block(0);
+        size_type half = block->count / 2;
+        this->stats_shift(block->count - half);
+        relocate(upper->slots(), block->slots() + block->first + half, block->count - half);
+        upper->count = block->count - half;
+        block->count = half;
+        link_block_after(block, upper);
+        if (local > half) {
+            local -= half;
+            return upper;
+        }
+        return block;
+    }
+
+    void insert_middle(size_type pos, T&& value) {
+        size_type local = pos;
+        Block* block = locate(local);
+        if (block->count == BlockSize) {
+            block = split(block, local);
+        }
+
+        // Сдвигаем ту сторону, где меньше элементов и есть свободный слот
+        T* items = block->slots();
+        size_type at = block->first + local;
+        size_type tail = block->count - local;
+        bool room_back = block->end() < BlockSize;
+        bool room_front = block->first > 0;
+        if (room_back && (!room_front || tail <= local)) {
+            this->stats_shift(tail);
+            relocate(items + at + 1, items + at, tail);
+            try {
+                ::new (static_cast<void*>(items + at)) T(std::move(value));
+            } catch (...) {
+                relocate(items + at, items + at + 1, tail);
+                throw;
+            }
+        } else {
+            this->stats_shift(local);
+            relocate(items + block->first - 1, items + block->first, local);
+            try {
+                ::new (static_cast<void*>(items + at - 1)) T(std::move(value));
+            } catch (...) {
+                relocate(items + block->first, items + block->first - 1, local);
+                throw;
+            }
+            --block->first;
+        }
+        ++block->count;
+        ++size_;
+    }
+
+    void erase_in_block(Block* block, size_type local) {
+        T* items = block->slots();
+        size_type at = block->first + local;
+        items[at].~T();
+
+        size_type tail = block->count - local - 1;
+        this->stats_shift(std::min(local, tail));
+        if (local < tail) {
+            relocate(items + block->first + 1, items + block->first, local);
+            ++block->first;
+        } else {
+            relocate(items + at, items + at + 1, tail);
+        }
+        --block->count;
+        --size_;
+
+        if (block->count == 0) {
+            unlink_block(block);
+            destroy_block(block);
+            return;
+        }
+        if (block->next && block->count + block->next->count <= MERGE_LIMIT) {
+            merge_next(block);
+        } else if (block->prev && block->prev->count + block->count <= MERGE_LIMIT) {
+            merge_next(block->prev);
+        }
+    }
+
+    // Переносит элементы следующего блока в конец block и освобождает его
+    void merge_next(Block* block) {
+        Block* next = block->next;
+        T* items = block->slots();
+        this->stats_shift(next->count);
+        if (block->end() + next->count > BlockSize) {
+            this->stats_shift(block->count);
+            relocate(items, items + block->first, block->count);
+            block->first = 0;
+        }
+        relocate(items + block->end(), next->slots() + next->first, next->count);
+        block->count += next->count;
+        unlink_block(next);
+        destroy_block(next);
+    }
+};
+
+#endif // UNROLLED_LIST_H